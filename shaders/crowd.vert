@@ -0,0 +1,84 @@
+#version 450
+
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 color;
+layout (location = 2) in vec3 normal;
+layout (location = 3) in vec2 uv;
+layout (location = 4) in vec4 jointIndices;
+layout (location = 5) in vec4 jointWeights;
+
+layout (location = 0) out vec3 fragColor;
+layout (location = 1) out vec3 fragPosWorld;
+layout (location = 2) out vec3 fragNormalWorld;
+layout (location = 3) out vec2 fragUv;
+
+layout (set = 0, binding = 0) uniform GlobalUbo {
+    mat4 projection;
+    mat4 view;
+    mat4 inverseView;
+    mat4 inverseProjection;
+    vec4 ambientLightColor;
+    vec4 directionalLight;
+    uvec4 clusterGrid;
+    vec4 clusterDepth;
+    vec4 screenSize;
+} ubo;
+
+struct Instance {
+    mat4 transform;
+    vec4 playback; // time offset, speed
+};
+
+// set 2 is the material of simple_shader.frag
+layout (std430, set = 3, binding = 0) readonly buffer Instances {
+    Instance instances[];
+};
+
+// one row per baked frame, three texels per joint holding the rows of its palette matrix
+layout (set = 3, binding = 1) uniform sampler2D animation;
+
+layout (push_constant) uniform Push {
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    int enableLighting;
+    float time;
+    float framesPerSecond;
+    uint frameCount;
+} push;
+
+mat4 jointMatrix(int joint, int frame) {
+    int x = joint * 3;
+    vec4 r0 = texelFetch(animation, ivec2(x, frame), 0);
+    vec4 r1 = texelFetch(animation, ivec2(x + 1, frame), 0);
+    vec4 r2 = texelFetch(animation, ivec2(x + 2, frame), 0);
+    return transpose(mat4(r0, r1, r2, vec4(0.0, 0.0, 0.0, 1.0)));
+}
+
+void main() {
+    Instance instance = instances[gl_InstanceIndex];
+
+    // the last baked frame lands on the end of the clip, so playback wraps at frameCount - 1
+    int lastFrame = int(push.frameCount) - 1;
+    float duration = float(lastFrame) / push.framesPerSecond;
+    float frame = mod(push.time * instance.playback.y + instance.playback.x, duration) * push.framesPerSecond;
+    int frame0 = min(int(frame), lastFrame);
+    int frame1 = min(frame0 + 1, lastFrame);
+    float blend = frame - float(frame0);
+
+    ivec4 joints = ivec4(jointIndices);
+    mat4 skin = mat4(0.0);
+    for (int i = 0; i < 4; i++) {
+        if (jointWeights[i] == 0.0) continue;
+        mat4 joint = mix(jointMatrix(joints[i], frame0), jointMatrix(joints[i], frame1), blend);
+        skin += jointWeights[i] * joint;
+    }
+
+    mat4 world = push.modelMatrix * instance.transform * skin;
+    vec4 positionWorld = world * vec4(position, 1.0);
+    gl_Position = ubo.projection * (ubo.view * positionWorld);
+
+    fragPosWorld = positionWorld.xyz;
+    fragNormalWorld = normalize(mat3(world) * normal);
+    fragColor = color;
+    fragUv = uv;
+}
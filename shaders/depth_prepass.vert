@@ -0,0 +1,28 @@
+#version 450
+
+layout (location = 0) in vec3 position;
+
+layout (set = 0, binding = 0) uniform GlobalUbo {
+    mat4 projection;
+    mat4 view;
+    mat4 inverseView;
+    mat4 inverseProjection;
+    vec4 ambientLightColor;
+    vec4 directionalLight;
+    uvec4 clusterGrid;
+    vec4 clusterDepth;
+    vec4 screenSize;
+} ubo;
+
+layout (push_constant) uniform Push {
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    int enableLighting;
+} push;
+
+invariant gl_Position;
+
+void main() {
+    vec4 positionWorld = push.modelMatrix * vec4(position, 1.0);
+    gl_Position = ubo.projection * (ubo.view * positionWorld);
+}
@@ -1,5 +1,14 @@
 #version 450
+
+layout(location = 0) in vec2 fragUv;
+layout(location = 1) in vec4 fragColor;
+
+layout(set = 0, binding = 0) uniform sampler2D glyphAtlas;
+
 layout(location = 0) out vec4 outColor;
+
 void main() {
-    outColor = vec4(1.0, 1.0, 1.0, 1.0); // White crosshair
-}
\ No newline at end of file
+    float coverage = texture(glyphAtlas, fragUv).r;
+    if (coverage <= 0.0) discard;
+    outColor = vec4(fragColor.rgb, fragColor.a * coverage);
+}
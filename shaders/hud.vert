@@ -1,11 +1,19 @@
 #version 450
 
-layout(location = 0) in vec3 inPosition;
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec2 inUv;
+layout(location = 2) in vec4 inColor;
+
+layout(location = 0) out vec2 fragUv;
+layout(location = 1) out vec4 fragColor;
 
 layout(push_constant) uniform Push {
-    mat4 transform;
+    vec2 pixelToNdc;
 } push;
 
 void main() {
-    gl_Position = push.transform * vec4(inPosition, 1.0);
-}
\ No newline at end of file
+    // pixel coordinates with the origin top left, which is also Vulkan's NDC orientation
+    gl_Position = vec4(inPosition * push.pixelToNdc - 1.0, 0.0, 1.0);
+    fragUv = inUv;
+    fragColor = inColor;
+}
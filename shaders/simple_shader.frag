@@ -1,14 +1,164 @@
 #version 450
 
+// the feedback writes are a side effect, without this fragments hidden by the depth pre-pass would be shaded
+// and request mips for textures nobody sees
+layout (early_fragment_tests) in;
+
 layout (location = 0) in vec3 fragColor;
+layout (location = 1) in vec3 fragPosWorld;
+layout (location = 2) in vec3 fragNormalWorld;
+layout (location = 3) in vec2 fragUv;
+
 layout (location = 0) out vec4 outColor;
 
+const uint MAX_LIGHTS_PER_CLUSTER = 128;
+const int CASCADE_COUNT = 4;
+
+struct Light {
+    vec4 positionRange;
+    vec4 colorIntensity;
+    vec4 directionType;
+    vec4 spotAngles;
+};
+
+layout (set = 0, binding = 0) uniform GlobalUbo {
+    mat4 projection;
+    mat4 view;
+    mat4 inverseView;
+    mat4 inverseProjection;
+    vec4 ambientLightColor;
+    vec4 directionalLight;
+    uvec4 clusterGrid;
+    vec4 clusterDepth;
+    vec4 screenSize;
+} ubo;
+
+layout (std430, set = 0, binding = 1) readonly buffer LightBuffer {
+    Light lights[];
+};
+
+layout (std430, set = 0, binding = 2) readonly buffer ClusterCountBuffer {
+    uint clusterLightCounts[];
+};
+
+layout (std430, set = 0, binding = 3) readonly buffer ClusterIndexBuffer {
+    uint clusterLightIndices[];
+};
+
+layout (set = 1, binding = 0) uniform ShadowUbo {
+    mat4 cascadeViewProjection[CASCADE_COUNT];
+    vec4 cascadeSplits;
+    vec4 cascadeTexelWorldSize;
+    vec4 params;
+} shadow;
+
+layout (set = 1, binding = 1) uniform sampler2DArrayShadow shadowMap;
+
+// the material's base color, white for untextured models
+layout (set = 2, binding = 0) uniform sampler2D baseColorTexture;
+
+// streaming feedback, the finest UV density the texture is sampled at this frame, see TextureStreamer
+layout (std430, set = 2, binding = 1) buffer TextureFeedback {
+    uint requiredDensity;
+} feedback;
+
 layout (push_constant) uniform Push {
-    mat4 transform;
+    mat4 modelMatrix;
     mat4 normalMatrix;
     int enableLighting;
 } push;
 
+uint clusterIndex(float viewDepth) {
+    uvec3 grid = ubo.clusterGrid.xyz;
+
+    uint slice = uint(max(log(viewDepth) * ubo.clusterDepth.z + ubo.clusterDepth.w, 0.0));
+    uvec2 tile = uvec2(gl_FragCoord.xy * ubo.screenSize.zw * vec2(grid.xy));
+
+    tile = min(tile, grid.xy - 1);
+    slice = min(slice, grid.z - 1);
+    return tile.x + tile.y * grid.x + slice * grid.x * grid.y;
+}
+
+float directionalShadow(vec3 normal, float viewDepth) {
+    if (viewDepth > shadow.cascadeSplits[CASCADE_COUNT - 1]) {
+        return 1.0;
+    }
+
+    int cascade = 0;
+    for (int i = 0; i < CASCADE_COUNT - 1; i++) {
+        if (viewDepth > shadow.cascadeSplits[i]) {
+            cascade = i + 1;
+        }
+    }
+
+    // offset along the normal by about a texel to keep large cascades from self shadowing
+    vec3 position = fragPosWorld + normal * shadow.cascadeTexelWorldSize[cascade] * 1.5;
+    vec4 lightClip = shadow.cascadeViewProjection[cascade] * vec4(position, 1.0);
+    vec3 coord = lightClip.xyz / lightClip.w;
+    vec2 uv = coord.xy * 0.5 + 0.5;
+
+    // 3x3 PCF on top of the hardware 2x2 comparison filter
+    float lit = 0.0;
+    for (int x = -1; x <= 1; x++) {
+        for (int y = -1; y <= 1; y++) {
+            vec2 offset = vec2(x, y) * shadow.params.x;
+            lit += texture(shadowMap, vec4(uv + offset, float(cascade), coord.z));
+        }
+    }
+    return lit / 9.0;
+}
+
 void main() {
-    outColor = vec4(fragColor, 1.0);
-}
\ No newline at end of file
+    // derivatives need uniform control flow, so before any early return
+    float footprint = max(length(dFdx(fragUv)), length(dFdy(fragUv)));
+    // one pixel of each 4x4 block is enough and keeps the atomics off the hot path
+    if (((uint(gl_FragCoord.x) | uint(gl_FragCoord.y)) & 3u) == 0u) {
+        // -log2 of the UV footprint in 8.8 fixed point, plus one so that 0 means unseen
+        float density = clamp(-log2(max(footprint, 1e-8)), 0.0, 31.0);
+        atomicMax(feedback.requiredDensity, 1u + uint(density * 256.0));
+    }
+
+    vec3 baseColor = fragColor * texture(baseColorTexture, fragUv).rgb;
+    if (push.enableLighting == 0) {
+        outColor = vec4(baseColor, 1.0);
+        return;
+    }
+
+    vec3 normal = normalize(fragNormalWorld);
+    vec3 lighting = ubo.ambientLightColor.xyz * ubo.ambientLightColor.w;
+    float viewDepth = (ubo.view * vec4(fragPosWorld, 1.0)).z;
+    float sun = max(dot(normal, ubo.directionalLight.xyz), 0.0);
+    if (sun > 0.0) {
+        sun *= directionalShadow(normal, viewDepth);
+    }
+    lighting += sun * ubo.directionalLight.w;
+
+    uint cluster = clusterIndex(viewDepth);
+    uint count = clusterLightCounts[cluster];
+    for (uint i = 0; i < count; i++) {
+        Light light = lights[clusterLightIndices[cluster * MAX_LIGHTS_PER_CLUSTER + i]];
+
+        vec3 toLight = light.positionRange.xyz - fragPosWorld;
+        float distanceSquared = dot(toLight, toLight);
+        float range = light.positionRange.w;
+        if (distanceSquared >= range * range) {
+            continue;
+        }
+
+        vec3 direction = toLight * inversesqrt(distanceSquared);
+
+        // inverse square falloff windowed to reach zero at the light's range
+        float window = clamp(1.0 - pow(distanceSquared / (range * range), 2.0), 0.0, 1.0);
+        float attenuation = window * window / (distanceSquared + 1.0);
+
+        if (light.directionType.w > 0.5) {
+            float cosAngle = dot(-direction, light.directionType.xyz);
+            attenuation *= smoothstep(light.spotAngles.y, light.spotAngles.x, cosAngle);
+        }
+
+        float diffuse = max(dot(normal, direction), 0.0);
+        lighting += light.colorIntensity.xyz * light.colorIntensity.w * attenuation * diffuse;
+    }
+
+    outColor = vec4(lighting * baseColor, 1.0);
+}
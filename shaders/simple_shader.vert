@@ -6,26 +6,37 @@ layout (location = 2) in vec3 normal;
 layout (location = 3) in vec2 uv;
 
 layout (location = 0) out vec3 fragColor;
+layout (location = 1) out vec3 fragPosWorld;
+layout (location = 2) out vec3 fragNormalWorld;
+layout (location = 3) out vec2 fragUv;
+
+layout (set = 0, binding = 0) uniform GlobalUbo {
+    mat4 projection;
+    mat4 view;
+    mat4 inverseView;
+    mat4 inverseProjection;
+    vec4 ambientLightColor;
+    vec4 directionalLight;
+    uvec4 clusterGrid;
+    vec4 clusterDepth;
+    vec4 screenSize;
+} ubo;
 
 layout (push_constant) uniform Push {
-    mat4 transform;
+    mat4 modelMatrix;
     mat4 normalMatrix;
     int enableLighting;
 } push;
 
-const vec3 DIRECTIONAL_LIGHT = normalize(vec3(1, -3, 1));
-const float AMBIENT_LIGHT = 0.05;
+// must match depth_prepass.vert bit for bit, the color pass tests depth with EQUAL
+invariant gl_Position;
 
 void main() {
-    // 4d vector position
-    gl_Position = push.transform * vec4(position, 1);
-
-    vec3 normalWorldSpace = normalize(mat3(push.normalMatrix) * normal);
-    float lightIntensity = AMBIENT_LIGHT + max(dot(normalWorldSpace, DIRECTIONAL_LIGHT), 0.0);
+    vec4 positionWorld = push.modelMatrix * vec4(position, 1.0);
+    gl_Position = ubo.projection * (ubo.view * positionWorld);
 
-    if (push.enableLighting == 1) {
-        fragColor = lightIntensity * color;
-    } else {
-        fragColor = color;
-    }
-}
\ No newline at end of file
+    fragPosWorld = positionWorld.xyz;
+    fragNormalWorld = normalize(mat3(push.normalMatrix) * normal);
+    fragColor = color;
+    fragUv = uv;
+}
@@ -0,0 +1,32 @@
+#version 450
+
+layout (location = 0) in vec2 fragUv;
+layout (location = 0) out vec4 outColor;
+
+layout (set = 0, binding = 0) uniform sampler2D sceneColor;
+
+layout (push_constant) uniform Push {
+    vec2 uvScale;
+    vec2 uvClamp;
+    vec2 texelSize;
+    float sharpness;
+} push;
+
+vec3 sampleScene(vec2 uv) {
+    // never filter in texels outside the rendered sub-rectangle
+    return texture(sceneColor, clamp(uv, push.texelSize * 0.5, push.uvClamp)).rgb;
+}
+
+void main() {
+    vec3 color = sampleScene(fragUv);
+
+    if (push.sharpness > 0.0) {
+        vec3 neighbours = sampleScene(fragUv + vec2(push.texelSize.x, 0.0))
+                        + sampleScene(fragUv - vec2(push.texelSize.x, 0.0))
+                        + sampleScene(fragUv + vec2(0.0, push.texelSize.y))
+                        + sampleScene(fragUv - vec2(0.0, push.texelSize.y));
+        color = clamp(color + (color - neighbours * 0.25) * push.sharpness, 0.0, 1.0);
+    }
+
+    outColor = vec4(color, 1.0);
+}
@@ -0,0 +1,17 @@
+#version 450
+
+layout (location = 0) out vec2 fragUv;
+
+layout (push_constant) uniform Push {
+    vec2 uvScale;
+    vec2 uvClamp;
+    vec2 texelSize;
+    float sharpness;
+} push;
+
+void main() {
+    // full screen triangle, no vertex buffer needed
+    vec2 corner = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);
+    fragUv = corner * push.uvScale;
+    gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
+}
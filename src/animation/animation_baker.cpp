@@ -0,0 +1,46 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "animation_baker.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "animation_player.h"
+
+namespace vulkr {
+    BakedAnimation bakeAnimation(const Skeleton &skeleton, const AnimationPose &restPose,
+                                 std::shared_ptr<const AnimationClip> clip, float framesPerSecond) {
+        BakedAnimation baked{};
+        baked.jointCount = skeleton.getJointCount();
+        baked.duration = clip->getDuration();
+
+        // at least two frames so playback always has a pair to blend, the first and last one sit on the ends
+        baked.frameCount = std::max(2u, static_cast<uint32_t>(std::ceil(baked.duration * framesPerSecond)) + 1);
+        baked.framesPerSecond = baked.duration > 0.0f
+                                    ? static_cast<float>(baked.frameCount - 1) / baked.duration
+                                    : framesPerSecond;
+        baked.texels.resize(static_cast<size_t>(baked.frameCount) * baked.getWidth());
+
+        AnimationPlayer player{std::move(clip), restPose};
+        player.setLooping(false);
+        std::vector<glm::mat4> nodeGlobals;
+        std::vector<glm::mat4> palette(baked.jointCount);
+
+        for (uint32_t frame = 0; frame < baked.frameCount; frame++) {
+            player.seek(static_cast<float>(frame) / baked.framesPerSecond);
+            player.sample();
+            skeleton.computePalette(player.getPose(), nodeGlobals, palette.data());
+
+            glm::vec4 *row = baked.texels.data() + static_cast<size_t>(frame) * baked.getWidth();
+            for (uint32_t joint = 0; joint < baked.jointCount; joint++) {
+                const glm::mat4 transposed = glm::transpose(palette[joint]);
+                row[joint * 3] = transposed[0];
+                row[joint * 3 + 1] = transposed[1];
+                row[joint * 3 + 2] = transposed[2];
+            }
+        }
+        return baked;
+    }
+}
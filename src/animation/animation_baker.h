@@ -0,0 +1,39 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef ANIMATION_BAKER_H
+#define ANIMATION_BAKER_H
+
+#include <memory>
+#include <vector>
+
+#include "animation_clip.h"
+#include "skeleton.h"
+
+namespace vulkr {
+    /**
+     * The joint palettes of a clip sampled at a fixed rate, laid out as a texture: one row per frame, three
+     * texels per joint holding the rows of its affine skinning matrix.
+     */
+    struct BakedAnimation {
+        uint32_t frameCount{0};
+        uint32_t jointCount{0};
+        /**
+         * Rate the frames were sampled at, adjusted so the last frame lands exactly on the clip's end.
+         */
+        float framesPerSecond{0.0f};
+        float duration{0.0f};
+        std::vector<glm::vec4> texels;
+
+        uint32_t getWidth() const { return jointCount * 3; }
+    };
+
+    /**
+     * Samples clip at about framesPerSecond on skeleton, the nodes the clip does not animate keep restPose.
+     */
+    BakedAnimation bakeAnimation(const Skeleton &skeleton, const AnimationPose &restPose,
+                                 std::shared_ptr<const AnimationClip> clip, float framesPerSecond);
+}
+
+#endif //ANIMATION_BAKER_H
@@ -0,0 +1,185 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "animation_clip.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace vulkr {
+    void AnimationPose::resize(size_t nodeCount) {
+        translations.resize(nodeCount, glm::vec3{0.0f});
+        rotations.resize(nodeCount, glm::quat{1.0f, 0.0f, 0.0f, 0.0f});
+        scales.resize(nodeCount, glm::vec3{1.0f});
+    }
+
+    glm::mat4 AnimationPose::localMatrix(size_t node) const {
+        glm::mat4 matrix = glm::mat4_cast(rotations[node]);
+        matrix[0] *= scales[node].x;
+        matrix[1] *= scales[node].y;
+        matrix[2] *= scales[node].z;
+        matrix[3] = glm::vec4(translations[node], 1.0f);
+        return matrix;
+    }
+
+    namespace {
+        // longest run of keys a single interpolated segment may replace, bounds the quadratic reduction
+        constexpr uint32_t MAX_REDUCED_RUN = 256;
+
+        bool withinTolerance(AnimationPath path, const glm::vec4 &a, const glm::vec4 &b, float tolerance) {
+            if (path == AnimationPath::Rotation) {
+                const float cosHalfAngle = std::abs(glm::dot(a, b));
+                return 2.0f * std::acos(std::min(cosHalfAngle, 1.0f)) <= tolerance;
+            }
+            return glm::length(glm::vec3(a) - glm::vec3(b)) <= tolerance;
+        }
+
+        glm::vec4 interpolate(AnimationPath path, const glm::vec4 &a, const glm::vec4 &b, float t) {
+            if (path == AnimationPath::Rotation) {
+                const glm::quat q = glm::slerp(glm::quat{a.w, a.x, a.y, a.z}, glm::quat{b.w, b.x, b.y, b.z}, t);
+                return {q.x, q.y, q.z, q.w};
+            }
+            return a + (b - a) * t;
+        }
+
+        /*
+         * Greedily extends a segment from the last kept key for as long as interpolating its ends reproduces
+         * every key inside it, then keeps the key before the one that broke it. Step tracks hold the
+         * segment's first value, so only repeats are dropped.
+         */
+        std::vector<uint32_t> reduceKeys(AnimationPath path, bool step, const std::vector<float> &times,
+                                         const std::vector<glm::vec4> &values, float tolerance) {
+            const auto keyCount = static_cast<uint32_t>(times.size());
+            std::vector<uint32_t> kept{0};
+            if (keyCount == 1) return kept;
+
+            uint32_t anchor = 0;
+            for (uint32_t end = 2; end < keyCount; end++) {
+                bool reproduced = end - anchor <= MAX_REDUCED_RUN;
+                for (uint32_t key = anchor + 1; key < end && reproduced; key++) {
+                    const float t = step ? 0.0f : (times[key] - times[anchor]) / (times[end] - times[anchor]);
+                    reproduced = withinTolerance(path, interpolate(path, values[anchor], values[end], t),
+                                                 values[key], tolerance);
+                }
+                if (!reproduced) {
+                    anchor = end - 1;
+                    kept.push_back(anchor);
+                }
+            }
+
+            // a constant track collapses to a single key
+            if (kept.size() > 1 || !withinTolerance(path, values[0], values[keyCount - 1], tolerance)) {
+                kept.push_back(keyCount - 1);
+            }
+            return kept;
+        }
+
+        uint16_t quantize(float value, float rangeMin, float inverseStep) {
+            return static_cast<uint16_t>(std::clamp(std::round((value - rangeMin) * inverseStep), 0.0f, 65535.0f));
+        }
+
+        void encodeRotation(glm::vec4 q, uint16_t *key) {
+            q = glm::normalize(q);
+
+            uint32_t largest = 0;
+            for (uint32_t i = 1; i < 4; i++) {
+                if (std::abs(q[i]) > std::abs(q[largest])) largest = i;
+            }
+            // q and -q are the same rotation, store the one whose dropped component is positive
+            if (q[largest] < 0.0f) q = -q;
+
+            constexpr float offset = 0.70710678f;
+            constexpr float inverseScale = 32767.0f / 1.41421356f;
+            uint32_t component = 0;
+            for (uint32_t i = 0; i < 4; i++) {
+                if (i == largest) continue;
+                key[component++] = static_cast<uint16_t>(
+                    std::clamp(std::round((q[i] + offset) * inverseScale), 0.0f, 32767.0f));
+            }
+            key[0] |= static_cast<uint16_t>((largest >> 1) << 15);
+            key[1] |= static_cast<uint16_t>((largest & 1) << 15);
+        }
+    } // anonymous namespace
+
+    void AnimationClip::addTrack(AnimationPath path, AnimationInterpolation interpolation, uint32_t node,
+                                 const std::vector<float> &trackTimes, const std::vector<glm::vec4> &values) {
+        if (path == AnimationPath::Weights || trackTimes.empty()) {
+            return;
+        }
+
+        const bool cubic = interpolation == AnimationInterpolation::CubicSpline;
+        if (values.size() != trackTimes.size() * (cubic ? 3 : 1)) {
+            throw std::runtime_error("animation track has mismatched key and value counts!");
+        }
+
+        // a cubic spline key is stored as in tangent, value, out tangent
+        std::vector<glm::vec4> keys(trackTimes.size());
+        for (size_t key = 0; key < trackTimes.size(); key++) {
+            keys[key] = values[cubic ? key * 3 + 1 : key];
+        }
+        sourceKeyMemorySize += values.size() * sizeof(glm::vec4) + trackTimes.size() * sizeof(float);
+
+        const float tolerance = path == AnimationPath::Translation
+                                    ? compression.translationTolerance
+                                    : path == AnimationPath::Rotation
+                                          ? compression.rotationTolerance
+                                          : compression.scaleTolerance;
+        const std::vector<uint32_t> kept = reduceKeys(path, interpolation == AnimationInterpolation::Step, trackTimes,
+                                                      keys, tolerance);
+
+        Track track{};
+        track.path = path;
+        track.interpolation = cubic ? AnimationInterpolation::Linear : interpolation;
+        track.node = node;
+        track.firstKey = static_cast<uint32_t>(keyTimes.size());
+        track.keyCount = static_cast<uint32_t>(kept.size());
+
+        const float startTime = trackTimes[kept.front()];
+        const float span = trackTimes[kept.back()] - startTime;
+        track.startTime = startTime;
+        track.inverseTimeStep = span > 0.0f ? 65535.0f / span : 0.0f;
+        for (uint32_t key: kept) {
+            keyTimes.push_back(quantize(trackTimes[key], startTime, track.inverseTimeStep));
+        }
+
+        const size_t firstValue = keyValues.size();
+        keyValues.resize(firstValue + kept.size() * COMPONENTS_PER_KEY);
+        uint16_t *encoded = keyValues.data() + firstValue;
+        if (path == AnimationPath::Rotation) {
+            for (uint32_t key: kept) {
+                encodeRotation(keys[key], encoded);
+                encoded += COMPONENTS_PER_KEY;
+            }
+        } else {
+            glm::vec3 rangeMin{keys[kept.front()]};
+            glm::vec3 rangeMax{rangeMin};
+            for (uint32_t key: kept) {
+                rangeMin = glm::min(rangeMin, glm::vec3(keys[key]));
+                rangeMax = glm::max(rangeMax, glm::vec3(keys[key]));
+            }
+            track.rangeMin = rangeMin;
+            track.rangeStep = (rangeMax - rangeMin) / 65535.0f;
+
+            for (uint32_t key: kept) {
+                for (uint32_t c = 0; c < COMPONENTS_PER_KEY; c++) {
+                    const float step = track.rangeStep[c];
+                    encoded[c] = quantize(keys[key][c], rangeMin[c], step > 0.0f ? 1.0f / step : 0.0f);
+                }
+                encoded += COMPONENTS_PER_KEY;
+            }
+        }
+
+        // keep the vec3 tracks in front so the sampler can lerp them in one run, each run sorted by node
+        const auto byNode = [](uint32_t n, const Track &other) { return n < other.node; };
+        if (path == AnimationPath::Rotation) {
+            tracks.insert(std::upper_bound(tracks.begin() + rotationBegin, tracks.end(), node, byNode), track);
+        } else {
+            tracks.insert(std::upper_bound(tracks.begin(), tracks.begin() + rotationBegin, node, byNode), track);
+            rotationBegin++;
+        }
+
+        duration = std::max(duration, trackTimes.back());
+        nodeCount = std::max(nodeCount, node + 1);
+    }
+}
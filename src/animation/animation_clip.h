@@ -0,0 +1,154 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef ANIMATION_CLIP_H
+#define ANIMATION_CLIP_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define GLM_FORCE_RADIANS // force GLM to use radians for angles
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE // force GLM to use depth range [0, 1]
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace vulkr {
+    enum class AnimationPath : uint8_t {
+        Translation,
+        Rotation,
+        Scale,
+        Weights
+    };
+
+    enum class AnimationInterpolation : uint8_t {
+        Linear,
+        Step,
+        CubicSpline
+    };
+
+    /**
+     * Local transforms of every node, one array per component so the sampler writes linearly.
+     */
+    struct AnimationPose {
+        std::vector<glm::vec3> translations;
+        std::vector<glm::quat> rotations;
+        std::vector<glm::vec3> scales;
+
+        void resize(size_t nodeCount);
+
+        size_t size() const { return translations.size(); }
+
+        glm::mat4 localMatrix(size_t node) const;
+    };
+
+    /**
+     * Error the compression of a clip may introduce per track, in model units for translations and scales
+     * and in radians for rotations. Keys the interpolation of their neighbours reproduces within it are dropped.
+     */
+    struct AnimationCompression {
+        float translationTolerance{1e-4f};
+        float rotationTolerance{1e-4f};
+        float scaleTolerance{1e-4f};
+    };
+
+    /**
+     * Immutable, compressed form of a glTF animation, shared between all players of the clip. Tracks are
+     * ordered so all vec3 tracks precede the rotations, both runs sorted by node so the tracks of a truncated
+     * skeleton are a prefix of each. Every key takes 8 bytes in two shared arrays:
+     * its time quantized to 16 bits over the track's span, and its value as three 16 bit integers. vec3
+     * values are quantized over the track's range, rotations are stored as their three smallest components
+     * plus the index of the dropped one (smallest three, 48 bits).
+     */
+    class AnimationClip {
+    public:
+        struct Track {
+            AnimationPath path;
+            AnimationInterpolation interpolation;
+            uint32_t node;
+            uint32_t firstKey;
+            uint32_t keyCount;
+            // key time = startTime + quantized time / inverseTimeStep
+            float startTime;
+            float inverseTimeStep;
+            // vec3 tracks only, value = rangeMin + quantized value * rangeStep
+            glm::vec3 rangeMin;
+            glm::vec3 rangeStep;
+        };
+
+        static constexpr uint32_t COMPONENTS_PER_KEY = 3;
+
+        explicit AnimationClip(std::string name, const AnimationCompression &compression = {})
+            : name{std::move(name)}, compression{compression} {
+        }
+
+        /**
+         * values holds one element per key, or three (in tangent, value, out tangent) for cubic splines.
+         * Cubic splines are sampled linearly between their values. Weight tracks are ignored since models
+         * have no morph targets. The keys are reduced and quantized here.
+         */
+        void addTrack(AnimationPath path, AnimationInterpolation interpolation, uint32_t node,
+                      const std::vector<float> &times, const std::vector<glm::vec4> &values);
+
+        const std::string &getName() const { return name; }
+        float getDuration() const { return duration; }
+        uint32_t getNodeCount() const { return nodeCount; }
+
+        const std::vector<Track> &getTracks() const { return tracks; }
+        /**
+         * Index of the first rotation track, every track before it is a translation or scale.
+         */
+        uint32_t getRotationBegin() const { return rotationBegin; }
+
+        const uint16_t *getKeyTimes() const { return keyTimes.data(); }
+        /**
+         * COMPONENTS_PER_KEY values per key, decoded with decodeVector() or decodeRotation().
+         */
+        const uint16_t *getKeyValues() const { return keyValues.data(); }
+
+        /**
+         * Memory taken by the keys, and what they took before compression.
+         */
+        size_t getKeyMemorySize() const { return (keyTimes.size() + keyValues.size()) * sizeof(uint16_t); }
+        size_t getSourceKeyMemorySize() const { return sourceKeyMemorySize; }
+
+        static glm::vec3 decodeVector(const Track &track, const uint16_t *key) {
+            return track.rangeMin + glm::vec3(key[0], key[1], key[2]) * track.rangeStep;
+        }
+
+        static glm::quat decodeRotation(const uint16_t *key) {
+            constexpr float scale = 1.41421356f / 32767.0f;
+            constexpr float offset = 0.70710678f;
+            const float a = static_cast<float>(key[0] & 0x7fff) * scale - offset;
+            const float b = static_cast<float>(key[1] & 0x7fff) * scale - offset;
+            const float c = static_cast<float>(key[2] & 0x7fff) * scale - offset;
+            const float largest = std::sqrt(std::max(0.0f, 1.0f - a * a - b * b - c * c));
+
+            // the index (x, y, z, w) of the dropped component is kept in the top bits of the first two values
+            switch ((key[0] >> 15) << 1 | key[1] >> 15) {
+                case 0: return glm::quat{c, largest, a, b};
+                case 1: return glm::quat{c, a, largest, b};
+                case 2: return glm::quat{c, a, b, largest};
+                default: return glm::quat{largest, a, b, c};
+            }
+        }
+
+    private:
+        std::string name;
+        AnimationCompression compression;
+        std::vector<Track> tracks;
+        uint32_t rotationBegin{0};
+        uint32_t nodeCount{0};
+        float duration{0.0f};
+        size_t sourceKeyMemorySize{0};
+
+        std::vector<uint16_t> keyTimes;
+        std::vector<uint16_t> keyValues;
+    };
+}
+
+#endif //ANIMATION_CLIP_H
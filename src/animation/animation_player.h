@@ -0,0 +1,73 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef ANIMATION_PLAYER_H
+#define ANIMATION_PLAYER_H
+
+#include <memory>
+#include <vector>
+
+#include "animation_clip.h"
+
+namespace vulkr {
+    /**
+     * Plays one clip on one instance. Every track remembers the key it sampled last, so sequential playback
+     * only ever steps forward a key or two; a binary search is only needed after a loop wrap or a seek backwards.
+     * The sampled keys are gathered into SoA lanes and blended four tracks at a time, lerp for translations
+     * and scales, slerp for rotations.
+     */
+    class AnimationPlayer {
+    public:
+        /**
+         * restPose provides the nodes the clip does not animate and is copied into the player's pose.
+         */
+        AnimationPlayer(std::shared_ptr<const AnimationClip> clip, const AnimationPose &restPose);
+
+        AnimationPlayer(const AnimationPlayer &) = delete;
+
+        AnimationPlayer &operator=(const AnimationPlayer &) = delete;
+
+        void advance(float deltaTime);
+
+        void seek(float time);
+
+        /**
+         * Evaluates the tracks of the nodes below nodeLimit (see Skeleton::getNodeLimit) at the current time
+         * into getPose(). Nodes past the limit keep the pose they were last sampled with.
+         */
+        void sample(uint32_t nodeLimit = ~0u);
+
+        const AnimationPose &getPose() const { return pose; }
+        const AnimationClip &getClip() const { return *clip; }
+
+        float getTime() const { return time; }
+
+        void setLooping(bool loop) { looping = loop; }
+        void setSpeed(float playbackSpeed) { speed = playbackSpeed; }
+
+    private:
+        /**
+         * The lanes of track i, vec3 tracks first, rotations from the next multiple of four.
+         */
+        uint32_t laneOf(uint32_t track) const;
+
+        std::shared_ptr<const AnimationClip> clip;
+        AnimationPose pose;
+
+        float time{0.0f};
+        float speed{1.0f};
+        bool looping{true};
+
+        std::vector<uint32_t> cursors;
+
+        // SoA scratch, a is overwritten with the result
+        uint32_t rotationLane{0};
+        uint32_t laneCount{0};
+        std::vector<float> ax, ay, az, aw;
+        std::vector<float> bx, by, bz, bw;
+        std::vector<float> weights;
+    };
+}
+
+#endif //ANIMATION_PLAYER_H
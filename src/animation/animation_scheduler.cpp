@@ -0,0 +1,109 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "animation_scheduler.h"
+
+#include <algorithm>
+
+namespace vulkr {
+    uint32_t AnimationScheduler::selectLevel(const Camera &camera, const GameObject &obj) const {
+        const auto lastLevel = static_cast<uint32_t>(levels.size() - 1);
+        if (obj.model == nullptr) return lastLevel;
+
+        const glm::vec3 localCenter = (obj.model->getBoundsMin() + obj.model->getBoundsMax()) * 0.5f;
+        const float localRadius = glm::length(obj.model->getBoundsMax() - obj.model->getBoundsMin()) * 0.5f;
+        const glm::vec3 scale = glm::abs(obj.transform.scale);
+        const glm::vec3 center = glm::vec3(obj.transform.mat4() * glm::vec4(localCenter, 1.0f));
+        const float screenSize = camera.getScreenSize(center, localRadius * std::max({scale.x, scale.y, scale.z}));
+
+        if (screenSize <= 0.0f) return lastLevel;
+        for (uint32_t i = 0; i < lastLevel; i++) {
+            if (screenSize >= levels[i].minScreenSize) return i;
+        }
+        return lastLevel;
+    }
+
+    void AnimationScheduler::blendPalette(Instance &instance) {
+        const float t = static_cast<float>(instance.step) / static_cast<float>(instance.interval);
+        for (size_t i = 0; i < instance.palette.size(); i++) {
+            instance.palette[i] = instance.from[i] + (instance.to[i] - instance.from[i]) * t;
+        }
+    }
+
+    void AnimationScheduler::update(float deltaTime, const Camera &camera, std::vector<GameObject> &gameObjects) {
+        updateCount++;
+        animatedCount = 0;
+        sampledCount = 0;
+
+        for (auto &obj: gameObjects) {
+            // only skinning reads the sampled poses, other animated objects would be sampled for nothing
+            if (obj.animation == nullptr || obj.model == nullptr || !obj.model->isSkinned()) continue;
+            animatedCount++;
+
+            Instance &instance = instances[obj.getId()];
+            if (instance.model != obj.model.get()) {
+                instance = Instance{};
+                instance.model = obj.model.get();
+            }
+            instance.lastUpdate = updateCount;
+            instance.pendingTime += deltaTime;
+
+            if (instance.framesUntilUpdate > 0) {
+                instance.framesUntilUpdate--;
+                instance.step++;
+                blendPalette(instance);
+                continue;
+            }
+
+            const Level &level = levels[selectLevel(camera, obj)];
+            const uint32_t interval = std::max(level.updateInterval, 1u);
+
+            // sample where the pose should be by the next update, the frames until then blend towards it
+            const float lead = deltaTime * static_cast<float>(interval - 1);
+            obj.animation->advance(instance.pendingTime - instance.lead + lead);
+            instance.pendingTime = 0.0f;
+            instance.lead = lead;
+
+            const Skeleton &skeleton = instance.model->getSkeleton();
+            obj.animation->sample(skeleton.getNodeLimit(level.maxDepth));
+            sampledCount++;
+
+            const bool first = instance.palette.empty();
+            instance.from.resize(skeleton.getJointCount());
+            instance.to.resize(skeleton.getJointCount());
+            instance.palette.resize(skeleton.getJointCount());
+            skeleton.computePalette(obj.animation->getPose(), nodeGlobals, instance.to.data());
+
+            if (first || interval == 1) {
+                instance.palette = instance.to;
+                instance.interval = 1;
+                instance.step = 1;
+                continue;
+            }
+
+            // blend from what is on screen now, so a change of rate never pops
+            instance.from.swap(instance.palette);
+            instance.interval = interval;
+            instance.step = 1;
+            instance.framesUntilUpdate = interval - 1;
+            instance.palette.resize(skeleton.getJointCount());
+            blendPalette(instance);
+        }
+
+        // objects that are gone, lost their animation or their skin
+        for (auto it = instances.begin(); it != instances.end();) {
+            if (it->second.lastUpdate == updateCount) {
+                ++it;
+            } else {
+                it = instances.erase(it);
+            }
+        }
+    }
+
+    const glm::mat4 *AnimationScheduler::getPalette(GameObject::id_t id) const {
+        const auto it = instances.find(id);
+        if (it == instances.end() || it->second.palette.empty()) return nullptr;
+        return it->second.palette.data();
+    }
+}
@@ -0,0 +1,89 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef ANIMATION_SCHEDULER_H
+#define ANIMATION_SCHEDULER_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "../game/camera.h"
+#include "../game/game_object.h"
+
+namespace vulkr {
+    /**
+     * Advances and samples every animated, skinned object at a rate picked from its size on screen. Small or
+     * off-screen instances are only sampled every Nth frame, a little ahead of time, and their joint palettes are
+     * blended towards the new pose over the frames in between; they also sample a skeleton truncated to its top
+     * levels. The palettes are kept here for the skinning system to upload. Animated objects without a skin are
+     * left alone, nothing would read their poses.
+     */
+    class AnimationScheduler {
+    public:
+        struct Level {
+            /**
+             * Smallest Camera::getScreenSize() the level is used for.
+             */
+            float minScreenSize;
+            uint32_t updateInterval;
+            /**
+             * Deepest skeleton level that is animated, see Skeleton::getNodeLimit().
+             */
+            uint32_t maxDepth;
+        };
+
+        AnimationScheduler() = default;
+
+        AnimationScheduler(const AnimationScheduler &) = delete;
+
+        AnimationScheduler &operator=(const AnimationScheduler &) = delete;
+
+        void update(float deltaTime, const Camera &camera, std::vector<GameObject> &gameObjects);
+
+        /**
+         * Joint palette of a skinned, animated object for this frame, nullptr for any other object.
+         */
+        const glm::mat4 *getPalette(GameObject::id_t id) const;
+
+        uint32_t getAnimatedCount() const { return animatedCount; }
+        uint32_t getSampledCount() const { return sampledCount; }
+
+        /**
+         * Ordered from the largest screen size down, the last level is also used off screen.
+         */
+        std::vector<Level> levels{
+            {0.25f, 1, ~0u},
+            {0.08f, 2, ~0u},
+            {0.02f, 4, 6},
+            {0.0f, 8, 3}
+        };
+
+    private:
+        struct Instance {
+            const VulkrModel *model{nullptr};
+            uint32_t framesUntilUpdate{0};
+            uint32_t interval{1};
+            uint32_t step{1};
+            // time passed since the last sample, and how far that sample ran ahead
+            float pendingTime{0.0f};
+            float lead{0.0f};
+            std::vector<glm::mat4> from;
+            std::vector<glm::mat4> to;
+            std::vector<glm::mat4> palette;
+            uint64_t lastUpdate{0};
+        };
+
+        uint32_t selectLevel(const Camera &camera, const GameObject &obj) const;
+
+        static void blendPalette(Instance &instance);
+
+        std::unordered_map<GameObject::id_t, Instance> instances;
+        std::vector<glm::mat4> nodeGlobals;
+        uint64_t updateCount{0};
+        uint32_t animatedCount{0};
+        uint32_t sampledCount{0};
+    };
+}
+
+#endif //ANIMATION_SCHEDULER_H
@@ -0,0 +1,90 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "skeleton.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace vulkr {
+    std::vector<uint32_t> Skeleton::sortNodes(const std::vector<int32_t> &nodeParents) {
+        const size_t nodeCount = nodeParents.size();
+
+        // children of every node as ranges of one array, in node order
+        std::vector<uint32_t> childBegin(nodeCount + 1, 0);
+        for (int32_t parent: nodeParents) {
+            if (parent >= 0) childBegin[parent + 1]++;
+        }
+        for (size_t i = 0; i < nodeCount; i++) {
+            childBegin[i + 1] += childBegin[i];
+        }
+        std::vector<uint32_t> children(childBegin[nodeCount]);
+        std::vector<uint32_t> childEnd(childBegin.begin(), childBegin.end() - 1);
+        for (size_t i = 0; i < nodeCount; i++) {
+            if (nodeParents[i] >= 0) children[childEnd[nodeParents[i]]++] = static_cast<uint32_t>(i);
+        }
+
+        constexpr uint32_t UNVISITED = ~0u;
+        std::vector<uint32_t> slots(nodeCount, UNVISITED);
+        std::vector<uint32_t> queue;
+        queue.reserve(nodeCount);
+        auto push = [&](uint32_t node) {
+            slots[node] = static_cast<uint32_t>(queue.size());
+            queue.push_back(node);
+        };
+        auto expand = [&](size_t head) {
+            for (; head < queue.size(); head++) {
+                const uint32_t node = queue[head];
+                for (uint32_t i = childBegin[node]; i < childBegin[node + 1]; i++) {
+                    if (slots[children[i]] == UNVISITED) push(children[i]);
+                }
+            }
+        };
+
+        // all roots go first, so every depth level of the hierarchy is contiguous
+        for (size_t i = 0; i < nodeCount; i++) {
+            if (nodeParents[i] < 0) push(static_cast<uint32_t>(i));
+        }
+        expand(0);
+
+        // nodes of a broken hierarchy that no root reaches, the caller treats them as roots
+        for (size_t i = 0; i < nodeCount; i++) {
+            if (slots[i] != UNVISITED) continue;
+            const size_t head = queue.size();
+            push(static_cast<uint32_t>(i));
+            expand(head);
+        }
+        return slots;
+    }
+
+    void Skeleton::computeDepthEnds() {
+        depthEnds.clear();
+        std::vector<uint32_t> depths(parents.size(), 0);
+        for (size_t i = 0; i < parents.size(); i++) {
+            depths[i] = parents[i] < 0 ? 0 : depths[parents[i]] + 1;
+            // breadth first order never returns to a shallower depth, except for the cut cycles of sortNodes
+            if (depths[i] >= depthEnds.size()) depthEnds.resize(depths[i] + 1, static_cast<uint32_t>(i));
+            depthEnds[depths[i]] = static_cast<uint32_t>(i + 1);
+        }
+        for (size_t depth = 1; depth < depthEnds.size(); depth++) {
+            depthEnds[depth] = std::max(depthEnds[depth], depthEnds[depth - 1]);
+        }
+    }
+
+    void Skeleton::computePalette(const AnimationPose &pose, std::vector<glm::mat4> &nodeGlobals,
+                                  glm::mat4 *palette) const {
+        const size_t nodeCount = parents.size();
+        nodeGlobals.resize(nodeCount);
+
+        for (size_t i = 0; i < nodeCount; i++) {
+            assert(parents[i] < static_cast<int32_t>(i) && "skeleton nodes must be ordered parents first");
+            const glm::mat4 local = pose.localMatrix(i);
+            nodeGlobals[i] = parents[i] < 0 ? local : nodeGlobals[parents[i]] * local;
+        }
+
+        for (size_t i = 0; i < jointNodes.size(); i++) {
+            palette[i] = nodeGlobals[jointNodes[i]] * inverseBindMatrices[i];
+        }
+    }
+}
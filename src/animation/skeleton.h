@@ -0,0 +1,64 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef SKELETON_H
+#define SKELETON_H
+
+#include <cstdint>
+#include <vector>
+
+#include "animation_clip.h"
+
+namespace vulkr {
+    /**
+     * The node hierarchy of a skinned model, flattened breadth first so every parent precedes its children, and
+     * the joints its vertices reference. Poses of the model are stored in the same order, so the global transforms
+     * and the palette are computed in one forward pass over the SoA local transforms without any recursion, and
+     * the nodes down to any depth form a prefix, which is how animation LODs truncate the skeleton.
+     */
+    struct Skeleton {
+        /**
+         * Parent of every node, always lower than the node itself, -1 for roots. Indexed like AnimationPose.
+         */
+        std::vector<int32_t> parents;
+        /**
+         * Node of every joint, a vertex's jointIndices index into this.
+         */
+        std::vector<uint32_t> jointNodes;
+        std::vector<glm::mat4> inverseBindMatrices;
+        /**
+         * Number of nodes at each depth or above, filled by computeDepthEnds().
+         */
+        std::vector<uint32_t> depthEnds;
+
+        bool empty() const { return jointNodes.empty(); }
+        uint32_t getJointCount() const { return static_cast<uint32_t>(jointNodes.size()); }
+
+        /**
+         * Number of nodes down to maxDepth (roots have depth 0), all of them for depths past the deepest node.
+         */
+        uint32_t getNodeLimit(uint32_t maxDepth) const {
+            return maxDepth < depthEnds.size() ? depthEnds[maxDepth] : static_cast<uint32_t>(parents.size());
+        }
+
+        /**
+         * Orders the nodes of a hierarchy given as the parent of every node (-1 for roots) breadth first, so that
+         * parents come before their children. Returns the flattened index of every node.
+         */
+        static std::vector<uint32_t> sortNodes(const std::vector<int32_t> &nodeParents);
+
+        /**
+         * Derives depthEnds from parents.
+         */
+        void computeDepthEnds();
+
+        /**
+         * Writes getJointCount() skinning matrices (joint model transform * inverse bind) for pose into palette.
+         * nodeGlobals is scratch space reused across calls.
+         */
+        void computePalette(const AnimationPose &pose, std::vector<glm::mat4> &nodeGlobals, glm::mat4 *palette) const;
+    };
+}
+
+#endif //SKELETON_H
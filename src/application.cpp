@@ -4,10 +4,12 @@
 
 #include "application.h"
 
+#include <algorithm>
 #include <array>
 #include <functional>
 #include <stdexcept>
 #include <chrono>
+#include <cmath>
 
 #define GLM_FORCE_RADIANS // force GLM to use radians for angles
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE // force GLM to use depth range [0, 1]
@@ -15,11 +17,19 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
 
+#include "animation/animation_scheduler.h"
 #include "input/camera_controller.h"
 #include "mesh/MeshLoader.h"
+#include "render/clustered_lighting_system.h"
+#include "render/crowd_render_system.h"
+#include "render/graph/render_graph.h"
+#include "render/shadow_render_system.h"
 #include "render/simple_render_system.h"
+#include "render/skinning_system.h"
+#include "render/upscale_render_system.h"
 #include "render/bone_render_system.h"
 #include "render/hud/hud_render_system.h"
+#include "render/debug/debug_draw_system.h"
 
 namespace vulkr {
     Application::Application() {
@@ -30,9 +40,25 @@ namespace vulkr {
     }
 
     void Application::run() {
-        SimpleRenderSystem simpleRenderSystem{vulkrDevice, vulkrRenderer.getSwapChainRenderPass()};
+        // the scene is drawn offscreen at a dynamic resolution, then scaled up underneath the full resolution HUD.
+        // Every pass is declared on the render graph, pipelines are built against the swap chain render pass,
+        // which is compatible with the graph's passes since they use the same formats
+        ClusteredLightingSystem lightingSystem{vulkrDevice};
+        ShadowRenderSystem shadowRenderSystem{vulkrDevice};
+        SkinningSystem skinningSystem{vulkrDevice};
+        AnimationScheduler animationScheduler{};
+        SimpleRenderSystem simpleRenderSystem{
+            vulkrDevice, vulkrRenderer.getSwapChainRenderPass(), lightingSystem.getGlobalSetLayout(),
+            shadowRenderSystem.getShadowSetLayout(), textureManager
+        };
+        CrowdRenderSystem crowdRenderSystem{
+            vulkrDevice, vulkrRenderer.getSwapChainRenderPass(), lightingSystem.getGlobalSetLayout(),
+            shadowRenderSystem.getShadowSetLayout(), textureManager
+        };
         BoneRenderSystem boneRenderSystem{vulkrDevice, vulkrRenderer.getSwapChainRenderPass()};
+        UpscaleRenderSystem upscaleRenderSystem{vulkrDevice, vulkrRenderer.getSwapChainRenderPass()};
         HudRenderSystem hudRenderSystem{vulkrDevice, vulkrRenderer.getSwapChainRenderPass()};
+        DebugDrawSystem debugDrawSystem{vulkrDevice, vulkrRenderer.getSwapChainRenderPass()};
         Camera camera{};
 
         auto viewerObject = GameObject::createGameObject();
@@ -43,6 +69,138 @@ namespace vulkr {
         int frameCount = 0;
         float fpsTimer = 0.0f;
         int fps = 0;
+        bool showDebugDraw = false;
+        bool debugKeyWasDown = false;
+
+        RenderGraph renderGraph{vulkrDevice};
+        RenderGraph::ImageHandle swapChainImage;
+        RenderGraph::ImageHandle sceneColor;
+        RenderGraph::BufferHandle clusterCounts;
+        RenderGraph::BufferHandle clusterIndices;
+        RenderGraph::PassHandle scenePass;
+        FrameInfo *currentFrame = nullptr;
+        uint32_t graphSwapChainGeneration = 0;
+        VkExtent2D transientExtent{0, 0};
+
+        // the graph depends on the swap chain extent and formats, so it is rebuilt with it
+        auto buildRenderGraph = [&]() {
+            renderGraph.reset();
+
+            const VkExtent2D extent = vulkrRenderer.getSwapChainExtent();
+            const VkFormat colorFormat = vulkrRenderer.getSwapChainImageFormat();
+            const VkFormat depthFormat = vulkrRenderer.getSwapChainDepthFormat();
+
+            // the transient targets only ever grow, the graph keeps their memory while a resize fits in it and
+            // the passes render the part the swap chain covers
+            transientExtent.width = std::max(transientExtent.width, extent.width);
+            transientExtent.height = std::max(transientExtent.height, extent.height);
+
+            swapChainImage = renderGraph.importImage("swap chain", colorFormat, extent, VK_IMAGE_LAYOUT_UNDEFINED,
+                                                     VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                                                     VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+            auto shadowMap = renderGraph.importImage(
+                "shadow map", shadowRenderSystem.getShadowFormat(),
+                {ShadowRenderSystem::SHADOW_MAP_SIZE, ShadowRenderSystem::SHADOW_MAP_SIZE},
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+            renderGraph.setImportedImage(shadowMap, shadowRenderSystem.getShadowImage(),
+                                         shadowRenderSystem.getShadowImageView());
+            clusterCounts = renderGraph.importBuffer("cluster counts");
+            clusterIndices = renderGraph.importBuffer("cluster indices");
+
+            // transient targets, the graph places the two depth buffers in the same memory
+            sceneColor = renderGraph.createImage("scene color", {transientExtent, colorFormat});
+            auto sceneDepth = renderGraph.createImage("scene depth", {transientExtent, depthFormat});
+            auto uiDepth = renderGraph.createImage("ui depth", {transientExtent, depthFormat});
+
+            renderGraph.addPass("light culling", [&](RenderGraph::PassBuilder &builder) {
+                builder.writeBuffer(clusterCounts, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+                builder.writeBuffer(clusterIndices, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+            }, [&lightingSystem, &currentFrame](VkCommandBuffer) {
+                lightingSystem.cullLights(*currentFrame);
+            });
+
+            // skinned vertex caches are written once here and read as static geometry by the passes below
+            renderGraph.addPass("skinning", [&](RenderGraph::PassBuilder &builder) {
+                builder.setSideEffect();
+            }, [&skinningSystem, &currentFrame](VkCommandBuffer commandBuffer) {
+                skinningSystem.skin(commandBuffer, currentFrame->frameIndex);
+            });
+
+            // the shadow system records its own render passes, one per stale cascade
+            renderGraph.addPass("shadows", [&](RenderGraph::PassBuilder &builder) {
+                builder.accessImage(shadowMap, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+                                    VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                    VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, true);
+            }, [this, &shadowRenderSystem, &lightingSystem, &skinningSystem, &currentFrame](VkCommandBuffer) {
+                shadowRenderSystem.render(*currentFrame, gameObjects, glm::vec3(lightingSystem.directionalLight),
+                                          skinningSystem);
+            });
+
+            scenePass = renderGraph.addPass("scene", [&](RenderGraph::PassBuilder &builder) {
+                builder.writeColor(sceneColor, VK_ATTACHMENT_LOAD_OP_CLEAR, {{0.4f, 0.4f, 0.4f, 1.0f}});
+                builder.writeDepth(sceneDepth);
+                builder.readBuffer(clusterCounts, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+                builder.readBuffer(clusterIndices, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+                builder.sampleImage(shadowMap);
+            }, [this, &simpleRenderSystem, &skinningSystem, &crowdRenderSystem, &debugDrawSystem, &currentFrame](
+                VkCommandBuffer commandBuffer) {
+                simpleRenderSystem.renderGameObjects(*currentFrame, gameObjects, skinningSystem);
+                // crowds are not in the depth pre-pass, they depth test and write like a forward pass
+                crowdRenderSystem.render(*currentFrame);
+                debugDrawSystem.render(commandBuffer, currentFrame->camera);
+            });
+
+            // the upscale covers every pixel, so the swap chain image is never cleared
+            renderGraph.addPass("ui", [&](RenderGraph::PassBuilder &builder) {
+                builder.writeColor(swapChainImage, VK_ATTACHMENT_LOAD_OP_DONT_CARE);
+                builder.writeDepth(uiDepth);
+                builder.sampleImage(sceneColor);
+            }, [this, &renderGraph, &sceneColor, &upscaleRenderSystem, &hudRenderSystem, &lightingSystem,
+                &shadowRenderSystem, &animationScheduler, &currentFrame, &fps](VkCommandBuffer commandBuffer) {
+                upscaleRenderSystem.render(commandBuffer, currentFrame->frameIndex,
+                                           renderGraph.getImageView(sceneColor), renderGraph.getGeneration(),
+                                           renderGraph.getImageExtent(sceneColor), vulkrRenderer.getSceneExtent(),
+                                           vulkrRenderer.getSwapChainExtent());
+
+                // everything below ends up in one draw
+                hudRenderSystem.begin(currentFrame->frameIndex, vulkrRenderer.getSwapChainExtent());
+                hudRenderSystem.drawCrosshair();
+
+                constexpr float scale = 2.0f;
+                constexpr float lineHeight = HudRenderSystem::GLYPH_HEIGHT * scale + 4.0f;
+                float y = 16.0f;
+                float x = hudRenderSystem.drawText("FPS ", 16.0f, y, scale);
+                hudRenderSystem.drawNumber(fps, x, y, scale);
+                y += lineHeight;
+                x = hudRenderSystem.drawText("GPU ", 16.0f, y, scale);
+                x = hudRenderSystem.drawNumber(vulkrRenderer.getGpuFrameMs(), 2, x, y, scale);
+                hudRenderSystem.drawText(" MS", x, y, scale);
+                y += lineHeight;
+                x = hudRenderSystem.drawText("SCALE ", 16.0f, y, scale);
+                x = hudRenderSystem.drawNumber(static_cast<int>(vulkrRenderer.getRenderScale() * 100.0f), x, y, scale);
+                hudRenderSystem.drawText("%", x, y, scale);
+                y += lineHeight;
+                x = hudRenderSystem.drawText("LIGHTS ", 16.0f, y, scale);
+                hudRenderSystem.drawNumber(static_cast<int>(lightingSystem.getLightCount()), x, y, scale);
+                y += lineHeight;
+                x = hudRenderSystem.drawText("CASCADES ", 16.0f, y, scale);
+                hudRenderSystem.drawNumber(static_cast<int>(shadowRenderSystem.getCascadesRenderedLastFrame()), x, y,
+                                           scale);
+                y += lineHeight;
+                x = hudRenderSystem.drawText("ANIMATED ", 16.0f, y, scale);
+                x = hudRenderSystem.drawNumber(static_cast<int>(animationScheduler.getSampledCount()), x, y, scale);
+                x = hudRenderSystem.drawText("/", x, y, scale);
+                hudRenderSystem.drawNumber(static_cast<int>(animationScheduler.getAnimatedCount()), x, y, scale);
+
+                hudRenderSystem.render(commandBuffer);
+            });
+
+            renderGraph.compile();
+            graphSwapChainGeneration = vulkrRenderer.getSwapChainGeneration();
+        };
 
         while (!vulkrWindow.shouldClose()) {
             glfwPollEvents();
@@ -60,15 +218,58 @@ namespace vulkr {
             float aspect = vulkrRenderer.getAspectRatio();
             camera.setPerspectiveProjection(glm::radians(50.0f), aspect, 0.1f, 10.0f);
 
+            // after the camera moved, its screen size metric picks each instance's animation rate
+            animationScheduler.update(frameTime, camera, gameObjects);
+
             if (auto commandBuffer = vulkrRenderer.beginFrame()) {
-                vulkrRenderer.beginSwapChainRenderPass(commandBuffer);
+                if (graphSwapChainGeneration != vulkrRenderer.getSwapChainGeneration()) {
+                    buildRenderGraph();
+                }
+
+                int frameIndex = vulkrRenderer.getFrameIndex();
+                FrameInfo frameInfo{
+                    frameIndex, frameTime, commandBuffer, camera, lightingSystem.getGlobalDescriptorSet(frameIndex),
+                    shadowRenderSystem.getShadowDescriptorSet(frameIndex)
+                };
+                currentFrame = &frameInfo;
 
-                simpleRenderSystem.renderGameObjects(commandBuffer, gameObjects, camera);
+                // the slot's previous frame has completed, its texture feedback decides what streams in or out
+                textureManager.getStreamer().update(commandBuffer, frameIndex);
+                lightingSystem.update(frameInfo, gameObjects, vulkrRenderer.getSceneExtent());
+                skinningSystem.update(frameIndex, gameObjects, animationScheduler);
 
-                hudRenderSystem.renderNumber(commandBuffer, fps, -0.95f, 0.9f, 0.03f, aspect);
-                hudRenderSystem.render(commandBuffer, aspect);
+                // F3 toggles bounds and light ranges, a no-op in release builds
+                const bool debugKeyDown = glfwGetKey(vulkrWindow.getWindow(), GLFW_KEY_F3) == GLFW_PRESS;
+                if (debugKeyDown && !debugKeyWasDown) showDebugDraw = !showDebugDraw;
+                debugKeyWasDown = debugKeyDown;
 
-                vulkrRenderer.endSwapChainRenderPass(commandBuffer);
+                debugDrawSystem.begin(frameIndex);
+                if (showDebugDraw) {
+                    debugDrawSystem.axis(glm::mat4{1.0f}, 0.5f, false);
+                    for (auto &obj: gameObjects) {
+                        if (obj.model != nullptr) {
+                            const glm::vec3 center = (obj.model->getBoundsMin() + obj.model->getBoundsMax()) * 0.5f;
+                            const glm::vec3 halfExtent = (obj.model->getBoundsMax() - obj.model->getBoundsMin()) * 0.5f;
+                            const glm::mat4 bounds = obj.transform.mat4() *
+                                                     glm::scale(glm::translate(glm::mat4{1.0f}, center), halfExtent);
+                            debugDrawSystem.box(bounds, {0.2f, 1.0f, 0.2f, 1.0f});
+                        }
+                        if (obj.light != nullptr) {
+                            debugDrawSystem.sphere(obj.transform.translation, obj.light->range,
+                                                   glm::vec4(obj.light->color, 1.0f));
+                        }
+                    }
+                }
+
+                renderGraph.setImportedImage(swapChainImage, vulkrRenderer.getCurrentSwapChainImage(),
+                                             vulkrRenderer.getCurrentSwapChainImageView());
+                renderGraph.setImportedBuffer(clusterCounts, lightingSystem.getClusterCountBuffer(frameIndex));
+                renderGraph.setImportedBuffer(clusterIndices, lightingSystem.getClusterIndexBuffer(frameIndex));
+                renderGraph.setRenderArea(scenePass, vulkrRenderer.getSceneExtent());
+                renderGraph.execute(commandBuffer);
+                textureManager.getStreamer().endFrame(commandBuffer);
+
+                currentFrame = nullptr;
                 vulkrRenderer.endFrame();
             } else {
                 continue;
@@ -77,7 +278,9 @@ namespace vulkr {
             fpsTimer += frameTime;
             frameCount++;
             if (fpsTimer >= 1.0f) {
-                std::cout << "FPS: " << frameCount << std::endl;
+                std::cout << "FPS: " << frameCount << " | GPU: " << vulkrRenderer.getGpuFrameMs()
+                        << " ms | render scale: " << vulkrRenderer.getRenderScale() << " | streamed textures: "
+                        << textureManager.getStreamer().getResidentBytes() / (1024 * 1024) << " MiB" << std::endl;
                 fps = frameCount;
                 frameCount = 0;
                 fpsTimer = 0.0f;
@@ -89,10 +292,19 @@ namespace vulkr {
 
     void Application::update(float dt) {
         gameObjects.at(0).transform.rotation.y += 1 * dt; // Rotate the first object around the Y-axis
+
+        // orbit the point lights around the vase
+        const auto orbit = glm::rotate(glm::mat4(1.0f), 0.5f * dt, {0.0f, -1.0f, 0.0f});
+        const glm::vec3 center{0.0f, 0.0f, 2.5f};
+        for (auto &obj: gameObjects) {
+            if (obj.light == nullptr) continue;
+            obj.transform.translation = center + glm::vec3(orbit * glm::vec4(obj.transform.translation - center, 1.0f));
+        }
     }
 
     void Application::loadGameObjects() {
-        std::shared_ptr<VulkrModel> vulkrModel = MeshLoader::loadObjModel(vulkrDevice, "models/smooth_vase.obj");
+        std::shared_ptr<VulkrModel> vulkrModel = MeshLoader::loadObjModel(vulkrDevice, textureManager,
+                                                                          "models/smooth_vase.obj");
 
         auto obj = GameObject::createGameObject();
         obj.model = vulkrModel;
@@ -101,14 +313,40 @@ namespace vulkr {
 
         gameObjects.push_back(std::move(obj));
 
-        std::shared_ptr<VulkrModel> c_cube = MeshLoader::loadObjModel(vulkrDevice, "models/colored_cube.obj");
+        std::shared_ptr<VulkrModel> c_cube = MeshLoader::loadObjModel(vulkrDevice, textureManager,
+                                                                      "models/colored_cube.obj");
 
         auto cube = GameObject::createGameObject();
         cube.enableLighting = false;
+        cube.isStatic = true;
         cube.model = c_cube;
         cube.transform.translation = {2, 0, 2.5f};
         cube.transform.scale = {.3f, .3f, .3f};
 
         gameObjects.push_back(std::move(cube));
+
+        auto floor = GameObject::createGameObject();
+        floor.model = MeshLoader::loadObjModel(vulkrDevice, textureManager, "models/cube.obj");
+        floor.transform.translation = {0.5f, 0.01f, 2.5f};
+        floor.transform.scale = {2.5f, .01f, 1.5f};
+        floor.isStatic = true;
+
+        gameObjects.push_back(std::move(floor));
+
+        const std::vector<glm::vec3> lightColors{
+            {1.f, .1f, .1f},
+            {.1f, .1f, 1.f},
+            {.1f, 1.f, .1f},
+            {1.f, 1.f, .1f},
+            {.1f, 1.f, 1.f},
+            {1.f, 1.f, 1.f}
+        };
+
+        for (size_t i = 0; i < lightColors.size(); i++) {
+            auto pointLight = GameObject::makePointLight(4.0f, 1.5f, lightColors[i]);
+            const float angle = static_cast<float>(i) * glm::two_pi<float>() / static_cast<float>(lightColors.size());
+            pointLight.transform.translation = glm::vec3(std::cos(angle), -0.5f, 2.5f + std::sin(angle));
+            gameObjects.push_back(std::move(pointLight));
+        }
     }
 }
@@ -12,6 +12,7 @@
 
 #include "game/game_object.h"
 #include "render/vulkr_renderer.h"
+#include "texture/texture_manager.h"
 
 namespace vulkr {
     class Application {
@@ -37,6 +38,8 @@ namespace vulkr {
         VulkrWindow vulkrWindow{WIDTH, HEIGHT, "Vulkan 3D Rendering Engine"};
         VulkrDevice vulkrDevice{vulkrWindow};
         VulkrRenderer vulkrRenderer{vulkrWindow, vulkrDevice};
+        // declared before the game objects, whose models hold its materials
+        TextureManager textureManager{vulkrDevice};
 
         std::vector<GameObject> gameObjects;
     };
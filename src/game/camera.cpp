@@ -4,6 +4,9 @@
 
 #include "camera.h"
 
+#include <glm/gtc/matrix_access.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+
 namespace vulkr {
     void Camera::setOrthographicProjection(float left, float right, float top, float bottom, float near, float far) {
         projectionMatrix = glm::mat4{1.0f};
@@ -13,6 +16,9 @@ namespace vulkr {
         projectionMatrix[3][0] = -(right + left) / (right - left);
         projectionMatrix[3][1] = -(bottom + top) / (bottom - top);
         projectionMatrix[3][2] = -near / (far - near);
+        inverseProjectionMatrix = glm::inverse(projectionMatrix);
+        nearPlane = near;
+        farPlane = far;
     }
 
     void Camera::setPerspectiveProjection(float fovy, float aspect, float near, float far) {
@@ -24,6 +30,9 @@ namespace vulkr {
         projectionMatrix[2][2] = far / (far - near);
         projectionMatrix[2][3] = 1.f;
         projectionMatrix[3][2] = -(far * near) / (far - near);
+        inverseProjectionMatrix = glm::inverse(projectionMatrix);
+        nearPlane = near;
+        farPlane = far;
     }
 
     void Camera::setViewDirection(glm::vec3 position, glm::vec3 direction, glm::vec3 up) {
@@ -44,6 +53,7 @@ namespace vulkr {
         viewMatrix[3][0] = -glm::dot(u, position);
         viewMatrix[3][1] = -glm::dot(v, position);
         viewMatrix[3][2] = -glm::dot(w, position);
+        inverseViewMatrix = glm::affineInverse(viewMatrix);
     }
 
     void Camera::setViewTarget(glm::vec3 position, glm::vec3 target, glm::vec3 up) {
@@ -73,5 +83,26 @@ namespace vulkr {
         viewMatrix[3][0] = -glm::dot(u, position);
         viewMatrix[3][1] = -glm::dot(v, position);
         viewMatrix[3][2] = -glm::dot(w, position);
+        inverseViewMatrix = glm::affineInverse(viewMatrix);
+    }
+
+    float Camera::getScreenSize(const glm::vec3 &center, float radius) const {
+        // frustum planes from the rows of projection * view, depth in [0, 1]
+        const glm::mat4 projectionView = projectionMatrix * viewMatrix;
+        const glm::vec4 rows[4] = {
+            glm::row(projectionView, 0), glm::row(projectionView, 1),
+            glm::row(projectionView, 2), glm::row(projectionView, 3)
+        };
+        const glm::vec4 planes[6] = {
+            rows[3] + rows[0], rows[3] - rows[0], rows[3] + rows[1], rows[3] - rows[1], rows[2], rows[3] - rows[2]
+        };
+        for (const glm::vec4 &plane: planes) {
+            const float distance = glm::dot(glm::vec3(plane), center) + plane.w;
+            if (distance < -radius * glm::length(glm::vec3(plane))) return 0.0f;
+        }
+
+        const float depth = (viewMatrix * glm::vec4(center, 1.0f)).z;
+        if (depth <= radius) return 1.0f;
+        return glm::min(radius * projectionMatrix[1][1] / depth, 1.0f);
     }
 }
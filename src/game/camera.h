@@ -30,9 +30,32 @@ namespace vulkr {
             return viewMatrix;
         }
 
+        const glm::mat4 &getInverseView() const {
+            return inverseViewMatrix;
+        }
+
+        const glm::mat4 &getInverseProjection() const {
+            return inverseProjectionMatrix;
+        }
+
+        glm::vec3 getPosition() const { return glm::vec3(inverseViewMatrix[3]); }
+
+        float getNear() const { return nearPlane; }
+        float getFar() const { return farPlane; }
+
+        /**
+         * Height a world space bounding sphere covers on screen, as a fraction of the viewport height, or 0
+         * when the sphere lies outside the view frustum. The level of detail metric, perspective projections only.
+         */
+        float getScreenSize(const glm::vec3 &center, float radius) const;
+
     private:
         glm::mat4 projectionMatrix{1.0f};
         glm::mat4 viewMatrix{1.0f};
+        glm::mat4 inverseViewMatrix{1.0f};
+        glm::mat4 inverseProjectionMatrix{1.0f};
+        float nearPlane{0.1f};
+        float farPlane{10.0f};
     };
 }
 
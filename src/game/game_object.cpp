@@ -62,4 +62,30 @@ namespace vulkr {
             },
         };
     }
+
+    TransformComponent TransformComponent::fromMatrix(const glm::mat4 &matrix) {
+        TransformComponent transform{};
+        transform.translation = glm::vec3(matrix[3]);
+
+        glm::mat3 rotation{matrix};
+        transform.scale = {glm::length(rotation[0]), glm::length(rotation[1]), glm::length(rotation[2])};
+        if (glm::determinant(rotation) < 0.0f) {
+            transform.scale.x = -transform.scale.x; // a mirrored basis keeps a proper rotation
+        }
+        for (int i = 0; i < 3; i++) {
+            if (transform.scale[i] != 0.0f) rotation[i] /= transform.scale[i];
+        }
+
+        // inverse of mat4(): column 2 is (c2 * s1, -s2, c1 * c2), row 1 holds c2 * s3 and c2 * c3
+        transform.rotation.x = glm::asin(glm::clamp(-rotation[2][1], -1.0f, 1.0f));
+        if (glm::abs(rotation[2][1]) < 0.9999f) {
+            transform.rotation.y = glm::atan(rotation[2][0], rotation[2][2]);
+            transform.rotation.z = glm::atan(rotation[0][1], rotation[1][1]);
+        } else {
+            // gimbal lock, only y + z is defined
+            transform.rotation.y = glm::atan(-rotation[0][2], rotation[0][0]);
+            transform.rotation.z = 0.0f;
+        }
+        return transform;
+    }
 }
@@ -8,6 +8,7 @@
 #include <memory>
 #include <glm/gtc/matrix_transform.hpp>
 #include "../model/vulkr_model.h"
+#include "../animation/animation_player.h"
 
 namespace vulkr {
     struct TransformComponent {
@@ -24,6 +25,29 @@ namespace vulkr {
         glm::mat4 mat4();
 
         glm::mat3 normalMatrix();
+
+        /**
+         * Decomposes an affine matrix into translation, rotation and scale, shear is lost.
+         */
+        static TransformComponent fromMatrix(const glm::mat4 &matrix);
+    };
+
+    /**
+     * Dynamic light, positioned by the owning object's transform translation.
+     */
+    struct LightComponent {
+        enum class Type { Point, Spot };
+
+        Type type{Type::Point};
+        glm::vec3 color{1.0f};
+        float intensity{1.0f};
+        float range{1.0f};
+        /**
+         * World space direction a spot light points along.
+         */
+        glm::vec3 direction{0.0f, 1.0f, 0.0f};
+        float innerConeAngle{glm::radians(20.0f)};
+        float outerConeAngle{glm::radians(30.0f)};
     };
 
     class GameObject {
@@ -35,6 +59,15 @@ namespace vulkr {
             return GameObject(currentId++);
         }
 
+        static GameObject makePointLight(float intensity = 1.0f, float range = 1.0f, glm::vec3 color = glm::vec3(1.0f)) {
+            GameObject obj = createGameObject();
+            obj.light = std::make_unique<LightComponent>();
+            obj.light->intensity = intensity;
+            obj.light->range = range;
+            obj.light->color = color;
+            return obj;
+        }
+
         GameObject(GameObject &) = delete;
 
         GameObject &operator=(const GameObject &) = delete;
@@ -49,6 +82,17 @@ namespace vulkr {
         glm::vec3 color{};
         TransformComponent transform{};
         bool enableLighting{true};
+        /**
+         * Static objects never move, which lets shadow cascades covering only static objects be cached.
+         */
+        bool isStatic{false};
+
+        std::unique_ptr<LightComponent> light{};
+
+        /**
+         * Plays one of the model's animations, sampled by the AnimationScheduler at a rate set by its screen size.
+         */
+        std::unique_ptr<AnimationPlayer> animation{};
 
     private:
         explicit GameObject(id_t objId) : id(objId) {
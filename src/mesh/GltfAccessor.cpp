@@ -0,0 +1,151 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "GltfAccessor.h"
+
+#include <limits>
+#include <stdexcept>
+
+namespace vulkr {
+    GltfAccessor::GltfAccessor(const GltfDocument &document, int accessorIndex) {
+        const tinygltf::Model &model = document.model;
+        if (accessorIndex < 0 || accessorIndex >= static_cast<int>(model.accessors.size())) {
+            throw std::runtime_error("failed to read glTF accessor, index out of range!");
+        }
+
+        accessor = &model.accessors[accessorIndex];
+        count = accessor->count;
+        componentType = accessor->componentType;
+        componentCount = tinygltf::GetNumComponentsInType(static_cast<uint32_t>(accessor->type));
+        componentSize = tinygltf::GetComponentSizeInBytes(static_cast<uint32_t>(componentType));
+        normalized = accessor->normalized;
+        if (componentCount <= 0 || componentSize <= 0) {
+            throw std::runtime_error("failed to read glTF accessor, unsupported type!");
+        }
+        stride = static_cast<size_t>(componentCount) * componentSize;
+
+        if (accessor->bufferView < 0) {
+            return;
+        }
+
+        if (accessor->bufferView >= static_cast<int>(model.bufferViews.size())) {
+            throw std::runtime_error("failed to read glTF accessor, buffer view out of range!");
+        }
+        const tinygltf::BufferView &bufferView = model.bufferViews[accessor->bufferView];
+        if (bufferView.buffer < 0 || bufferView.buffer >= static_cast<int>(document.buffers.size())) {
+            throw std::runtime_error("failed to read glTF accessor, buffer out of range!");
+        }
+        const std::span<const uint8_t> buffer = document.buffers[bufferView.buffer];
+        const int byteStride = accessor->ByteStride(bufferView);
+        if (byteStride <= 0) {
+            throw std::runtime_error("failed to read glTF accessor, invalid byte stride!");
+        }
+        stride = static_cast<size_t>(byteStride);
+
+        // the last element only needs its own components, not a full stride
+        const size_t offset = bufferView.byteOffset + accessor->byteOffset;
+        const size_t size = count == 0 ? 0 : (count - 1) * stride + componentCount * componentSize;
+        if (offset + size > buffer.size() || accessor->byteOffset + size > bufferView.byteLength) {
+            throw std::runtime_error("failed to read glTF accessor, it exceeds its buffer!");
+        }
+        data = buffer.data() + offset;
+    }
+
+    GltfAccessor GltfAccessor::attribute(const GltfDocument &document, const tinygltf::Primitive &primitive,
+                                         const char *name) {
+        const auto it = primitive.attributes.find(name);
+        return it != primitive.attributes.end() ? GltfAccessor{document, it->second} : GltfAccessor{};
+    }
+
+    float GltfAccessor::readFloat(size_t element, int component) const {
+        if (data == nullptr) return 0.0f;
+
+        const uint8_t *source = data + element * stride + component * componentSize;
+        switch (componentType) {
+            case TINYGLTF_COMPONENT_TYPE_FLOAT: {
+                float value;
+                std::memcpy(&value, source, sizeof(value));
+                return value;
+            }
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: {
+                const float value = *source;
+                return normalized ? value / 255.0f : value;
+            }
+            case TINYGLTF_COMPONENT_TYPE_BYTE: {
+                const float value = static_cast<float>(*reinterpret_cast<const int8_t *>(source));
+                return normalized ? glm::max(value / 127.0f, -1.0f) : value;
+            }
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
+                uint16_t value;
+                std::memcpy(&value, source, sizeof(value));
+                return normalized ? static_cast<float>(value) / 65535.0f : static_cast<float>(value);
+            }
+            case TINYGLTF_COMPONENT_TYPE_SHORT: {
+                int16_t value;
+                std::memcpy(&value, source, sizeof(value));
+                return normalized ? glm::max(static_cast<float>(value) / 32767.0f, -1.0f) : static_cast<float>(value);
+            }
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT: {
+                uint32_t value;
+                std::memcpy(&value, source, sizeof(value));
+                return static_cast<float>(value);
+            }
+            case TINYGLTF_COMPONENT_TYPE_INT: {
+                int32_t value;
+                std::memcpy(&value, source, sizeof(value));
+                return static_cast<float>(value);
+            }
+            case TINYGLTF_COMPONENT_TYPE_DOUBLE: {
+                double value;
+                std::memcpy(&value, source, sizeof(value));
+                return static_cast<float>(value);
+            }
+            default:
+                return 0.0f;
+        }
+    }
+
+    uint32_t GltfAccessor::readUint(size_t element, int component) const {
+        if (data == nullptr) return 0;
+
+        const uint8_t *source = data + element * stride + component * componentSize;
+        switch (componentType) {
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+            case TINYGLTF_COMPONENT_TYPE_BYTE:
+                return *source;
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+            case TINYGLTF_COMPONENT_TYPE_SHORT: {
+                uint16_t value;
+                std::memcpy(&value, source, sizeof(value));
+                return value;
+            }
+            case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+            case TINYGLTF_COMPONENT_TYPE_INT: {
+                uint32_t value;
+                std::memcpy(&value, source, sizeof(value));
+                return value;
+            }
+            default:
+                return static_cast<uint32_t>(readFloat(element, component));
+        }
+    }
+
+    void GltfAccessor::getBounds(glm::vec3 &min, glm::vec3 &max) const {
+        if (accessor != nullptr && accessor->minValues.size() >= 3 && accessor->maxValues.size() >= 3) {
+            for (int c = 0; c < 3; c++) {
+                min[c] = static_cast<float>(accessor->minValues[c]);
+                max[c] = static_cast<float>(accessor->maxValues[c]);
+            }
+            return;
+        }
+
+        min = glm::vec3(std::numeric_limits<float>::max());
+        max = glm::vec3(std::numeric_limits<float>::lowest());
+        for (size_t i = 0; i < count; i++) {
+            const glm::vec3 position = read<3>(i);
+            min = glm::min(min, position);
+            max = glm::max(max, position);
+        }
+    }
+}
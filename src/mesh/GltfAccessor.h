@@ -0,0 +1,105 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef GLTFACCESSOR_H
+#define GLTFACCESSOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <glm/glm.hpp>
+
+#include "GltfDocument.h"
+
+namespace vulkr {
+    /**
+     * Reads the elements of a glTF accessor in place from the document's buffer views, honouring the buffer view's byte stride and converting
+     * any component type to float, normalized integers per the glTF rules. Accessors without a buffer view
+     * read as zeros; sparse substitution is not applied.
+     */
+    class GltfAccessor {
+    public:
+        GltfAccessor() = default;
+
+        GltfAccessor(const GltfDocument &document, int accessorIndex);
+
+        /**
+         * The accessor of a primitive attribute, an empty reader if the primitive does not have it.
+         */
+        static GltfAccessor attribute(const GltfDocument &document, const tinygltf::Primitive &primitive,
+                                      const char *name);
+
+        bool empty() const { return count == 0; }
+        size_t getCount() const { return count; }
+        int getComponentCount() const { return componentCount; }
+
+        /**
+         * True if the elements are tightly packed components of componentType, so a range can be memcpy'd.
+         */
+        bool isPacked(int type) const {
+            return data != nullptr && componentType == type && stride == componentCount * componentSize;
+        }
+
+        /**
+         * Copies the raw elements of a packed accessor, see isPacked().
+         */
+        void copyPacked(void *destination) const { std::memcpy(destination, data, count * stride); }
+
+        float readFloat(size_t element, int component) const;
+
+        uint32_t readUint(size_t element, int component) const;
+
+        /**
+         * Reads the first N components of an element, the ones the accessor lacks keep fallback's.
+         */
+        template<glm::length_t N>
+        glm::vec<N, float> read(size_t element, glm::vec<N, float> fallback = glm::vec<N, float>(0.0f)) const {
+            const int n = glm::min(static_cast<int>(N), componentCount);
+            if (data != nullptr && componentType == TINYGLTF_COMPONENT_TYPE_FLOAT) {
+                const auto *source = data + element * stride;
+                std::memcpy(&fallback[0], source, n * sizeof(float));
+                return fallback;
+            }
+            for (int c = 0; c < n; c++) {
+                fallback[c] = readFloat(element, c);
+            }
+            return fallback;
+        }
+
+        /**
+         * Writes the first N components of every element as floats to destination, advancing destinationStride
+         * bytes per element. Tightly packed float sources into a packed destination are one memcpy.
+         */
+        template<glm::length_t N>
+        void copyTo(void *destination, size_t destinationStride, glm::vec<N, float> fallback = glm::vec<N, float>(0.0f)) const {
+            auto *target = static_cast<uint8_t *>(destination);
+            if (componentCount == N && isPacked(TINYGLTF_COMPONENT_TYPE_FLOAT) && destinationStride == N * sizeof(float)) {
+                std::memcpy(target, data, count * destinationStride);
+                return;
+            }
+            for (size_t i = 0; i < count; i++) {
+                const glm::vec<N, float> value = read<N>(i, fallback);
+                std::memcpy(target + i * destinationStride, &value, sizeof(value));
+            }
+        }
+
+        /**
+         * Bounds of a VEC3 accessor, from its min and max when the file provides them.
+         */
+        void getBounds(glm::vec3 &min, glm::vec3 &max) const;
+
+    private:
+        const tinygltf::Accessor *accessor{nullptr};
+        const uint8_t *data{nullptr};
+        size_t count{0};
+        size_t stride{0};
+        int componentType{TINYGLTF_COMPONENT_TYPE_FLOAT};
+        int componentCount{0};
+        int componentSize{0};
+        bool normalized{false};
+    };
+}
+
+#endif //GLTFACCESSOR_H
@@ -0,0 +1,148 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "GltfDocument.h"
+
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+#include "MeshoptDecoder.h"
+#include "gltf_tiny/json.hpp"
+
+namespace vulkr {
+    namespace {
+        constexpr uint32_t GLB_MAGIC = 0x46546C67; // "glTF"
+        constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;
+        constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;
+
+        // .glb is little endian, like every platform the renderer runs on
+        uint32_t readUint32(const uint8_t *bytes) {
+            uint32_t value;
+            std::memcpy(&value, bytes, sizeof(value));
+            return value;
+        }
+    }
+
+    void loadGltfDocument(const std::string &path, GltfDocument &document) {
+        const MappedFile &file = *document.files.emplace_back(std::make_unique<MappedFile>(path));
+        const std::span<const uint8_t> bytes = file.getData();
+
+        std::span<const uint8_t> json = bytes;
+        std::span<const uint8_t> bin{};
+        if (bytes.size() >= 12 && readUint32(bytes.data()) == GLB_MAGIC) {
+            const size_t length = readUint32(bytes.data() + 8);
+            if (length > bytes.size()) {
+                throw std::runtime_error("Failed to load glTF model: " + path + "\ntruncated glb file");
+            }
+
+            json = {};
+            size_t offset = 12;
+            while (offset + 8 <= length) {
+                const size_t chunkLength = readUint32(bytes.data() + offset);
+                const uint32_t chunkType = readUint32(bytes.data() + offset + 4);
+                offset += 8;
+                if (chunkLength > length - offset) {
+                    throw std::runtime_error("Failed to load glTF model: " + path + "\nglb chunk exceeds the file");
+                }
+
+                if (chunkType == GLB_CHUNK_JSON && json.empty()) {
+                    json = bytes.subspan(offset, chunkLength);
+                } else if (chunkType == GLB_CHUNK_BIN && bin.empty()) {
+                    bin = bytes.subspan(offset, chunkLength);
+                }
+                // chunks are padded to 4 bytes
+                offset += (chunkLength + 3) & ~size_t{3};
+            }
+
+            if (json.empty()) {
+                throw std::runtime_error("Failed to load glTF model: " + path + "\nglb has no JSON chunk");
+            }
+        }
+
+        // the buffers and images are taken out of the JSON, tinygltf would copy the BIN chunk and decode images
+        nlohmann::json root = nlohmann::json::parse(json.begin(), json.end(), nullptr, false);
+        if (root.is_discarded() || !root.is_object()) {
+            throw std::runtime_error("Failed to load glTF model: " + path + "\ninvalid JSON");
+        }
+        nlohmann::json buffers = root.contains("buffers") ? std::move(root["buffers"]) : nlohmann::json::array();
+        nlohmann::json images = root.contains("images") ? std::move(root["images"]) : nlohmann::json::array();
+        root.erase("buffers");
+        root.erase("images");
+        const std::string text = root.dump();
+
+        const std::string baseDirectory = std::filesystem::path(path).parent_path().string();
+        tinygltf::Model &model = document.model;
+        tinygltf::TinyGLTF loader;
+        std::string err;
+        std::string warn;
+        if (!loader.LoadASCIIFromString(&model, &err, &warn, text.c_str(), static_cast<unsigned int>(text.size()),
+                                        baseDirectory)) {
+            throw std::runtime_error("Failed to load glTF model: " + path + "\n" + err + warn);
+        }
+
+        if (!warn.empty()) {
+            std::cout << "glTF Loader Warning: " << warn << std::endl;
+        }
+        if (!err.empty()) {
+            std::cerr << "glTF Loader Error: " << err << std::endl;
+        }
+
+        if (!buffers.is_array() || !images.is_array()) {
+            throw std::runtime_error("Failed to load glTF model: " + path + "\nbuffers and images must be arrays");
+        }
+
+        model.buffers.resize(buffers.size());
+        document.buffers.resize(buffers.size());
+        for (size_t i = 0; i < buffers.size(); i++) {
+            const nlohmann::json &source = buffers[i];
+            tinygltf::Buffer &buffer = model.buffers[i];
+            const size_t byteLength = source.value("byteLength", size_t{0});
+            buffer.name = source.value("name", std::string{});
+            buffer.uri = source.value("uri", std::string{});
+
+            // fallback buffers only stand in for the decoded data of compressed views, they may still name an
+            // uncompressed .bin for loaders without the extension, that file is never needed or even present
+            const bool meshoptFallback = source.contains("extensions") && source["extensions"].is_object()
+                                         && source["extensions"].contains("EXT_meshopt_compression")
+                                         && source["extensions"]["EXT_meshopt_compression"].value("fallback", false);
+            if (meshoptFallback) {
+                document.buffers[i] = {};
+            } else if (buffer.uri.empty()) {
+                // only the first buffer of a .glb may refer to the BIN chunk
+                if (i != 0 || bin.size() < byteLength) {
+                    throw std::runtime_error("Failed to load glTF model: " + path + "\nbuffer without BIN chunk");
+                }
+                document.buffers[i] = bin.first(byteLength);
+            } else if (tinygltf::IsDataURI(buffer.uri)) {
+                std::string mimeType;
+                if (!tinygltf::DecodeDataURI(&buffer.data, mimeType, buffer.uri, byteLength, true)) {
+                    throw std::runtime_error("Failed to load glTF model: " + path + "\ninvalid data uri");
+                }
+                document.buffers[i] = buffer.data;
+            } else {
+                std::string decodedUri;
+                tinygltf::URIDecode(buffer.uri, &decodedUri, nullptr);
+                const std::string bufferPath = (std::filesystem::path(baseDirectory) / decodedUri).string();
+                const MappedFile &external = *document.files.emplace_back(std::make_unique<MappedFile>(bufferPath));
+                if (external.getData().size() < byteLength) {
+                    throw std::runtime_error("Failed to load glTF model: " + path + "\nbuffer exceeds " + bufferPath);
+                }
+                document.buffers[i] = external.getData().first(byteLength);
+            }
+        }
+
+        model.images.reserve(images.size());
+        for (const nlohmann::json &source: images) {
+            tinygltf::Image &image = model.images.emplace_back();
+            image.name = source.value("name", std::string{});
+            image.uri = source.value("uri", std::string{});
+            image.mimeType = source.value("mimeType", std::string{});
+            image.bufferView = source.value("bufferView", -1);
+        }
+
+        decodeMeshoptBufferViews(document);
+    }
+}
@@ -0,0 +1,40 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef GLTFDOCUMENT_H
+#define GLTFDOCUMENT_H
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "gltf_tiny/tiny_gltf.h"
+#include "../utils/mapped_file.h"
+
+namespace vulkr {
+    /**
+     * A glTF or .glb file parsed in place. The binary buffers are views of memory mapped files, the .glb's
+     * BIN chunk or external .bin files, rather than copies in model.buffers[].data, so buffer data must be
+     * read through buffers. Only base64 data URIs are decoded into model.buffers[].data.
+     * EXT_meshopt_compression buffer views are decoded on load into decodedBuffers and point at extra
+     * buffers appended to model.buffers.
+     */
+    struct GltfDocument {
+        tinygltf::Model model;
+        // indexed like model.buffers
+        std::vector<std::span<const uint8_t>> buffers;
+        std::vector<std::unique_ptr<MappedFile>> files;
+        std::vector<std::vector<uint8_t>> decodedBuffers;
+    };
+
+    /**
+     * Maps path and parses only its JSON. Images are listed in model.images with their uri or buffer view
+     * but are not decoded.
+     */
+    void loadGltfDocument(const std::string &path, GltfDocument &document);
+}
+
+#endif //GLTFDOCUMENT_H
@@ -3,12 +3,18 @@
 //
 
 #include "MeshLoader.h"
+// before the implementation defines, tiny_gltf.h only guards its declarations
+#include "GltfAccessor.h"
 
 #define TINYGLTF_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 // #define TINYGLTF_NOEXCEPTION // optional. disable exception handling.
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -24,6 +30,7 @@
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/hash.hpp>
+#include <glm/gtx/matrix_decompose.hpp>
 
 namespace std {
     template<>
@@ -37,14 +44,17 @@ namespace std {
 }
 
 namespace vulkr {
-    VulkrModel::Builder loadModel(const std::string &path) {
+    VulkrModel::Builder loadModel(const std::string &path, std::string &diffuseTexture) {
         VulkrModel::Builder builder{};
         tinyobj::attrib_t attrib;
         std::vector<tinyobj::shape_t> shapes;
         std::vector<tinyobj::material_t> materials;
         std::string warn, err;
 
-        if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, path.c_str())) {
+        // material libraries and their textures are relative to the .obj
+        const std::filesystem::path directory = std::filesystem::path(path).parent_path();
+        const std::string materialDirectory = directory.empty() ? std::string{} : (directory / "").string();
+        if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, path.c_str(), materialDirectory.c_str())) {
             std::cerr << err << std::endl;
             throw std::runtime_error(warn + err);
         }
@@ -79,10 +89,11 @@ namespace vulkr {
                     };
                 }
 
+                // two components per texcoord, with V pointing up like OpenGL's
                 if (index.texcoord_index >= 0) {
                     vertex.uv = {
-                        attrib.texcoords[3 * index.texcoord_index + 0],
-                        attrib.texcoords[3 * index.texcoord_index + 1],
+                        attrib.texcoords[2 * index.texcoord_index + 0],
+                        1.0f - attrib.texcoords[2 * index.texcoord_index + 1],
                     };
                 }
 
@@ -94,14 +105,28 @@ namespace vulkr {
             }
         }
 
+        // the whole model is drawn with the diffuse texture of the first face that has one
+        for (const auto &shape: shapes) {
+            for (int materialId: shape.mesh.material_ids) {
+                if (materialId >= 0 && materialId < static_cast<int>(materials.size()) &&
+                    !materials[materialId].diffuse_texname.empty()) {
+                    diffuseTexture = (directory / materials[materialId].diffuse_texname).lexically_normal().string();
+                    break;
+                }
+            }
+            if (!diffuseTexture.empty()) break;
+        }
+
         std::cout << "VulkrModel::Builder::loadModel: Loaded " << builder.vertices.size() << " unique vertices and "
                 << builder.indices.size() << " indices from model file: " << path << std::endl;
 
         return builder;
     }
 
-    std::unique_ptr<VulkrModel> MeshLoader::loadObjModel(VulkrDevice &device, const std::string &path) {
-        VulkrModel::Builder builder = loadModel(path);
+    std::unique_ptr<VulkrModel> MeshLoader::loadObjModel(VulkrDevice &device, TextureManager &textureManager,
+                                                         const std::string &path) {
+        std::string diffuseTexture;
+        VulkrModel::Builder builder = loadModel(path, diffuseTexture);
 
         std::cout << "VulkrModel::createModelFromFile: Loading model from file: " << path << std::endl;
 
@@ -109,37 +134,294 @@ namespace vulkr {
                 << builder.vertices.size() << " vertices and "
                 << builder.indices.size() << " indices." << std::endl;
 
-        return std::make_unique<VulkrModel>(device, builder);
+        auto vulkrModel = std::make_unique<VulkrModel>(device, builder);
+        if (!diffuseTexture.empty()) {
+            vulkrModel->setMaterial(textureManager.createMaterial(textureManager.loadTexture({diffuseTexture}),
+                                                                  textureManager.getSampler({})));
+        }
+        return vulkrModel;
     }
 
-    std::unique_ptr<VulkrModel> MeshLoader::loadGltfModel(VulkrDevice &device, const std::string &path) {
-        VulkrModel::Builder builder{};
-        std::unordered_map<VulkrModel::Vertex, uint32_t> uniqueVertices{};
+    /**
+     * Writes count elements of an attribute into the interleaved attribute stream at destination, fallback
+     * when the primitive does not have it.
+     */
+    template<glm::length_t N>
+    void writeAttribute(const GltfAccessor &accessor, uint8_t *destination, size_t count,
+                        glm::vec<N, float> fallback) {
+        if (accessor.empty()) {
+            for (size_t i = 0; i < count; i++) {
+                std::memcpy(destination + i * sizeof(VulkrModel::VertexAttributes), &fallback, sizeof(fallback));
+            }
+            return;
+        }
+        accessor.copyTo<N>(destination, sizeof(VulkrModel::VertexAttributes), fallback);
+    }
+
+    /**
+     * Sets up builder's streams to copy the triangle primitives from their accessors straight into the model's
+     * staging memory. glTF vertices are already unique, so they are neither expanded per index nor hashed.
+     * Each primitive becomes a submesh with its material from materials, indexed like the file's; neighbours
+     * sharing a material are drawn as one.
+     */
+    void setPrimitiveStreams(const GltfDocument &document, const std::vector<const tinygltf::Primitive *> &primitives,
+                             const std::vector<std::shared_ptr<VulkrMaterial>> &materials,
+                             VulkrModel::Builder &builder) {
+        struct PrimitiveStreams {
+            GltfAccessor positions;
+            GltfAccessor normals;
+            GltfAccessor texcoords;
+            GltfAccessor colors;
+            GltfAccessor joints;
+            GltfAccessor weights;
+            GltfAccessor indices;
+        };
 
-        tinygltf::Model model;
-        tinygltf::TinyGLTF loader;
-        std::string err;
-        std::string warn;
+        std::vector<PrimitiveStreams> sources;
+        size_t vertexCount = 0;
+        size_t indexCount = 0;
+        glm::vec3 boundsMin{std::numeric_limits<float>::max()};
+        glm::vec3 boundsMax{std::numeric_limits<float>::lowest()};
+
+        for (const tinygltf::Primitive *primitive: primitives) {
+            if (primitive->mode != TINYGLTF_MODE_TRIANGLES) {
+                continue;
+            }
+
+            PrimitiveStreams source{
+                GltfAccessor::attribute(document, *primitive, "POSITION"),
+                GltfAccessor::attribute(document, *primitive, "NORMAL"),
+                GltfAccessor::attribute(document, *primitive, "TEXCOORD_0"),
+                GltfAccessor::attribute(document, *primitive, "COLOR_0"),
+                GltfAccessor::attribute(document, *primitive, "JOINTS_0"),
+                GltfAccessor::attribute(document, *primitive, "WEIGHTS_0"),
+                primitive->indices > -1 ? GltfAccessor{document, primitive->indices} : GltfAccessor{}
+            };
+            const size_t count = source.positions.getCount();
+            if (count == 0) {
+                continue;
+            }
+            for (const GltfAccessor *attribute: {&source.normals, &source.texcoords, &source.colors, &source.joints,
+                                                 &source.weights}) {
+                if (!attribute->empty() && attribute->getCount() != count) {
+                    throw std::runtime_error("failed to load glTF primitive, attribute counts differ!");
+                }
+            }
+            // skinning needs both, a primitive with only one of them is drawn unskinned
+            if (source.joints.empty() || source.weights.empty()) {
+                source.joints = source.weights = GltfAccessor{};
+            }
+
+            glm::vec3 min, max;
+            source.positions.getBounds(min, max);
+            boundsMin = glm::min(boundsMin, min);
+            boundsMax = glm::max(boundsMax, max);
+
+            const size_t primitiveIndexCount = source.indices.empty() ? count : source.indices.getCount();
+            const std::shared_ptr<VulkrMaterial> material =
+                    primitive->material > -1 && primitive->material < static_cast<int>(materials.size())
+                        ? materials[primitive->material]
+                        : nullptr;
+            if (!builder.submeshes.empty() && builder.submeshes.back().material == material) {
+                builder.submeshes.back().indexCount += static_cast<uint32_t>(primitiveIndexCount);
+            } else {
+                builder.submeshes.push_back({
+                    static_cast<uint32_t>(indexCount), static_cast<uint32_t>(primitiveIndexCount), material
+                });
+            }
+
+            vertexCount += count;
+            indexCount += primitiveIndexCount;
+            sources.push_back(std::move(source));
+        }
+
+        if (vertexCount > std::numeric_limits<uint32_t>::max() || indexCount > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("failed to load glTF mesh, too many vertices!");
+        }
+
+        builder.streams.vertexCount = static_cast<uint32_t>(vertexCount);
+        builder.streams.indexCount = static_cast<uint32_t>(indexCount);
+        builder.streams.boundsMin = boundsMin;
+        builder.streams.boundsMax = boundsMax;
+        builder.streams.write = [sources = std::move(sources)](glm::vec3 *positions,
+                                                               VulkrModel::VertexAttributes *attributes,
+                                                               uint32_t *indices) {
+            uint32_t baseVertex = 0;
+            for (const auto &source: sources) {
+                const size_t count = source.positions.getCount();
+                source.positions.copyTo<3>(positions + baseVertex, sizeof(glm::vec3));
+
+                // the attributes are interleaved, each one is a strided copy into its field
+                auto *destination = reinterpret_cast<uint8_t *>(attributes + baseVertex);
+                using Attributes = VulkrModel::VertexAttributes;
+                writeAttribute<3>(source.colors, destination + offsetof(Attributes, color), count, glm::vec3(1.0f));
+                writeAttribute<3>(source.normals, destination + offsetof(Attributes, normal), count, glm::vec3(0.0f));
+                writeAttribute<2>(source.texcoords, destination + offsetof(Attributes, uv), count, glm::vec2(0.0f));
+                writeAttribute<4>(source.joints, destination + offsetof(Attributes, jointIndices), count,
+                                  glm::vec4(0.0f));
+                writeAttribute<4>(source.weights, destination + offsetof(Attributes, jointWeights), count,
+                                  glm::vec4(0.0f));
+
+                // primitives are concatenated, so their indices are rebased onto the primitive's first vertex
+                if (source.indices.empty()) {
+                    for (size_t i = 0; i < count; i++) {
+                        *indices++ = baseVertex + static_cast<uint32_t>(i);
+                    }
+                } else if (baseVertex == 0 && source.indices.isPacked(TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT)) {
+                    source.indices.copyPacked(indices);
+                    indices += source.indices.getCount();
+                } else {
+                    for (size_t i = 0; i < source.indices.getCount(); i++) {
+                        *indices++ = baseVertex + source.indices.readUint(i, 0);
+                    }
+                }
+                baseVertex += static_cast<uint32_t>(count);
+            }
+        };
+    }
 
-        stbi_set_flip_vertically_on_load(false); // glTF UVs are top-left origin
+    /**
+     * Local transform of a node, its matrix or translation * rotation * scale.
+     */
+    glm::mat4 nodeMatrix(const tinygltf::Node &node) {
+        if (node.matrix.size() == 16) {
+            return glm::mat4(glm::make_mat4(node.matrix.data()));
+        }
 
-        bool res;
-        if (path.substr(path.find_last_of('.') + 1) == "glb") {
-            res = loader.LoadBinaryFromFile(&model, &err, &warn, path);
-        } else {
-            res = loader.LoadASCIIFromFile(&model, &err, &warn, path);
+        glm::mat4 matrix{1.0f};
+        if (node.translation.size() == 3) {
+            matrix = glm::translate(matrix, glm::vec3(glm::make_vec3(node.translation.data())));
+        }
+        if (node.rotation.size() == 4) {
+            glm::quat q(static_cast<float>(node.rotation[3]), static_cast<float>(node.rotation[0]),
+                        static_cast<float>(node.rotation[1]), static_cast<float>(node.rotation[2]));
+            matrix *= glm::mat4_cast(q);
+        }
+        if (node.scale.size() == 3) {
+            matrix = glm::scale(matrix, glm::vec3(glm::make_vec3(node.scale.data())));
         }
+        return matrix;
+    }
 
-        if (!res) {
-            throw std::runtime_error("Failed to load glTF model: " + path + "\n" + err + warn);
+    /**
+     * Vulkan sampler settings of a glTF sampler, the glTF defaults are linear, trilinear and repeat.
+     */
+    SamplerSettings gltfSamplerSettings(const tinygltf::Sampler &sampler) {
+        const auto addressMode = [](int wrap) {
+            switch (wrap) {
+                case TINYGLTF_TEXTURE_WRAP_CLAMP_TO_EDGE: return VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+                case TINYGLTF_TEXTURE_WRAP_MIRRORED_REPEAT: return VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+                default: return VK_SAMPLER_ADDRESS_MODE_REPEAT;
+            }
+        };
+
+        SamplerSettings settings{};
+        settings.magFilter = sampler.magFilter == TINYGLTF_TEXTURE_FILTER_NEAREST ? VK_FILTER_NEAREST
+                                                                                  : VK_FILTER_LINEAR;
+        switch (sampler.minFilter) {
+            case TINYGLTF_TEXTURE_FILTER_NEAREST:
+            case TINYGLTF_TEXTURE_FILTER_LINEAR:
+                settings.minFilter = sampler.minFilter == TINYGLTF_TEXTURE_FILTER_NEAREST ? VK_FILTER_NEAREST
+                                                                                        : VK_FILTER_LINEAR;
+                settings.mipmaps = false;
+                break;
+            case TINYGLTF_TEXTURE_FILTER_NEAREST_MIPMAP_NEAREST:
+                settings.minFilter = VK_FILTER_NEAREST;
+                settings.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+                break;
+            case TINYGLTF_TEXTURE_FILTER_LINEAR_MIPMAP_NEAREST:
+                settings.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+                break;
+            case TINYGLTF_TEXTURE_FILTER_NEAREST_MIPMAP_LINEAR:
+                settings.minFilter = VK_FILTER_NEAREST;
+                break;
+            default:
+                break;
         }
+        settings.addressModeU = addressMode(sampler.wrapS);
+        settings.addressModeV = addressMode(sampler.wrapT);
+        return settings;
+    }
 
-        if (!warn.empty()) {
-            std::cout << "glTF Loader Warning: " << warn << std::endl;
+    /**
+     * A material per glTF material, indexed like the file's, for the base color textures of the materials
+     * primitives use. All their images are decoded in one batch. Materials without a texture stay null.
+     */
+    std::vector<std::shared_ptr<VulkrMaterial>> loadGltfMaterials(
+        TextureManager &textureManager, const GltfDocument &document, const std::string &path,
+        const std::vector<const tinygltf::Primitive *> &primitives) {
+        const tinygltf::Model &model = document.model;
+        std::vector<std::shared_ptr<VulkrMaterial>> materials(model.materials.size());
+
+        // the texture of every used material, -1 if it has none
+        std::vector<int> materialTextures(model.materials.size(), -1);
+        std::vector<int> imageSources(model.images.size(), -1);
+        std::vector<TextureSource> sources;
+        std::vector<std::vector<unsigned char>> dataUris;
+        const std::filesystem::path directory = std::filesystem::path(path).parent_path();
+
+        for (const tinygltf::Primitive *primitive: primitives) {
+            const int m = primitive->material;
+            if (m < 0 || m >= static_cast<int>(model.materials.size()) || materialTextures[m] > -1) continue;
+            const int t = model.materials[m].pbrMetallicRoughness.baseColorTexture.index;
+            if (t < 0 || t >= static_cast<int>(model.textures.size())) continue;
+            // textures in other formats, e.g. KHR_texture_basisu, only name their image in an extension
+            const int i = model.textures[t].source;
+            if (i < 0 || i >= static_cast<int>(model.images.size())) continue;
+            materialTextures[m] = t;
+            if (imageSources[i] > -1) continue;
+
+            const tinygltf::Image &image = model.images[i];
+            TextureSource source{path + "#image" + std::to_string(i)};
+            if (image.bufferView > -1) {
+                if (image.bufferView >= static_cast<int>(model.bufferViews.size())) {
+                    throw std::runtime_error("failed to load glTF image, buffer view out of range!");
+                }
+                const tinygltf::BufferView &view = model.bufferViews[image.bufferView];
+                if (view.buffer < 0 || view.buffer >= static_cast<int>(document.buffers.size()) ||
+                    view.byteOffset + view.byteLength > document.buffers[view.buffer].size()) {
+                    throw std::runtime_error("failed to load glTF image, buffer view exceeds its buffer!");
+                }
+                source.encoded = document.buffers[view.buffer].subspan(view.byteOffset, view.byteLength);
+            } else if (tinygltf::IsDataURI(image.uri)) {
+                // moving the decoded vectors as dataUris grows keeps their storage, so the span stays valid
+                std::string mimeType;
+                if (!tinygltf::DecodeDataURI(&dataUris.emplace_back(), mimeType, image.uri, 0, false)) {
+                    throw std::runtime_error("failed to load glTF image, invalid data uri!");
+                }
+                source.encoded = dataUris.back();
+            } else {
+                // external images are shared with every other model that references the file
+                std::string decodedUri;
+                tinygltf::URIDecode(image.uri, &decodedUri, nullptr);
+                source.key = (directory / decodedUri).lexically_normal().string();
+            }
+            imageSources[i] = static_cast<int>(sources.size());
+            sources.push_back(std::move(source));
         }
-        if (!err.empty()) {
-            std::cerr << "glTF Loader Error: " << err << std::endl;
+
+        const std::vector<std::shared_ptr<VulkrTexture>> textures = textureManager.loadTextures(sources);
+        for (size_t m = 0; m < materials.size(); m++) {
+            const int t = materialTextures[m];
+            if (t < 0) continue;
+            const tinygltf::Texture &texture = model.textures[t];
+            const bool hasSampler = texture.sampler > -1 && texture.sampler < static_cast<int>(model.samplers.size());
+            const SamplerSettings settings = hasSampler ? gltfSamplerSettings(model.samplers[texture.sampler])
+                                                        : SamplerSettings{};
+            materials[m] = textureManager.createMaterial(textures[imageSources[texture.source]],
+                                                         textureManager.getSampler(settings));
         }
+        return materials;
+    }
+
+    std::unique_ptr<VulkrModel> MeshLoader::loadGltfModel(VulkrDevice &device, TextureManager &textureManager,
+                                                          const std::string &path) {
+        VulkrModel::Builder builder{};
+        std::vector<const tinygltf::Primitive *> primitives;
+
+        GltfDocument document;
+        loadGltfDocument(path, document);
+        const tinygltf::Model &model = document.model;
 
         // print all bones and their parents
         std::cout << "VulkrModel::Builder::loadGltfModel: Loading model from file: " << path << std::endl;
@@ -161,146 +443,7 @@ namespace vulkr {
             if (node.mesh > -1) {
                 const tinygltf::Mesh &mesh = model.meshes[node.mesh];
                 for (const auto &primitive: mesh.primitives) {
-                    if (primitive.mode != TINYGLTF_MODE_TRIANGLES) {
-                        continue;
-                    }
-
-                    const float *positions = nullptr;
-                    const float *normals = nullptr;
-                    const float *texcoords = nullptr;
-                    const float *colors = nullptr;
-                    const uint16_t *joints = nullptr;
-                    const float *weights = nullptr;
-                    size_t vertexCount = 0;
-
-                    if (primitive.attributes.find("POSITION") != primitive.attributes.end()) {
-                        const auto &accessor = model.accessors[primitive.attributes.at("POSITION")];
-                        const auto &bufferView = model.bufferViews[accessor.bufferView];
-                        positions = reinterpret_cast<const float *>(&(model.buffers[bufferView.buffer].data[
-                            bufferView.byteOffset + accessor.byteOffset]));
-                        vertexCount = accessor.count;
-                    } else {
-                        continue;
-                    }
-
-                    if (primitive.attributes.find("NORMAL") != primitive.attributes.end()) {
-                        const auto &accessor = model.accessors[primitive.attributes.at("NORMAL")];
-                        const auto &bufferView = model.bufferViews[accessor.bufferView];
-                        normals = reinterpret_cast<const float *>(&(model.buffers[bufferView.buffer].data[
-                            bufferView.byteOffset + accessor.byteOffset]));
-                    }
-
-                    if (primitive.attributes.find("TEXCOORD_0") != primitive.attributes.end()) {
-                        const auto &accessor = model.accessors[primitive.attributes.at("TEXCOORD_0")];
-                        const auto &bufferView = model.bufferViews[accessor.bufferView];
-                        texcoords = reinterpret_cast<const float *>(&(model.buffers[bufferView.buffer].data[
-                            bufferView.byteOffset + accessor.byteOffset]));
-                    }
-
-                    if (primitive.attributes.find("COLOR_0") != primitive.attributes.end()) {
-                        const auto &colorAccessor = model.accessors[primitive.attributes.at("COLOR_0")];
-                        const auto &colorBufferView = model.bufferViews[colorAccessor.bufferView];
-                        if (colorAccessor.type == TINYGLTF_TYPE_VEC3) {
-                            colors = reinterpret_cast<const float *>(&(model.buffers[colorBufferView.buffer].data[
-                                colorBufferView.byteOffset + colorAccessor.byteOffset]));
-                        }
-                    }
-
-                    if (primitive.attributes.find("JOINTS_0") != primitive.attributes.end()) {
-                        const auto &accessor = model.accessors[primitive.attributes.at("JOINTS_0")];
-                        const auto &bufferView = model.bufferViews[accessor.bufferView];
-                        joints = reinterpret_cast<const uint16_t *>(&(model.buffers[bufferView.buffer].data[
-                            bufferView.byteOffset + accessor.byteOffset]));
-                    }
-
-                    if (primitive.attributes.find("WEIGHTS_0") != primitive.attributes.end()) {
-                        const auto &accessor = model.accessors[primitive.attributes.at("WEIGHTS_0")];
-                        const auto &bufferView = model.bufferViews[accessor.bufferView];
-                        weights = reinterpret_cast<const float *>(&(model.buffers[bufferView.buffer].data[
-                            bufferView.byteOffset + accessor.byteOffset]));
-                    }
-
-                    if (primitive.indices > -1) {
-                        const auto &indexAccessor = model.accessors[primitive.indices];
-                        const auto &indexBufferView = model.bufferViews[indexAccessor.bufferView];
-                        const auto &indexBuffer = model.buffers[indexBufferView.buffer];
-                        const void *indexData = &(indexBuffer.data[
-                            indexBufferView.byteOffset + indexAccessor.byteOffset]);
-
-                        for (size_t i = 0; i < indexAccessor.count; ++i) {
-                            uint32_t index;
-                            switch (indexAccessor.componentType) {
-                                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
-                                    index = static_cast<const uint32_t *>(indexData)[i];
-                                    break;
-                                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
-                                    index = static_cast<const uint16_t *>(indexData)[i];
-                                    break;
-                                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
-                                    index = static_cast<const uint8_t *>(indexData)[i];
-                                    break;
-                                default:
-                                    continue;
-                            }
-
-                            VulkrModel::Vertex vertex{};
-                            vertex.position = glm::make_vec3(&positions[index * 3]);
-
-                            if (normals) {
-                                vertex.normal = glm::make_vec3(&normals[index * 3]);
-                            }
-
-                            if (texcoords) {
-                                vertex.uv = glm::make_vec2(&texcoords[index * 2]);
-                            }
-
-                            if (colors) {
-                                vertex.color = glm::make_vec3(&colors[index * 3]);
-                            } else {
-                                vertex.color = {1.0f, 1.0f, 1.0f};
-                            }
-
-                            if (joints && weights) {
-                                vertex.jointIndices = glm::vec4(joints[index * 4], joints[index * 4 + 1],
-                                                                joints[index * 4 + 2], joints[index * 4 + 3]);
-                                vertex.jointWeights = glm::make_vec4(&weights[index * 4]);
-                            }
-
-                            if (uniqueVertices.count(vertex) == 0) {
-                                uniqueVertices[vertex] = static_cast<uint32_t>(builder.vertices.size());
-                                builder.vertices.push_back(vertex);
-                            }
-                            builder.indices.push_back(uniqueVertices[vertex]);
-                        }
-                    } else {
-                        for (size_t i = 0; i < vertexCount; i++) {
-                            VulkrModel::Vertex vertex{};
-                            vertex.position = glm::make_vec3(&positions[i * 3]);
-
-                            if (normals) {
-                                vertex.normal = glm::make_vec3(&normals[i * 3]);
-                            }
-
-                            if (texcoords) {
-                                vertex.uv = glm::make_vec2(&texcoords[i * 2]);
-                            }
-
-                            if (colors) {
-                                vertex.color = glm::make_vec3(&colors[i * 3]);
-                            } else {
-                                vertex.color = {1.0f, 1.0f, 1.0f};
-                            }
-
-                            if (joints && weights) {
-                                vertex.jointIndices = glm::vec4(joints[i * 4], joints[i * 4 + 1], joints[i * 4 + 2],
-                                                                joints[i * 4 + 3]);
-                                vertex.jointWeights = glm::make_vec4(&weights[i * 4]);
-                            }
-
-                            builder.indices.push_back(static_cast<uint32_t>(builder.vertices.size()));
-                            builder.vertices.push_back(vertex);
-                        }
-                    }
+                    primitives.push_back(&primitive);
                 }
             }
             for (int childIndex: node.children) {
@@ -311,22 +454,32 @@ namespace vulkr {
         for (int nodeIndex: scene.nodes) {
             processNode(nodeIndex);
         }
+        setPrimitiveStreams(document, primitives, loadGltfMaterials(textureManager, document, path, primitives),
+                            builder);
+
+        // Flatten the node hierarchy parents first, poses, joints and channels all use the flattened index
+        std::vector<int32_t> nodeParents(model.nodes.size(), -1);
+        for (size_t i = 0; i < model.nodes.size(); i++) {
+            for (int child: model.nodes[i].children) {
+                nodeParents[child] = static_cast<int32_t>(i);
+            }
+        }
+        const std::vector<uint32_t> nodeSlots = Skeleton::sortNodes(nodeParents);
 
         // Load bone data
         if (!model.skins.empty()) {
             const tinygltf::Skin &skin = model.skins[0];
             builder.bones.resize(skin.joints.size());
-            std::vector<glm::mat4> inverseBindMatrices(skin.joints.size());
+            std::vector<glm::mat4> inverseBindMatrices(skin.joints.size(), glm::mat4(1.0f));
 
             // Load inverse bind matrices
             if (skin.inverseBindMatrices > -1) {
-                const auto &accessor = model.accessors[skin.inverseBindMatrices];
-                const auto &bufferView = model.bufferViews[accessor.bufferView];
-                const auto &buffer = model.buffers[bufferView.buffer];
-                const auto *data = reinterpret_cast<const float *>(&buffer.data[
-                    bufferView.byteOffset + accessor.byteOffset]);
-                for (size_t i = 0; i < accessor.count; ++i) {
-                    inverseBindMatrices[i] = glm::make_mat4(data + i * 16);
+                const GltfAccessor accessor{document, skin.inverseBindMatrices};
+                const size_t count = std::min(accessor.getCount(), inverseBindMatrices.size());
+                for (size_t i = 0; i < count; ++i) {
+                    for (int c = 0; c < 16; c++) {
+                        inverseBindMatrices[i][c / 4][c % 4] = accessor.readFloat(i, c);
+                    }
                 }
             }
 
@@ -334,30 +487,7 @@ namespace vulkr {
             for (size_t i = 0; i < skin.joints.size(); ++i) {
                 int jointIndex = skin.joints[i];
                 const tinygltf::Node &jointNode = model.nodes[jointIndex];
-                builder.bones[i].transform = glm::mat4(1.0f);
-
-                if (jointNode.matrix.size() == 16) {
-                    builder.bones[i].transform = glm::make_mat4(jointNode.matrix.data());
-                } else {
-                    if (jointNode.translation.size() == 3) {
-                        builder.bones[i].transform = glm::translate(builder.bones[i].transform,
-                                                                    glm::vec3(jointNode.translation[0],
-                                                                              jointNode.translation[1],
-                                                                              jointNode.translation[2]));
-                    }
-                    if (jointNode.rotation.size() == 4) {
-                        glm::quat q(static_cast<float>(jointNode.rotation[3]),
-                                    static_cast<float>(jointNode.rotation[0]),
-                                    static_cast<float>(jointNode.rotation[1]),
-                                    static_cast<float>(jointNode.rotation[2]));
-                        builder.bones[i].transform *= glm::mat4_cast(q);
-                    }
-                    if (jointNode.scale.size() == 3) {
-                        builder.bones[i].transform = glm::scale(builder.bones[i].transform,
-                                                                glm::vec3(jointNode.scale[0], jointNode.scale[1],
-                                                                          jointNode.scale[2]));
-                    }
-                }
+                builder.bones[i].transform = nodeMatrix(jointNode);
 
                 builder.bones[i].transform = builder.bones[i].transform * inverseBindMatrices[i];
 
@@ -365,17 +495,35 @@ namespace vulkr {
             }
 
             // Find parent for each bone
+            std::unordered_map<int, int32_t> jointOfNode;
+            jointOfNode.reserve(skin.joints.size());
             for (size_t i = 0; i < skin.joints.size(); i++) {
-                int joint_node_index = skin.joints[i];
-                const auto &joint_node = model.nodes[joint_node_index];
-                for (int child_node_index: joint_node.children) {
-                    auto it = std::find(skin.joints.begin(), skin.joints.end(), child_node_index);
-                    if (it != skin.joints.end()) {
-                        int child_joint_index = std::distance(skin.joints.begin(), it);
-                        builder.bones[child_joint_index].parent = i;
-                    }
+                jointOfNode.emplace(skin.joints[i], static_cast<int32_t>(i));
+            }
+            for (size_t i = 0; i < skin.joints.size(); i++) {
+                const int32_t parentNode = nodeParents[skin.joints[i]];
+                if (parentNode < 0) continue;
+                auto it = jointOfNode.find(parentNode);
+                if (it != jointOfNode.end()) {
+                    builder.bones[i].parent = it->second;
+                }
+            }
+
+            // Skinning data, the palette is rebuilt from the animated pose every frame
+            builder.skeleton.parents.assign(model.nodes.size(), -1);
+            for (size_t i = 0; i < model.nodes.size(); i++) {
+                const int32_t parent = nodeParents[i];
+                // a parent can only come later in a broken (cyclic) hierarchy, which is cut there
+                if (parent >= 0 && nodeSlots[parent] < nodeSlots[i]) {
+                    builder.skeleton.parents[nodeSlots[i]] = static_cast<int32_t>(nodeSlots[parent]);
                 }
             }
+            builder.skeleton.computeDepthEnds();
+            builder.skeleton.jointNodes.reserve(skin.joints.size());
+            for (int joint: skin.joints) {
+                builder.skeleton.jointNodes.push_back(nodeSlots[joint]);
+            }
+            builder.skeleton.inverseBindMatrices = inverseBindMatrices;
 
             // Create bone indices for rendering
             for (size_t i = 0; i < builder.bones.size(); ++i) {
@@ -386,6 +534,32 @@ namespace vulkr {
             }
         }
 
+        // Rest pose of every node, the animations only override the channels they target
+        builder.restPose.resize(model.nodes.size());
+        for (size_t n = 0; n < model.nodes.size(); n++) {
+            const tinygltf::Node &node = model.nodes[n];
+            const uint32_t i = nodeSlots[n];
+            if (node.matrix.size() == 16) {
+                glm::vec3 skew;
+                glm::vec4 perspective;
+                glm::decompose(glm::mat4(glm::make_mat4(node.matrix.data())), builder.restPose.scales[i],
+                               builder.restPose.rotations[i], builder.restPose.translations[i], skew, perspective);
+                continue;
+            }
+            if (node.translation.size() == 3) {
+                builder.restPose.translations[i] = glm::make_vec3(node.translation.data());
+            }
+            if (node.rotation.size() == 4) {
+                builder.restPose.rotations[i] = glm::quat(static_cast<float>(node.rotation[3]),
+                                                          static_cast<float>(node.rotation[0]),
+                                                          static_cast<float>(node.rotation[1]),
+                                                          static_cast<float>(node.rotation[2]));
+            }
+            if (node.scale.size() == 3) {
+                builder.restPose.scales[i] = glm::make_vec3(node.scale.data());
+            }
+        }
+
         // Load animations
         for (const auto &anim: model.animations) {
             VulkrModel::Builder::Animation animation{};
@@ -393,35 +567,31 @@ namespace vulkr {
 
             for (const auto &sampler: anim.samplers) {
                 VulkrModel::Builder::AnimationSampler animationSampler{};
-                animationSampler.interpolation = sampler.interpolation;
+                if (sampler.interpolation == "STEP") {
+                    animationSampler.interpolation = AnimationInterpolation::Step;
+                } else if (sampler.interpolation == "CUBICSPLINE") {
+                    animationSampler.interpolation = AnimationInterpolation::CubicSpline;
+                }
 
                 // Read sampler input time values
                 {
-                    const auto &accessor = model.accessors[sampler.input];
-                    const auto &bufferView = model.bufferViews[accessor.bufferView];
-                    const auto &buffer = model.buffers[bufferView.buffer];
-                    const auto *data = reinterpret_cast<const float *>(&buffer.data[
-                        bufferView.byteOffset + accessor.byteOffset]);
-                    animationSampler.inputs.assign(data, data + accessor.count);
+                    const GltfAccessor accessor{document, sampler.input};
+                    animationSampler.inputs.resize(accessor.getCount());
+                    accessor.copyTo<1>(animationSampler.inputs.data(), sizeof(float));
                 }
 
-                // Read sampler output values
+                // Read sampler output values, quantized rotations are normalized integers
                 {
-                    const auto &accessor = model.accessors[sampler.output];
-                    const auto &bufferView = model.bufferViews[accessor.bufferView];
-                    const auto &buffer = model.buffers[bufferView.buffer];
-                    const auto *data = reinterpret_cast<const float *>(&buffer.data[
-                        bufferView.byteOffset + accessor.byteOffset]);
-
-                    switch (accessor.type) {
-                        case TINYGLTF_TYPE_VEC3:
-                            for (size_t i = 0; i < accessor.count; ++i) {
-                                animationSampler.outputs.emplace_back(glm::make_vec3(data + i * 3), 0.0f);
+                    const GltfAccessor accessor{document, sampler.output};
+                    switch (accessor.getComponentCount()) {
+                        case 3:
+                            for (size_t i = 0; i < accessor.getCount(); ++i) {
+                                animationSampler.outputs.emplace_back(accessor.read<3>(i), 0.0f);
                             }
                             break;
-                        case TINYGLTF_TYPE_VEC4:
-                            for (size_t i = 0; i < accessor.count; ++i) {
-                                animationSampler.outputs.emplace_back(glm::make_vec4(data + i * 4));
+                        case 4:
+                            for (size_t i = 0; i < accessor.getCount(); ++i) {
+                                animationSampler.outputs.emplace_back(accessor.read<4>(i));
                             }
                             break;
                         default:
@@ -432,20 +602,121 @@ namespace vulkr {
             }
 
             for (const auto &channel: anim.channels) {
+                if (channel.target_node < 0) {
+                    continue;
+                }
+
                 VulkrModel::Builder::AnimationChannel animationChannel{};
-                animationChannel.path = channel.target_path;
+                if (channel.target_path == "translation") {
+                    animationChannel.path = AnimationPath::Translation;
+                } else if (channel.target_path == "rotation") {
+                    animationChannel.path = AnimationPath::Rotation;
+                } else if (channel.target_path == "scale") {
+                    animationChannel.path = AnimationPath::Scale;
+                } else if (channel.target_path == "weights") {
+                    animationChannel.path = AnimationPath::Weights;
+                } else {
+                    continue;
+                }
                 animationChannel.samplerIndex = channel.sampler;
-                animationChannel.nodeIndex = channel.target_node;
+                animationChannel.nodeIndex = static_cast<int>(nodeSlots[channel.target_node]);
                 animation.channels.push_back(animationChannel);
             }
 
             builder.animations.push_back(animation);
         }
 
-        std::cout << "VulkrModel::Builder::loadGltfModel: Loaded " << builder.vertices.size() << " unique vertices and "
-                << builder.indices.size() << " indices from model file: " << path << std::endl;
+        std::cout << "VulkrModel::Builder::loadGltfModel: Loaded " << builder.streams.vertexCount << " vertices and "
+                << builder.streams.indexCount << " indices from model file: " << path << std::endl;
 
         return std::make_unique<VulkrModel>(device, builder);
     }
-}
 
+    MeshLoader::GltfScene MeshLoader::loadGltfScene(VulkrDevice &device, TextureManager &textureManager,
+                                                    const std::string &path) {
+        GltfDocument document;
+        loadGltfDocument(path, document);
+        const tinygltf::Model &model = document.model;
+
+        GltfScene gltfScene{};
+        if (model.scenes.empty()) {
+            return gltfScene;
+        }
+        const tinygltf::Scene &scene = model.scenes[model.defaultScene > -1 ? model.defaultScene : 0];
+
+        // world transform of every node referencing each mesh, a node has at most one parent so each is visited once
+        std::vector<std::vector<glm::mat4>> meshTransforms(model.meshes.size());
+        std::vector<bool> visited(model.nodes.size(), false);
+        std::vector<std::pair<int, glm::mat4>> stack;
+        for (auto it = scene.nodes.rbegin(); it != scene.nodes.rend(); ++it) {
+            stack.emplace_back(*it, glm::mat4(1.0f));
+        }
+
+        while (!stack.empty()) {
+            const auto [nodeIndex, parentMatrix] = stack.back();
+            stack.pop_back();
+            if (nodeIndex < 0 || nodeIndex >= static_cast<int>(model.nodes.size()) || visited[nodeIndex]) continue;
+            visited[nodeIndex] = true;
+
+            const tinygltf::Node &node = model.nodes[nodeIndex];
+            const glm::mat4 matrix = parentMatrix * nodeMatrix(node);
+            if (node.mesh > -1) {
+                meshTransforms[node.mesh].push_back(matrix);
+            }
+            for (auto it = node.children.rbegin(); it != node.children.rend(); ++it) {
+                stack.emplace_back(*it, matrix);
+            }
+        }
+
+        // the textures of all referenced meshes are decoded together
+        std::vector<std::vector<const tinygltf::Primitive *>> meshPrimitives(model.meshes.size());
+        std::vector<const tinygltf::Primitive *> scenePrimitives;
+        for (size_t m = 0; m < model.meshes.size(); m++) {
+            if (meshTransforms[m].empty()) continue;
+            for (const auto &primitive: model.meshes[m].primitives) {
+                meshPrimitives[m].push_back(&primitive);
+                scenePrimitives.push_back(&primitive);
+            }
+        }
+        const auto materials = loadGltfMaterials(textureManager, document, path, scenePrimitives);
+
+        // every referenced mesh is uploaded once, its instances are kept together so it can be drawn in one call
+        size_t vertexCount = 0;
+        gltfScene.meshes.resize(model.meshes.size());
+        for (size_t m = 0; m < model.meshes.size(); m++) {
+            if (meshTransforms[m].empty()) continue;
+
+            VulkrModel::Builder builder{};
+            setPrimitiveStreams(document, meshPrimitives[m], materials, builder);
+            if (builder.streams.vertexCount == 0) continue;
+            vertexCount += builder.streams.vertexCount;
+
+            GltfScene::Mesh &mesh = gltfScene.meshes[m];
+            mesh.model = std::make_shared<VulkrModel>(device, builder);
+            mesh.name = model.meshes[m].name;
+            mesh.firstInstance = static_cast<uint32_t>(gltfScene.instances.size());
+            mesh.instanceCount = static_cast<uint32_t>(meshTransforms[m].size());
+            for (const glm::mat4 &transform: meshTransforms[m]) {
+                gltfScene.instances.push_back({static_cast<uint32_t>(m), transform});
+            }
+        }
+
+        std::cout << "MeshLoader::loadGltfScene: Loaded " << vertexCount << " vertices drawn as "
+                << gltfScene.instances.size() << " instances from scene file: " << path << std::endl;
+
+        return gltfScene;
+    }
+
+    std::vector<GameObject> MeshLoader::GltfScene::createGameObjects(const glm::mat4 &root) const {
+        std::vector<GameObject> gameObjects;
+        gameObjects.reserve(instances.size());
+        for (const Instance &instance: instances) {
+            auto obj = GameObject::createGameObject();
+            obj.model = meshes[instance.mesh].model;
+            obj.transform = TransformComponent::fromMatrix(root * instance.transform);
+            obj.isStatic = true;
+            gameObjects.push_back(std::move(obj));
+        }
+        return gameObjects;
+    }
+}
\ No newline at end of file
@@ -5,13 +5,57 @@
 #ifndef MESHLOADER_H
 #define MESHLOADER_H
 
+#include "../game/game_object.h"
 #include "../model/vulkr_model.h"
+#include "../texture/texture_manager.h"
 #include <memory>
+#include <vector>
 
 namespace vulkr {
     namespace MeshLoader {
-        std::unique_ptr<VulkrModel> loadObjModel(VulkrDevice& device, const std::string& path);
-        std::unique_ptr<VulkrModel> loadGltfModel(VulkrDevice& device, const std::string& path);
+        /**
+         * Models are drawn with the base color texture of their first textured face or primitive, decoded
+         * and cached by textureManager.
+         */
+        std::unique_ptr<VulkrModel> loadObjModel(VulkrDevice& device, TextureManager& textureManager,
+                                                 const std::string& path);
+        std::unique_ptr<VulkrModel> loadGltfModel(VulkrDevice& device, TextureManager& textureManager,
+                                                  const std::string& path);
+
+        /**
+         * A glTF scene with every mesh uploaded once and each node that references it kept as an instance
+         * with its accumulated world transform. Instances are grouped by mesh, so a mesh's instances are
+         * contiguous and can be drawn with one instanced call.
+         */
+        struct GltfScene {
+            struct Mesh {
+                std::string name;
+                // null for meshes no node references or without triangles
+                std::shared_ptr<VulkrModel> model;
+                uint32_t firstInstance{0};
+                uint32_t instanceCount{0};
+            };
+
+            struct Instance {
+                uint32_t mesh;
+                glm::mat4 transform;
+            };
+
+            // indexed like the file's meshes
+            std::vector<Mesh> meshes;
+            std::vector<Instance> instances;
+
+            /**
+             * One static game object per instance, all instances of a mesh share its model.
+             */
+            std::vector<GameObject> createGameObjects(const glm::mat4 &root = glm::mat4(1.0f)) const;
+        };
+
+        /**
+         * Loads the default scene for static, instanced geometry. Skins and animations are ignored,
+         * use loadGltfModel for animated models.
+         */
+        GltfScene loadGltfScene(VulkrDevice& device, TextureManager& textureManager, const std::string& path);
     };
 }
 
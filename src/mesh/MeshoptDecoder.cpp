@@ -0,0 +1,500 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "MeshoptDecoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../utils/parallel_for.h"
+
+namespace vulkr {
+    namespace {
+        constexpr size_t BYTE_GROUP_SIZE = 16;
+        constexpr size_t VERTEX_BLOCK_SIZE_BYTES = 8192;
+        constexpr size_t VERTEX_BLOCK_MAX_SIZE = 256;
+        constexpr size_t VERTEX_MAX_STRIDE = 256;
+        constexpr size_t VERTEX_TAIL_SIZE = 32;
+        constexpr size_t INDEX_TAIL_SIZE = 16;
+        constexpr size_t SEQUENCE_TAIL_SIZE = 4;
+
+        constexpr uint8_t VERTEX_HEADER = 0xa0;
+        constexpr uint8_t INDEX_HEADER = 0xe0;
+        constexpr uint8_t SEQUENCE_HEADER = 0xd0;
+
+        [[noreturn]] void fail(const std::string &what) {
+            throw std::runtime_error("failed to decode meshopt " + what + "!");
+        }
+
+        uint8_t unzigzag8(uint8_t value) {
+            return static_cast<uint8_t>(-(value & 1) ^ (value >> 1));
+        }
+
+        /**
+         * One group of 16 bytes packed at 0, 2, 4 or 8 bits, the all ones value of 2 and 4 bit groups escapes
+         * to a full byte stored after the packed bits.
+         */
+        const uint8_t *decodeBytesGroup(const uint8_t *data, const uint8_t *end, uint8_t *buffer, int bitsLog2) {
+            switch (bitsLog2) {
+                case 0:
+                    std::memset(buffer, 0, BYTE_GROUP_SIZE);
+                    return data;
+                case 3:
+                    if (static_cast<size_t>(end - data) < BYTE_GROUP_SIZE) fail("vertex stream, truncated group");
+                    std::memcpy(buffer, data, BYTE_GROUP_SIZE);
+                    return data + BYTE_GROUP_SIZE;
+                default: {
+                    const int bits = 1 << bitsLog2;
+                    const size_t packedSize = BYTE_GROUP_SIZE * bits / 8;
+                    if (static_cast<size_t>(end - data) < packedSize) fail("vertex stream, truncated group");
+
+                    const uint8_t escape = static_cast<uint8_t>((1 << bits) - 1);
+                    const uint8_t *escaped = data + packedSize;
+                    for (size_t i = 0; i < BYTE_GROUP_SIZE; i++) {
+                        // most significant bits first
+                        const int shift = 8 - bits - static_cast<int>(i * bits % 8);
+                        uint8_t value = (data[i * bits / 8] >> shift) & escape;
+                        if (value == escape) {
+                            if (escaped >= end) fail("vertex stream, truncated group");
+                            value = *escaped++;
+                        }
+                        buffer[i] = value;
+                    }
+                    return escaped;
+                }
+            }
+        }
+
+        const uint8_t *decodeBytes(const uint8_t *data, const uint8_t *end, uint8_t *buffer, size_t size) {
+            // two header bits per group, four groups per byte, lowest bits first
+            const size_t headerSize = (size / BYTE_GROUP_SIZE + 3) / 4;
+            if (static_cast<size_t>(end - data) < headerSize) fail("vertex stream, truncated header");
+            const uint8_t *header = data;
+            data += headerSize;
+
+            for (size_t i = 0; i < size; i += BYTE_GROUP_SIZE) {
+                const size_t group = i / BYTE_GROUP_SIZE;
+                const int bitsLog2 = (header[group / 4] >> ((group % 4) * 2)) & 3;
+                data = decodeBytesGroup(data, end, buffer + i, bitsLog2);
+            }
+            return data;
+        }
+
+        /**
+         * Each byte of the vertex is a plane of zigzag deltas against the same byte of the previous vertex.
+         */
+        const uint8_t *decodeVertexBlock(const uint8_t *data, const uint8_t *end, uint8_t *destination, size_t count,
+                                         size_t byteStride, uint8_t *lastVertex) {
+            uint8_t buffer[VERTEX_BLOCK_MAX_SIZE];
+            const size_t alignedCount = (count + BYTE_GROUP_SIZE - 1) & ~(BYTE_GROUP_SIZE - 1);
+
+            for (size_t k = 0; k < byteStride; k++) {
+                data = decodeBytes(data, end, buffer, alignedCount);
+
+                uint8_t previous = lastVertex[k];
+                for (size_t i = 0; i < count; i++) {
+                    previous = static_cast<uint8_t>(unzigzag8(buffer[i]) + previous);
+                    destination[i * byteStride + k] = previous;
+                }
+            }
+
+            std::memcpy(lastVertex, destination + (count - 1) * byteStride, byteStride);
+            return data;
+        }
+
+        uint32_t decodeVByte(const uint8_t *&data) {
+            const uint8_t lead = *data++;
+            if (lead < 128) return lead;
+
+            uint32_t result = lead & 127;
+            int shift = 7;
+            for (int i = 0; i < 4; i++) {
+                const uint8_t group = *data++;
+                result |= static_cast<uint32_t>(group & 127) << shift;
+                shift += 7;
+                if (group < 128) break;
+            }
+            return result;
+        }
+
+        uint32_t decodeIndex(const uint8_t *&data, uint32_t last) {
+            const uint32_t value = decodeVByte(data);
+            const uint32_t delta = (value >> 1) ^ -static_cast<int32_t>(value & 1);
+            return last + delta;
+        }
+
+        void writeIndex(uint8_t *destination, size_t i, size_t indexSize, uint32_t index) {
+            if (indexSize == 2) {
+                const auto value = static_cast<uint16_t>(index);
+                std::memcpy(destination + i * 2, &value, sizeof(value));
+            } else {
+                std::memcpy(destination + i * 4, &index, sizeof(index));
+            }
+        }
+
+        void pushEdge(uint32_t (&fifo)[16][2], size_t &offset, uint32_t a, uint32_t b) {
+            fifo[offset][0] = a;
+            fifo[offset][1] = b;
+            offset = (offset + 1) & 15;
+        }
+
+        void pushVertex(uint32_t (&fifo)[16], size_t &offset, uint32_t v, bool advance = true) {
+            fifo[offset] = v;
+            offset = (offset + (advance ? 1 : 0)) & 15;
+        }
+
+        template<typename T>
+        void decodeOctahedral(uint8_t *data, size_t count) {
+            const float max = static_cast<float>((1 << (sizeof(T) * 8 - 1)) - 1);
+            for (size_t i = 0; i < count; i++) {
+                T v[4];
+                std::memcpy(v, data + i * sizeof(v), sizeof(v));
+
+                // z is stored as the 1.0 reference minus the octahedral coordinates, it folds over for z < 0
+                float x = static_cast<float>(v[0]);
+                float y = static_cast<float>(v[1]);
+                const float z = static_cast<float>(v[2]) - std::fabs(x) - std::fabs(y);
+                const float t = z >= 0.0f ? 0.0f : z;
+                x += x >= 0.0f ? t : -t;
+                y += y >= 0.0f ? t : -t;
+
+                const float scale = max / std::sqrt(x * x + y * y + z * z);
+                v[0] = static_cast<T>(static_cast<int>(x * scale + (x >= 0.0f ? 0.5f : -0.5f)));
+                v[1] = static_cast<T>(static_cast<int>(y * scale + (y >= 0.0f ? 0.5f : -0.5f)));
+                v[2] = static_cast<T>(static_cast<int>(z * scale + (z >= 0.0f ? 0.5f : -0.5f)));
+                std::memcpy(data + i * sizeof(v), v, sizeof(v));
+            }
+        }
+
+        void decodeQuaternion(uint8_t *data, size_t count) {
+            const float scale = 1.0f / std::sqrt(2.0f);
+            for (size_t i = 0; i < count; i++) {
+                int16_t v[4];
+                std::memcpy(v, data + i * sizeof(v), sizeof(v));
+
+                // the last component holds the scale in its high bits and the dropped component's index in the low two
+                const float componentScale = scale / static_cast<float>(v[3] | 3);
+                const float x = static_cast<float>(v[0]) * componentScale;
+                const float y = static_cast<float>(v[1]) * componentScale;
+                const float z = static_cast<float>(v[2]) * componentScale;
+                const float ww = 1.0f - x * x - y * y - z * z;
+                const float w = std::sqrt(ww >= 0.0f ? ww : 0.0f);
+
+                const auto round = [](float f) {
+                    return static_cast<int16_t>(static_cast<int>(f * 32767.0f + (f >= 0.0f ? 0.5f : -0.5f)));
+                };
+                const int dropped = v[3] & 3;
+                int16_t result[4];
+                result[(dropped + 1) & 3] = round(x);
+                result[(dropped + 2) & 3] = round(y);
+                result[(dropped + 3) & 3] = round(z);
+                result[dropped] = round(w);
+                std::memcpy(data + i * sizeof(result), result, sizeof(result));
+            }
+        }
+
+        void decodeExponential(uint8_t *data, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                uint32_t v;
+                std::memcpy(&v, data + i * sizeof(v), sizeof(v));
+
+                // 24 bit signed mantissa, 8 bit signed exponent
+                const int32_t mantissa = static_cast<int32_t>(v << 8) >> 8;
+                const int32_t exponent = static_cast<int32_t>(v) >> 24;
+                const float value = std::ldexp(static_cast<float>(mantissa), exponent);
+                std::memcpy(data + i * sizeof(value), &value, sizeof(value));
+            }
+        }
+
+        enum class Mode { Attributes, Triangles, Indices };
+
+        struct DecodeJob {
+            int bufferView;
+            std::span<const uint8_t> source;
+            size_t byteStride;
+            size_t count;
+            Mode mode;
+            MeshoptDecoder::Filter filter;
+            std::vector<uint8_t> *destination;
+        };
+
+        size_t getSize(const tinygltf::Value &extension, const char *key, size_t fallback) {
+            if (!extension.Has(key)) return fallback;
+            const double value = extension.Get(key).GetNumberAsDouble();
+            if (value < 0.0) fail(std::string("buffer view, negative ") + key);
+            return static_cast<size_t>(value);
+        }
+
+        std::string getString(const tinygltf::Value &extension, const char *key, const char *fallback) {
+            if (!extension.Has(key) || !extension.Get(key).IsString()) return fallback;
+            return extension.Get(key).Get<std::string>();
+        }
+
+        void runJob(const DecodeJob &job) {
+            uint8_t *destination = job.destination->data();
+            switch (job.mode) {
+                case Mode::Attributes:
+                    MeshoptDecoder::decodeVertexBuffer(destination, job.count, job.byteStride, job.source);
+                    break;
+                case Mode::Triangles:
+                    MeshoptDecoder::decodeIndexBuffer(destination, job.count, job.byteStride, job.source);
+                    break;
+                case Mode::Indices:
+                    MeshoptDecoder::decodeIndexSequence(destination, job.count, job.byteStride, job.source);
+                    break;
+            }
+            MeshoptDecoder::decodeFilter(job.filter, destination, job.count, job.byteStride);
+        }
+    }
+
+    void MeshoptDecoder::decodeVertexBuffer(uint8_t *destination, size_t count, size_t byteStride,
+                                            std::span<const uint8_t> source) {
+        if (byteStride == 0 || byteStride > VERTEX_MAX_STRIDE || byteStride % 4 != 0) fail("vertex stream, stride");
+        if (source.size() < 1 + byteStride) fail("vertex stream, truncated");
+        if ((source[0] & 0xf0) != VERTEX_HEADER) fail("vertex stream, header");
+        if ((source[0] & 0x0f) != 0) fail("vertex stream, unsupported version");
+
+        // the stream ends with the baseline vertex, padded at the front to at least 32 bytes
+        const size_t tailSize = std::max(byteStride, VERTEX_TAIL_SIZE);
+        if (source.size() < 1 + tailSize) fail("vertex stream, truncated");
+        const uint8_t *data = source.data() + 1;
+        const uint8_t *end = source.data() + source.size() - tailSize;
+
+        uint8_t lastVertex[VERTEX_MAX_STRIDE];
+        std::memcpy(lastVertex, source.data() + source.size() - byteStride, byteStride);
+
+        const size_t blockSize = std::min((VERTEX_BLOCK_SIZE_BYTES / byteStride) & ~(BYTE_GROUP_SIZE - 1),
+                                          VERTEX_BLOCK_MAX_SIZE);
+        for (size_t offset = 0; offset < count; offset += blockSize) {
+            data = decodeVertexBlock(data, end, destination + offset * byteStride, std::min(blockSize, count - offset),
+                                     byteStride, lastVertex);
+        }
+
+        if (data != end) fail("vertex stream, trailing data");
+    }
+
+    void MeshoptDecoder::decodeIndexBuffer(uint8_t *destination, size_t count, size_t indexSize,
+                                           std::span<const uint8_t> source) {
+        if (count % 3 != 0 || (indexSize != 2 && indexSize != 4)) fail("index buffer, layout");
+        // one code byte per triangle, then the data, then the 16 byte table of auxiliary codes
+        if (source.size() < 1 + count / 3 + INDEX_TAIL_SIZE) fail("index buffer, truncated");
+        if ((source[0] & 0xf0) != INDEX_HEADER) fail("index buffer, header");
+        const int version = source[0] & 0x0f;
+        if (version > 1) fail("index buffer, unsupported version");
+
+        uint32_t edgeFifo[16][2];
+        uint32_t vertexFifo[16];
+        std::memset(edgeFifo, -1, sizeof(edgeFifo));
+        std::memset(vertexFifo, -1, sizeof(vertexFifo));
+        size_t edgeOffset = 0;
+        size_t vertexOffset = 0;
+        uint32_t next = 0;
+        uint32_t last = 0;
+        const uint32_t fecMax = version >= 1 ? 13 : 15;
+
+        const uint8_t *code = source.data() + 1;
+        const uint8_t *data = code + count / 3;
+        const uint8_t *safeEnd = source.data() + source.size() - INDEX_TAIL_SIZE;
+        const uint8_t *auxiliaryCodes = safeEnd;
+
+        // a triangle reads at most 16 bytes, so checking the safe end once per triangle keeps reads in bounds
+        for (size_t i = 0; i < count; i += 3) {
+            if (data > safeEnd) fail("index buffer, truncated");
+
+            const uint8_t codeTriangle = *code++;
+            if (codeTriangle < 0xf0) {
+                // the triangle shares an edge from the FIFO
+                const uint32_t fe = codeTriangle >> 4;
+                const uint32_t a = edgeFifo[(edgeOffset - 1 - fe) & 15][0];
+                const uint32_t b = edgeFifo[(edgeOffset - 1 - fe) & 15][1];
+                const uint32_t fec = codeTriangle & 15;
+
+                uint32_t c;
+                if (fec < fecMax) {
+                    const uint32_t cached = vertexFifo[(vertexOffset - 1 - fec) & 15];
+                    c = fec == 0 ? next : cached;
+                    next += fec == 0 ? 1 : 0;
+                    pushVertex(vertexFifo, vertexOffset, c, fec == 0);
+                } else {
+                    // 13 and 14 are +-1 from the last free index, 15 is an explicit delta
+                    c = last = fec != 15 ? last + (fec - (fec ^ 3)) : decodeIndex(data, last);
+                    pushVertex(vertexFifo, vertexOffset, c);
+                }
+
+                writeIndex(destination, i, indexSize, a);
+                writeIndex(destination, i + 1, indexSize, b);
+                writeIndex(destination, i + 2, indexSize, c);
+                pushEdge(edgeFifo, edgeOffset, c, b);
+                pushEdge(edgeFifo, edgeOffset, a, c);
+            } else {
+                uint32_t a, b, c;
+                bool advanceB, advanceC;
+                if (codeTriangle < 0xfe) {
+                    // a new vertex plus two from the FIFO or new, described by the auxiliary table
+                    const uint8_t codeAuxiliary = auxiliaryCodes[codeTriangle & 15];
+                    const uint32_t feb = codeAuxiliary >> 4;
+                    const uint32_t fec = codeAuxiliary & 15;
+
+                    a = next++;
+                    b = feb == 0 ? next : vertexFifo[(vertexOffset - feb) & 15];
+                    next += feb == 0 ? 1 : 0;
+                    c = fec == 0 ? next : vertexFifo[(vertexOffset - fec) & 15];
+                    next += fec == 0 ? 1 : 0;
+                    advanceB = feb == 0;
+                    advanceC = fec == 0;
+                } else {
+                    const uint8_t codeAuxiliary = *data++;
+                    const uint32_t fea = codeTriangle == 0xfe ? 0 : 15;
+                    const uint32_t feb = codeAuxiliary >> 4;
+                    const uint32_t fec = codeAuxiliary & 15;
+
+                    // an explicit zero auxiliary code would fit the table, the encoder uses it to restart next
+                    if (codeAuxiliary == 0) next = 0;
+
+                    a = fea == 0 ? next++ : 0;
+                    b = feb == 0 ? next++ : vertexFifo[(vertexOffset - feb) & 15];
+                    c = fec == 0 ? next++ : vertexFifo[(vertexOffset - fec) & 15];
+
+                    // free indices are delta coded against the previous free index
+                    if (fea == 15) last = a = decodeIndex(data, last);
+                    if (feb == 15) last = b = decodeIndex(data, last);
+                    if (fec == 15) last = c = decodeIndex(data, last);
+                    advanceB = feb == 0 || feb == 15;
+                    advanceC = fec == 0 || fec == 15;
+                }
+
+                writeIndex(destination, i, indexSize, a);
+                writeIndex(destination, i + 1, indexSize, b);
+                writeIndex(destination, i + 2, indexSize, c);
+                pushVertex(vertexFifo, vertexOffset, a);
+                pushVertex(vertexFifo, vertexOffset, b, advanceB);
+                pushVertex(vertexFifo, vertexOffset, c, advanceC);
+                pushEdge(edgeFifo, edgeOffset, b, a);
+                pushEdge(edgeFifo, edgeOffset, c, b);
+                pushEdge(edgeFifo, edgeOffset, a, c);
+            }
+        }
+
+        if (data != safeEnd) fail("index buffer, trailing data");
+    }
+
+    void MeshoptDecoder::decodeIndexSequence(uint8_t *destination, size_t count, size_t indexSize,
+                                             std::span<const uint8_t> source) {
+        if (indexSize != 2 && indexSize != 4) fail("index sequence, layout");
+        if (source.size() < 1 + count + SEQUENCE_TAIL_SIZE) fail("index sequence, truncated");
+        if ((source[0] & 0xf0) != SEQUENCE_HEADER) fail("index sequence, header");
+        if ((source[0] & 0x0f) > 1) fail("index sequence, unsupported version");
+
+        const uint8_t *data = source.data() + 1;
+        const uint8_t *safeEnd = source.data() + source.size() - SEQUENCE_TAIL_SIZE;
+        uint32_t last[2] = {0, 0};
+
+        for (size_t i = 0; i < count; i++) {
+            // at least five bytes are left, enough for the longest varint
+            if (data >= safeEnd) fail("index sequence, truncated");
+
+            uint32_t value = decodeVByte(data);
+            // the lowest bit picks one of two baselines, the rest is a zigzag delta
+            const uint32_t baseline = value & 1;
+            value >>= 1;
+            const uint32_t delta = (value >> 1) ^ -static_cast<int32_t>(value & 1);
+            last[baseline] += delta;
+            writeIndex(destination, i, indexSize, last[baseline]);
+        }
+
+        if (data != safeEnd) fail("index sequence, trailing data");
+    }
+
+    void MeshoptDecoder::decodeFilter(Filter filter, uint8_t *data, size_t count, size_t byteStride) {
+        switch (filter) {
+            case Filter::None:
+                break;
+            case Filter::Octahedral:
+                if (byteStride == 4) decodeOctahedral<int8_t>(data, count);
+                else if (byteStride == 8) decodeOctahedral<int16_t>(data, count);
+                else fail("octahedral filter, stride");
+                break;
+            case Filter::Quaternion:
+                if (byteStride != 8) fail("quaternion filter, stride");
+                decodeQuaternion(data, count);
+                break;
+            case Filter::Exponential:
+                if (byteStride % 4 != 0) fail("exponential filter, stride");
+                decodeExponential(data, count * byteStride / 4);
+                break;
+        }
+    }
+
+    void decodeMeshoptBufferViews(GltfDocument &document) {
+        tinygltf::Model &model = document.model;
+
+        std::vector<DecodeJob> jobs;
+        for (size_t v = 0; v < model.bufferViews.size(); v++) {
+            const auto it = model.bufferViews[v].extensions.find("EXT_meshopt_compression");
+            if (it == model.bufferViews[v].extensions.end()) continue;
+            const tinygltf::Value &extension = it->second;
+
+            const size_t buffer = getSize(extension, "buffer", document.buffers.size());
+            const size_t byteOffset = getSize(extension, "byteOffset", 0);
+            const size_t byteLength = getSize(extension, "byteLength", 0);
+            if (buffer >= document.buffers.size() || byteOffset + byteLength > document.buffers[buffer].size()) {
+                fail("buffer view, source out of range");
+            }
+
+            DecodeJob job{};
+            job.bufferView = static_cast<int>(v);
+            job.source = document.buffers[buffer].subspan(byteOffset, byteLength);
+            job.byteStride = getSize(extension, "byteStride", 0);
+            job.count = getSize(extension, "count", 0);
+            if (job.byteStride == 0) fail("buffer view, missing stride");
+
+            const std::string mode = getString(extension, "mode", "");
+            if (mode == "ATTRIBUTES") job.mode = Mode::Attributes;
+            else if (mode == "TRIANGLES") job.mode = Mode::Triangles;
+            else if (mode == "INDICES") job.mode = Mode::Indices;
+            else fail("buffer view, mode " + mode);
+
+            const std::string filter = getString(extension, "filter", "NONE");
+            if (filter == "NONE") job.filter = MeshoptDecoder::Filter::None;
+            else if (filter == "OCTAHEDRAL") job.filter = MeshoptDecoder::Filter::Octahedral;
+            else if (filter == "QUATERNION") job.filter = MeshoptDecoder::Filter::Quaternion;
+            else if (filter == "EXPONENTIAL") job.filter = MeshoptDecoder::Filter::Exponential;
+            else fail("buffer view, filter " + filter);
+
+            jobs.push_back(job);
+        }
+        if (jobs.empty()) return;
+
+        // allocated up front, the workers only write into their own view
+        const size_t firstDecoded = document.decodedBuffers.size();
+        document.decodedBuffers.resize(firstDecoded + jobs.size());
+        for (size_t j = 0; j < jobs.size(); j++) {
+            std::vector<uint8_t> &decoded = document.decodedBuffers[firstDecoded + j];
+            decoded.resize(jobs[j].count * jobs[j].byteStride);
+            jobs[j].destination = &decoded;
+        }
+
+        // views vary wildly in size, parallelFor hands them out one at a time
+        parallelFor(jobs.size(), [&](size_t j) { runJob(jobs[j]); });
+
+        // point the views at the decoded data, appended as new buffers
+        for (const DecodeJob &job: jobs) {
+            tinygltf::BufferView &bufferView = model.bufferViews[job.bufferView];
+            model.buffers.emplace_back();
+            document.buffers.emplace_back(*job.destination);
+            bufferView.buffer = static_cast<int>(model.buffers.size() - 1);
+            bufferView.byteOffset = 0;
+            bufferView.byteLength = job.destination->size();
+        }
+
+        // growing model.buffers may have copied the data URI buffers the spans point into
+        for (size_t i = 0; i < model.buffers.size(); i++) {
+            if (!model.buffers[i].data.empty()) document.buffers[i] = model.buffers[i].data;
+        }
+    }
+}
@@ -0,0 +1,50 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef MESHOPTDECODER_H
+#define MESHOPTDECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "GltfDocument.h"
+
+namespace vulkr {
+    /**
+     * Decoders for the bitstreams and filters of EXT_meshopt_compression, as specified in the extension's
+     * appendix. Every decoder checks its input bounds and throws on a malformed stream.
+     */
+    namespace MeshoptDecoder {
+        enum class Filter { None, Octahedral, Quaternion, Exponential };
+
+        /**
+         * Mode ATTRIBUTES: count elements of byteStride bytes, byte planes delta coded per block.
+         */
+        void decodeVertexBuffer(uint8_t *destination, size_t count, size_t byteStride, std::span<const uint8_t> source);
+
+        /**
+         * Mode TRIANGLES: count indices of indexSize (2 or 4) bytes, coded with edge and vertex FIFOs.
+         */
+        void decodeIndexBuffer(uint8_t *destination, size_t count, size_t indexSize, std::span<const uint8_t> source);
+
+        /**
+         * Mode INDICES: count indices of indexSize (2 or 4) bytes, delta coded against two baselines.
+         */
+        void decodeIndexSequence(uint8_t *destination, size_t count, size_t indexSize, std::span<const uint8_t> source);
+
+        /**
+         * Reverses an encoder filter in place on count decoded elements of byteStride bytes.
+         */
+        void decodeFilter(Filter filter, uint8_t *data, size_t count, size_t byteStride);
+    }
+
+    /**
+     * Decodes every buffer view of document that carries EXT_meshopt_compression, spread over worker threads
+     * one view at a time, and points those views at their decoded data.
+     */
+    void decodeMeshoptBufferViews(GltfDocument &document);
+}
+
+#endif //MESHOPTDECODER_H
@@ -6,46 +6,100 @@
 #include <glm/gtx/hash.hpp>
 
 #include "vulkr_model.h"
+#include <array>
 #include <iostream>
 
 namespace vulkr {
     std::vector<VkVertexInputBindingDescription> VulkrModel::Vertex::getBindingDescriptions() {
-        std::vector<VkVertexInputBindingDescription> bindingsDescriptions(1);
+        std::vector<VkVertexInputBindingDescription> bindingsDescriptions(2);
         bindingsDescriptions[0].binding = 0;
-        bindingsDescriptions[0].stride = sizeof(Vertex);
+        bindingsDescriptions[0].stride = sizeof(glm::vec3);
         bindingsDescriptions[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        bindingsDescriptions[1].binding = 1;
+        bindingsDescriptions[1].stride = sizeof(VertexAttributes);
+        bindingsDescriptions[1].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
         return bindingsDescriptions;
     }
 
     std::vector<VkVertexInputAttributeDescription> VulkrModel::Vertex::getAttributeDescriptions() {
         std::vector<VkVertexInputAttributeDescription> attributeDescriptions{};
 
-        attributeDescriptions.push_back({0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, position)});
-        attributeDescriptions.push_back({1, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, color)});
-        attributeDescriptions.push_back({2, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, normal)});
-        attributeDescriptions.push_back({3, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(Vertex, uv)});
-        attributeDescriptions.push_back({4, 0, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Vertex, jointIndices)});
-        attributeDescriptions.push_back({5, 0, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Vertex, jointWeights)});
+        attributeDescriptions.push_back({0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0});
+        attributeDescriptions.push_back({1, 1, VK_FORMAT_R32G32B32_SFLOAT, offsetof(VertexAttributes, color)});
+        attributeDescriptions.push_back({2, 1, VK_FORMAT_R32G32B32_SFLOAT, offsetof(VertexAttributes, normal)});
+        attributeDescriptions.push_back({3, 1, VK_FORMAT_R32G32_SFLOAT, offsetof(VertexAttributes, uv)});
+        attributeDescriptions.push_back({4, 1, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(VertexAttributes, jointIndices)});
+        attributeDescriptions.push_back({5, 1, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(VertexAttributes, jointWeights)});
 
         return attributeDescriptions;
     }
 
+    std::vector<VkVertexInputBindingDescription> VulkrModel::Vertex::getPositionBindingDescriptions() {
+        auto bindingDescriptions = getBindingDescriptions();
+        bindingDescriptions.resize(1);
+        return bindingDescriptions;
+    }
+
+    std::vector<VkVertexInputAttributeDescription> VulkrModel::Vertex::getPositionAttributeDescriptions() {
+        return {{0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0}};
+    }
+
     VulkrModel::VulkrModel(VulkrDevice &device, const Builder &builder) : device(device) {
-        createVertexBuffers(builder.vertices);
-        createIndexBuffers(builder.indices);
+        if (builder.streams.write) {
+            createStreamBuffers(builder.streams, !builder.skeleton.empty());
+        } else {
+            createVertexBuffers(builder.vertices, !builder.skeleton.empty());
+            createIndexBuffers(builder.indices);
+        }
+        createBoneBuffers(builder.bones, builder.boneIndices);
+        createAnimations(builder);
+
+        submeshes = builder.submeshes;
+        if (submeshes.empty()) {
+            submeshes.push_back({0, hasIndexBuffer ? indexCount : vertexCount, nullptr});
+        }
     }
 
     VulkrModel::~VulkrModel() {
-        vkDestroyBuffer(device.device(), vertexBuffer, nullptr);
-        vkFreeMemory(device.device(), vertexBufferMemory, nullptr);
+        // buffers may still be read by frames in flight, release them once those complete
+        auto &deletionQueue = device.deletionQueue();
+        deletionQueue.retireBuffer(positionBuffer, positionBufferMemory, lastUsedFrameValue);
+        deletionQueue.retireBuffer(attributeBuffer, attributeBufferMemory, lastUsedFrameValue);
         if (hasIndexBuffer) {
-            vkDestroyBuffer(device.device(), indexBuffer, nullptr);
-            vkFreeMemory(device.device(), indexBufferMemory, nullptr);
+            deletionQueue.retireBuffer(indexBuffer, indexBufferMemory, lastUsedFrameValue);
+        }
+        if (hasBoneBuffer) {
+            deletionQueue.retireBuffer(boneVertexBuffer, boneVertexBufferMemory, lastUsedFrameValue);
+        }
+        if (boneIndexCount > 0) {
+            deletionQueue.retireBuffer(boneIndexBuffer, boneIndexBufferMemory, lastUsedFrameValue);
         }
     }
 
     void VulkrModel::bind(VkCommandBuffer commandBuffer) {
-        VkBuffer buffers[] = {vertexBuffer};
+        bind(commandBuffer, positionBuffer, attributeBuffer);
+    }
+
+    void VulkrModel::bindPositions(VkCommandBuffer commandBuffer) {
+        bindPositions(commandBuffer, positionBuffer);
+    }
+
+    void VulkrModel::bind(VkCommandBuffer commandBuffer, VkBuffer positions, VkBuffer attributes) {
+        lastUsedFrameValue = device.frameTimeline().getCurrentValue();
+
+        VkBuffer buffers[] = {positions, attributes};
+        VkDeviceSize offsets[] = {0, 0};
+        vkCmdBindVertexBuffers(commandBuffer, 0, 2, buffers, offsets);
+
+        if (hasIndexBuffer) {
+            vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+        }
+    }
+
+    void VulkrModel::bindPositions(VkCommandBuffer commandBuffer, VkBuffer positions) {
+        lastUsedFrameValue = device.frameTimeline().getCurrentValue();
+
+        VkBuffer buffers[] = {positions};
         VkDeviceSize offsets[] = {0};
         vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
 
@@ -55,41 +109,136 @@ namespace vulkr {
     }
 
     void VulkrModel::draw(VkCommandBuffer commandBuffer) {
+        draw(commandBuffer, 1, 0);
+    }
+
+    void VulkrModel::draw(VkCommandBuffer commandBuffer, uint32_t instanceCount, uint32_t firstInstance) {
+        if (hasIndexBuffer) {
+            vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, 0, 0, firstInstance);
+        } else vkCmdDraw(commandBuffer, vertexCount, instanceCount, 0, firstInstance);
+    }
+
+    void VulkrModel::drawSubmesh(VkCommandBuffer commandBuffer, size_t submesh, uint32_t instanceCount,
+                                 uint32_t firstInstance) {
+        const Submesh &range = submeshes[submesh];
         if (hasIndexBuffer) {
-            vkCmdDrawIndexed(commandBuffer, indexCount, 1, 0, 0, 0);
-        } else vkCmdDraw(commandBuffer, vertexCount, 1, 0, 0);
+            vkCmdDrawIndexed(commandBuffer, range.indexCount, instanceCount, range.firstIndex, 0, firstInstance);
+        } else vkCmdDraw(commandBuffer, range.indexCount, instanceCount, range.firstIndex, firstInstance);
     }
 
-    void VulkrModel::createVertexBuffers(const std::vector<Vertex> &vertices) {
+    void VulkrModel::setMaterial(const std::shared_ptr<VulkrMaterial> &material) {
+        for (Submesh &submesh: submeshes) {
+            submesh.material = material;
+        }
+    }
+
+    void VulkrModel::createVertexBuffers(const std::vector<Vertex> &vertices, bool skinned) {
         vertexCount = static_cast<uint32_t>(vertices.size());
         assert(vertexCount >= 2 && "Vertex count must be at least 3 to form a triangle");
 
-        VkDeviceSize vertexBufferSize = sizeof(vertices[0]) * vertexCount;
+        boundsMin = boundsMax = vertices[0].position;
+        for (const auto &vertex: vertices) {
+            boundsMin = glm::min(boundsMin, vertex.position);
+            boundsMax = glm::max(boundsMax, vertex.position);
+        }
+
+        std::vector<glm::vec3> positions(vertexCount);
+        std::vector<VertexAttributes> attributes(vertexCount);
+        for (uint32_t i = 0; i < vertexCount; i++) {
+            const auto &vertex = vertices[i];
+            positions[i] = vertex.position;
+            attributes[i] = {vertex.color, vertex.normal, vertex.uv, vertex.jointIndices, vertex.jointWeights};
+        }
+
+        // skinned models are also read by the skinning pass, which seeds its caches with a copy of the attributes
+        VkBufferUsageFlags usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+        if (skinned) {
+            usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        }
 
+        createDeviceLocalBuffer(positions.data(), sizeof(positions[0]) * vertexCount, usage, positionBuffer,
+                                positionBufferMemory);
+        createDeviceLocalBuffer(attributes.data(), sizeof(attributes[0]) * vertexCount, usage, attributeBuffer,
+                                attributeBufferMemory);
+    }
+
+    void VulkrModel::createStreamBuffers(const Builder::Streams &streams, bool skinned) {
+        vertexCount = streams.vertexCount;
+        assert(vertexCount >= 2 && "Vertex count must be at least 3 to form a triangle");
+        indexCount = streams.indexCount;
+        hasIndexBuffer = indexCount > 0;
+        boundsMin = streams.boundsMin;
+        boundsMax = streams.boundsMax;
+
+        // the loader writes straight into the staging memory of all three streams
+        const std::array<VkDeviceSize, 3> sizes = {
+            sizeof(glm::vec3) * vertexCount, sizeof(VertexAttributes) * vertexCount, sizeof(uint32_t) * indexCount
+        };
+        std::array<VkBuffer, 3> stagingBuffers{};
+        std::array<VkDeviceMemory, 3> stagingBufferMemory{};
+        std::array<void *, 3> mapped{};
+        for (size_t i = 0; i < sizes.size(); i++) {
+            if (sizes[i] == 0) continue;
+            device.createBuffer(sizes[i], VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                stagingBuffers[i], stagingBufferMemory[i]);
+            vkMapMemory(device.device(), stagingBufferMemory[i], 0, sizes[i], 0, &mapped[i]);
+        }
+
+        streams.write(static_cast<glm::vec3 *>(mapped[0]), static_cast<VertexAttributes *>(mapped[1]),
+                      static_cast<uint32_t *>(mapped[2]));
+
+        VkBufferUsageFlags usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+        if (skinned) {
+            usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        }
+
+        createDeviceLocalBuffer(stagingBuffers[0], sizes[0], usage, positionBuffer, positionBufferMemory);
+        createDeviceLocalBuffer(stagingBuffers[1], sizes[1], usage, attributeBuffer, attributeBufferMemory);
+        if (hasIndexBuffer) {
+            createDeviceLocalBuffer(stagingBuffers[2], sizes[2], VK_BUFFER_USAGE_INDEX_BUFFER_BIT, indexBuffer,
+                                    indexBufferMemory);
+        }
+
+        for (size_t i = 0; i < sizes.size(); i++) {
+            if (sizes[i] == 0) continue;
+            vkUnmapMemory(device.device(), stagingBufferMemory[i]);
+            vkDestroyBuffer(device.device(), stagingBuffers[i], nullptr);
+            vkFreeMemory(device.device(), stagingBufferMemory[i], nullptr);
+        }
+    }
+
+    void VulkrModel::createDeviceLocalBuffer(const void *source, VkDeviceSize bufferSize, VkBufferUsageFlags usage,
+                                             VkBuffer &buffer, VkDeviceMemory &bufferMemory) {
         VkBuffer stagingBuffer;
         VkDeviceMemory stagingBufferMemory;
-        device.createBuffer(vertexBufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        device.createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                             stagingBuffer, stagingBufferMemory
         );
 
         void *data;
-        vkMapMemory(device.device(), stagingBufferMemory, 0, vertexBufferSize, 0, &data);
-        memcpy(data, vertices.data(), static_cast<size_t>(vertexBufferSize));
+        vkMapMemory(device.device(), stagingBufferMemory, 0, bufferSize, 0, &data);
+        memcpy(data, source, static_cast<size_t>(bufferSize));
         vkUnmapMemory(device.device(), stagingBufferMemory);
 
-        device.createBuffer(vertexBufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                            vertexBuffer, vertexBufferMemory
-        );
-
-        device.copyBuffer(stagingBuffer, vertexBuffer, vertexBufferSize);
+        createDeviceLocalBuffer(stagingBuffer, bufferSize, usage, buffer, bufferMemory);
 
         // clean up staging buffer
         vkDestroyBuffer(device.device(), stagingBuffer, nullptr);
         vkFreeMemory(device.device(), stagingBufferMemory, nullptr);
     }
 
+    void VulkrModel::createDeviceLocalBuffer(VkBuffer stagingBuffer, VkDeviceSize bufferSize, VkBufferUsageFlags usage,
+                                             VkBuffer &buffer, VkDeviceMemory &bufferMemory) {
+        device.createBuffer(bufferSize, usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                            buffer, bufferMemory
+        );
+
+        device.copyBuffer(stagingBuffer, buffer, bufferSize);
+    }
+
     void VulkrModel::createIndexBuffers(const std::vector<uint32_t> &indices) {
         indexCount = static_cast<uint32_t>(indices.size());
         hasIndexBuffer = indexCount > 0;
@@ -183,4 +332,25 @@ namespace vulkr {
             vkFreeMemory(device.device(), indexStagingBufferMemory, nullptr);
         }
     }
+
+    void VulkrModel::createAnimations(const Builder &builder) {
+        restPose = builder.restPose;
+        skeleton = builder.skeleton;
+        if (restPose.size() < skeleton.parents.size()) {
+            restPose.resize(skeleton.parents.size());
+        }
+
+        for (const auto &animation: builder.animations) {
+            auto clip = std::make_shared<AnimationClip>(animation.name);
+            for (const auto &channel: animation.channels) {
+                const auto &sampler = animation.samplers[channel.samplerIndex];
+                clip->addTrack(channel.path, sampler.interpolation, static_cast<uint32_t>(channel.nodeIndex),
+                               sampler.inputs, sampler.outputs);
+            }
+            if (restPose.size() < clip->getNodeCount()) {
+                restPose.resize(clip->getNodeCount());
+            }
+            animations.push_back(std::move(clip));
+        }
+    }
 }
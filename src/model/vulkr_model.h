@@ -8,14 +8,20 @@
 
 #define GLM_FORCE_RADIANS // force GLM to use radians for angles
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE // force GLM to use depth range [0, 1]
+#include <functional>
 #include <memory>
 #include <glm/glm.hpp>
 
+#include "../animation/skeleton.h"
+#include "../texture/vulkr_material.h"
+
 namespace vulkr {
     class VulkrModel {
     public:
         /**
          * Whenever you change the vertex structure, you must also update the binding and attribute descriptions.
+         * On the GPU the position is split into its own stream (binding 0) and everything else is interleaved
+         * in binding 1, so position-only passes fetch 12 bytes per vertex.
          */
         struct Vertex {
             glm::vec3 position{};
@@ -29,16 +35,41 @@ namespace vulkr {
 
             static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions();
 
+            static std::vector<VkVertexInputBindingDescription> getPositionBindingDescriptions();
+
+            static std::vector<VkVertexInputAttributeDescription> getPositionAttributeDescriptions();
+
             bool operator==(const Vertex &other) const {
                 return position == other.position && color == other.color && normal == other.normal && uv == other.uv;
             }
         };
 
+        /**
+         * GPU layout of the non-position vertex stream.
+         */
+        struct VertexAttributes {
+            glm::vec3 color{};
+            glm::vec3 normal{};
+            glm::vec2 uv{};
+            glm::vec4 jointIndices{0.0f};
+            glm::vec4 jointWeights{0.0f};
+        };
+
         struct Bone {
             glm::mat4 transform;
             int32_t parent;
         };
 
+        /**
+         * A range of the index buffer drawn with its own material, the range counts vertices in models without
+         * an index buffer. Null draws with the texture manager's default material.
+         */
+        struct Submesh {
+            uint32_t firstIndex{0};
+            uint32_t indexCount{0};
+            std::shared_ptr<VulkrMaterial> material;
+        };
+
         struct Builder {
             std::vector<Vertex> vertices{};
             std::vector<uint32_t> indices{};
@@ -46,13 +77,13 @@ namespace vulkr {
             std::vector<uint32_t> boneIndices{};
 
             struct AnimationSampler {
-                std::string interpolation;
+                AnimationInterpolation interpolation{AnimationInterpolation::Linear};
                 std::vector<float> inputs;
                 std::vector<glm::vec4> outputs;
             };
 
             struct AnimationChannel {
-                std::string path;
+                AnimationPath path;
                 int samplerIndex;
                 int nodeIndex;
             };
@@ -64,6 +95,33 @@ namespace vulkr {
             };
 
             std::vector<Animation> animations;
+
+            /**
+             * Local transform of every node in the skeleton's flattened order, indexed like the channels' nodeIndex.
+             */
+            AnimationPose restPose;
+
+            Skeleton skeleton;
+
+            /**
+             * Alternative to vertices and indices for loaders that convert their source into the GPU layout
+             * themselves: write receives the mapped staging memory for vertexCount positions and attributes and
+             * indexCount indices and must fill all of it.
+             */
+            struct Streams {
+                uint32_t vertexCount{0};
+                uint32_t indexCount{0};
+                glm::vec3 boundsMin{0.0f};
+                glm::vec3 boundsMax{0.0f};
+                std::function<void(glm::vec3 *positions, VertexAttributes *attributes, uint32_t *indices)> write;
+            };
+
+            Streams streams;
+
+            /**
+             * Ranges with their own material, in index order. Left empty, the whole model is one submesh.
+             */
+            std::vector<Submesh> submeshes;
         };
 
         VulkrModel(VulkrDevice &device, const Builder &builder);
@@ -76,19 +134,98 @@ namespace vulkr {
 
         void bind(VkCommandBuffer commandBuffer);
 
+        /**
+         * Binds only the position stream and index buffer, for pipelines built with the position-only
+         * vertex descriptions.
+         */
+        void bindPositions(VkCommandBuffer commandBuffer);
+
+        /**
+         * Binds other vertex streams in this model's layout, e.g. a skinned copy, with this model's index buffer.
+         */
+        void bind(VkCommandBuffer commandBuffer, VkBuffer positions, VkBuffer attributes);
+
+        void bindPositions(VkCommandBuffer commandBuffer, VkBuffer positions);
+
         void draw(VkCommandBuffer commandBuffer);
 
+        /**
+         * Instanced draw, firstInstance offsets gl_InstanceIndex.
+         */
+        void draw(VkCommandBuffer commandBuffer, uint32_t instanceCount, uint32_t firstInstance);
+
+        /**
+         * Draws one submesh, for passes that bind each submesh's material.
+         */
+        void drawSubmesh(VkCommandBuffer commandBuffer, size_t submesh, uint32_t instanceCount = 1,
+                         uint32_t firstInstance = 0);
+
+        /**
+         * Frame timeline value of the last frame that bound this model.
+         */
+        uint64_t getLastUsedFrameValue() const { return lastUsedFrameValue; }
+
+        /**
+         * Object space bounding box of the vertices, used for culling.
+         */
+        const glm::vec3 &getBoundsMin() const { return boundsMin; }
+        const glm::vec3 &getBoundsMax() const { return boundsMax; }
+
+        const std::vector<std::shared_ptr<const AnimationClip>> &getAnimations() const { return animations; }
+        const AnimationPose &getRestPose() const { return restPose; }
+
+        /**
+         * Skinned models carry joint indices and weights and are deformed by the skinning pass every frame.
+         */
+        bool isSkinned() const { return !skeleton.empty(); }
+        const Skeleton &getSkeleton() const { return skeleton; }
+
+        /**
+         * Source streams of the skinning pass, skinned models create them with storage and transfer usage.
+         */
+        VkBuffer getPositionBuffer() const { return positionBuffer; }
+        VkBuffer getAttributeBuffer() const { return attributeBuffer; }
+        uint32_t getVertexCount() const { return vertexCount; }
+
+        const std::vector<Submesh> &getSubmeshes() const { return submeshes; }
+
+        /**
+         * Gives every submesh the same base color material.
+         */
+        void setMaterial(const std::shared_ptr<VulkrMaterial> &material);
+
     private:
-        void createVertexBuffers(const std::vector<Vertex> &vertices);
+        void createVertexBuffers(const std::vector<Vertex> &vertices, bool skinned);
+
+        void createStreamBuffers(const Builder::Streams &streams, bool skinned);
+
+        void createDeviceLocalBuffer(const void *source, VkDeviceSize bufferSize, VkBufferUsageFlags usage,
+                                     VkBuffer &buffer, VkDeviceMemory &bufferMemory);
+
+        void createDeviceLocalBuffer(VkBuffer stagingBuffer, VkDeviceSize bufferSize, VkBufferUsageFlags usage,
+                                     VkBuffer &buffer, VkDeviceMemory &bufferMemory);
 
         void createIndexBuffers(const std::vector<uint32_t> &indices);
 
         void createBoneBuffers(const std::vector<Bone> &bones, const std::vector<uint32_t> &boneIndices);
 
+        void createAnimations(const Builder &builder);
+
         VulkrDevice &device;
+        uint64_t lastUsedFrameValue{0};
+
+        glm::vec3 boundsMin{0.0f};
+        glm::vec3 boundsMax{0.0f};
+
+        std::vector<std::shared_ptr<const AnimationClip>> animations;
+        AnimationPose restPose;
+        Skeleton skeleton;
+        std::vector<Submesh> submeshes;
 
-        VkBuffer vertexBuffer;
-        VkDeviceMemory vertexBufferMemory;
+        VkBuffer positionBuffer;
+        VkDeviceMemory positionBufferMemory;
+        VkBuffer attributeBuffer;
+        VkDeviceMemory attributeBufferMemory;
         uint32_t vertexCount;
 
         bool hasIndexBuffer{false};
@@ -99,11 +236,11 @@ namespace vulkr {
         bool hasBoneBuffer{false};
         VkBuffer boneVertexBuffer;
         VkDeviceMemory boneVertexBufferMemory;
-        uint32_t boneVertexCount;
+        uint32_t boneVertexCount{0};
 
         VkBuffer boneIndexBuffer;
         VkDeviceMemory boneIndexBufferMemory;
-        uint32_t boneIndexCount;
+        uint32_t boneIndexCount{0};
     };
 }
 
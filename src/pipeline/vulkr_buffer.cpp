@@ -0,0 +1,79 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "vulkr_buffer.h"
+
+#include <cassert>
+#include <cstring>
+
+namespace vulkr {
+    VkDeviceSize VulkrBuffer::getAlignment(VkDeviceSize instanceSize, VkDeviceSize minOffsetAlignment) {
+        if (minOffsetAlignment > 0) {
+            return (instanceSize + minOffsetAlignment - 1) & ~(minOffsetAlignment - 1);
+        }
+        return instanceSize;
+    }
+
+    VulkrBuffer::VulkrBuffer(VulkrDevice &device, VkDeviceSize instanceSize, uint32_t instanceCount,
+                             VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags memoryPropertyFlags,
+                             VkDeviceSize minOffsetAlignment)
+        : vulkrDevice(device), instanceCount(instanceCount), instanceSize(instanceSize), usageFlags(usageFlags),
+          memoryPropertyFlags(memoryPropertyFlags) {
+        alignmentSize = getAlignment(instanceSize, minOffsetAlignment);
+        bufferSize = alignmentSize * instanceCount;
+        device.createBuffer(bufferSize, usageFlags, memoryPropertyFlags, buffer, memory);
+    }
+
+    VulkrBuffer::~VulkrBuffer() {
+        unmap();
+        // buffers are reached through descriptors rather than a bind call, so assume the frame being
+        // recorded may still read them
+        vulkrDevice.deletionQueue().retireBuffer(buffer, memory, vulkrDevice.frameTimeline().getCurrentValue());
+    }
+
+    VkResult VulkrBuffer::map(VkDeviceSize size, VkDeviceSize offset) {
+        assert(buffer && memory && "Called map on buffer before create");
+        return vkMapMemory(vulkrDevice.device(), memory, offset, size, 0, &mapped);
+    }
+
+    void VulkrBuffer::unmap() {
+        if (mapped) {
+            vkUnmapMemory(vulkrDevice.device(), memory);
+            mapped = nullptr;
+        }
+    }
+
+    void VulkrBuffer::writeToBuffer(const void *data, VkDeviceSize size, VkDeviceSize offset) {
+        assert(mapped && "Cannot copy to unmapped buffer");
+
+        if (size == VK_WHOLE_SIZE) {
+            memcpy(mapped, data, bufferSize);
+        } else {
+            auto memOffset = static_cast<char *>(mapped);
+            memOffset += offset;
+            memcpy(memOffset, data, size);
+        }
+    }
+
+    VkResult VulkrBuffer::flush(VkDeviceSize size, VkDeviceSize offset) {
+        VkMappedMemoryRange mappedRange{};
+        mappedRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        mappedRange.memory = memory;
+        mappedRange.offset = offset;
+        mappedRange.size = size;
+        return vkFlushMappedMemoryRanges(vulkrDevice.device(), 1, &mappedRange);
+    }
+
+    VkDescriptorBufferInfo VulkrBuffer::descriptorInfo(VkDeviceSize size, VkDeviceSize offset) const {
+        return VkDescriptorBufferInfo{buffer, offset, size};
+    }
+
+    void VulkrBuffer::writeToIndex(const void *data, uint32_t index) {
+        writeToBuffer(data, instanceSize, index * alignmentSize);
+    }
+
+    VkDescriptorBufferInfo VulkrBuffer::descriptorInfoForIndex(uint32_t index) const {
+        return descriptorInfo(alignmentSize, index * alignmentSize);
+    }
+}
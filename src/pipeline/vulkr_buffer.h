@@ -0,0 +1,67 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef VULKR_BUFFER_H
+#define VULKR_BUFFER_H
+
+#include "vulkr_device.hpp"
+
+namespace vulkr {
+    /**
+     * Owns a VkBuffer and its memory. Instances are laid out at a stride rounded up to minOffsetAlignment,
+     * so per-instance descriptors and dynamic offsets stay valid.
+     */
+    class VulkrBuffer {
+    public:
+        VulkrBuffer(VulkrDevice &device, VkDeviceSize instanceSize, uint32_t instanceCount,
+                    VkBufferUsageFlags usageFlags, VkMemoryPropertyFlags memoryPropertyFlags,
+                    VkDeviceSize minOffsetAlignment = 1);
+
+        ~VulkrBuffer();
+
+        VulkrBuffer(const VulkrBuffer &) = delete;
+
+        VulkrBuffer &operator=(const VulkrBuffer &) = delete;
+
+        VkResult map(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
+
+        void unmap();
+
+        void writeToBuffer(const void *data, VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
+
+        VkResult flush(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
+
+        VkDescriptorBufferInfo descriptorInfo(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0) const;
+
+        void writeToIndex(const void *data, uint32_t index);
+
+        VkDescriptorBufferInfo descriptorInfoForIndex(uint32_t index) const;
+
+        VkBuffer getBuffer() const { return buffer; }
+        void *getMappedMemory() const { return mapped; }
+        uint32_t getInstanceCount() const { return instanceCount; }
+        VkDeviceSize getInstanceSize() const { return instanceSize; }
+        VkDeviceSize getAlignmentSize() const { return alignmentSize; }
+        VkBufferUsageFlags getUsageFlags() const { return usageFlags; }
+        VkMemoryPropertyFlags getMemoryPropertyFlags() const { return memoryPropertyFlags; }
+        VkDeviceSize getBufferSize() const { return bufferSize; }
+
+    private:
+        static VkDeviceSize getAlignment(VkDeviceSize instanceSize, VkDeviceSize minOffsetAlignment);
+
+        VulkrDevice &vulkrDevice;
+        void *mapped = nullptr;
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+
+        VkDeviceSize bufferSize;
+        uint32_t instanceCount;
+        VkDeviceSize instanceSize;
+        VkDeviceSize alignmentSize;
+        VkBufferUsageFlags usageFlags;
+        VkMemoryPropertyFlags memoryPropertyFlags;
+    };
+}
+
+#endif //VULKR_BUFFER_H
@@ -0,0 +1,52 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "vulkr_compute_pipeline.h"
+#include "vulkr_pipeline.h"
+
+#include <stdexcept>
+
+namespace vulkr {
+    VulkrComputePipeline::VulkrComputePipeline(VulkrDevice &device, const std::string &compFilepath,
+                                               VkPipelineLayout pipelineLayout) : vulkrDevice(device) {
+        const auto compCode = VulkrPipeline::readFile(compFilepath);
+
+        VkShaderModuleCreateInfo moduleInfo{};
+        moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        moduleInfo.codeSize = compCode.size();
+        moduleInfo.pCode = reinterpret_cast<const uint32_t *>(compCode.data());
+
+        VkShaderModule compShaderModule;
+        if (vkCreateShaderModule(device.device(), &moduleInfo, nullptr, &compShaderModule) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create compute shader module!");
+        }
+
+        VkComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipelineInfo.stage.module = compShaderModule;
+        pipelineInfo.stage.pName = "main";
+        pipelineInfo.layout = pipelineLayout;
+
+        const VkResult result = vkCreateComputePipelines(device.device(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr,
+                                                         &computePipeline);
+
+        // the module is only needed while the pipeline is created
+        vkDestroyShaderModule(device.device(), compShaderModule, nullptr);
+
+        if (result != VK_SUCCESS) {
+            throw std::runtime_error("failed to create compute pipeline!");
+        }
+    }
+
+    VulkrComputePipeline::~VulkrComputePipeline() {
+        vulkrDevice.deletionQueue().retirePipeline(computePipeline, lastUsedFrameValue);
+    }
+
+    void VulkrComputePipeline::bind(VkCommandBuffer commandBuffer) {
+        lastUsedFrameValue = vulkrDevice.frameTimeline().getCurrentValue();
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
+    }
+}
@@ -0,0 +1,34 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef VULKR_COMPUTE_PIPELINE_H
+#define VULKR_COMPUTE_PIPELINE_H
+
+#include <string>
+
+#include "vulkr_device.hpp"
+
+namespace vulkr {
+    class VulkrComputePipeline {
+    public:
+        VulkrComputePipeline(VulkrDevice &device, const std::string &compFilepath, VkPipelineLayout pipelineLayout);
+
+        ~VulkrComputePipeline();
+
+        VulkrComputePipeline(const VulkrComputePipeline &) = delete;
+
+        VulkrComputePipeline &operator=(const VulkrComputePipeline &) = delete;
+
+        void bind(VkCommandBuffer commandBuffer);
+
+        uint64_t getLastUsedFrameValue() const { return lastUsedFrameValue; }
+
+    private:
+        VulkrDevice &vulkrDevice;
+        VkPipeline computePipeline = VK_NULL_HANDLE;
+        uint64_t lastUsedFrameValue{0};
+    };
+}
+
+#endif //VULKR_COMPUTE_PIPELINE_H
@@ -0,0 +1,85 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "vulkr_deletion_queue.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace vulkr {
+    VulkrDeletionQueue::VulkrDeletionQueue(VkDevice device, VulkrFrameTimeline &timeline)
+        : device(device), timeline(timeline) {
+    }
+
+    VulkrDeletionQueue::~VulkrDeletionQueue() {
+        flush();
+    }
+
+    void VulkrDeletionQueue::retire(uint64_t frameValue, std::function<void()> destroy) {
+        if (timeline.isComplete(frameValue)) {
+            destroy();
+            return;
+        }
+        entries.push_back({frameValue, std::move(destroy)});
+    }
+
+    void VulkrDeletionQueue::retireBuffer(VkBuffer buffer, VkDeviceMemory memory, uint64_t frameValue) {
+        VkDevice vkDevice = device;
+        retire(frameValue, [vkDevice, buffer, memory]() {
+            vkDestroyBuffer(vkDevice, buffer, nullptr);
+            vkFreeMemory(vkDevice, memory, nullptr);
+        });
+    }
+
+    void VulkrDeletionQueue::retireImage(VkImage image, VkImageView imageView, VkDeviceMemory memory,
+                                         uint64_t frameValue) {
+        VkDevice vkDevice = device;
+        retire(frameValue, [vkDevice, image, imageView, memory]() {
+            if (imageView != VK_NULL_HANDLE) {
+                vkDestroyImageView(vkDevice, imageView, nullptr);
+            }
+            vkDestroyImage(vkDevice, image, nullptr);
+            if (memory != VK_NULL_HANDLE) {
+                vkFreeMemory(vkDevice, memory, nullptr);
+            }
+        });
+    }
+
+    void VulkrDeletionQueue::retirePipeline(VkPipeline pipeline, uint64_t frameValue) {
+        VkDevice vkDevice = device;
+        retire(frameValue, [vkDevice, pipeline]() {
+            vkDestroyPipeline(vkDevice, pipeline, nullptr);
+        });
+    }
+
+    void VulkrDeletionQueue::collect() {
+        if (entries.empty()) {
+            return;
+        }
+
+        const uint64_t completed = timeline.getCompletedValue();
+
+        // entries are retired in last-use order, not submission order, so scan them all
+        auto pending = std::stable_partition(entries.begin(), entries.end(), [completed](const Entry &entry) {
+            return entry.frameValue > completed;
+        });
+        std::vector<Entry> ready(std::make_move_iterator(pending), std::make_move_iterator(entries.end()));
+        entries.erase(pending, entries.end());
+
+        for (auto &entry: ready) {
+            entry.destroy();
+        }
+    }
+
+    void VulkrDeletionQueue::flush() {
+        // destroy callbacks may retire further objects, so keep draining until nothing is left
+        while (!entries.empty()) {
+            std::vector<Entry> ready = std::move(entries);
+            entries.clear();
+            for (auto &entry: ready) {
+                entry.destroy();
+            }
+        }
+    }
+}
@@ -0,0 +1,63 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef VULKR_DELETION_QUEUE_H
+#define VULKR_DELETION_QUEUE_H
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "vulkr_frame_timeline.h"
+
+namespace vulkr {
+    /**
+     * Defers destruction of GPU objects until the frame that last used them has completed on the frame
+     * timeline. Lets models, pipelines and swap chains go away mid-session without vkDeviceWaitIdle.
+     */
+    class VulkrDeletionQueue {
+    public:
+        VulkrDeletionQueue(VkDevice device, VulkrFrameTimeline &timeline);
+
+        ~VulkrDeletionQueue();
+
+        VulkrDeletionQueue(const VulkrDeletionQueue &) = delete;
+
+        VulkrDeletionQueue &operator=(const VulkrDeletionQueue &) = delete;
+
+        void retire(uint64_t frameValue, std::function<void()> destroy);
+
+        void retireBuffer(VkBuffer buffer, VkDeviceMemory memory, uint64_t frameValue);
+
+        void retireImage(VkImage image, VkImageView imageView, VkDeviceMemory memory, uint64_t frameValue);
+
+        void retirePipeline(VkPipeline pipeline, uint64_t frameValue);
+
+        /**
+         * Destroys everything whose frame has completed. Called once per frame by the renderer.
+         */
+        void collect();
+
+        /**
+         * Destroys everything regardless of frame state, the device must be idle.
+         */
+        void flush();
+
+        size_t pendingCount() const { return entries.size(); }
+
+    private:
+        struct Entry {
+            uint64_t frameValue;
+            std::function<void()> destroy;
+        };
+
+        VkDevice device;
+        VulkrFrameTimeline &timeline;
+        std::vector<Entry> entries;
+    };
+}
+
+#endif //VULKR_DELETION_QUEUE_H
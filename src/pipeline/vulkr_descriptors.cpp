@@ -0,0 +1,186 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "vulkr_descriptors.h"
+
+#include <cassert>
+#include <stdexcept>
+
+namespace vulkr {
+    // *************** Descriptor Set Layout Builder *********************
+
+    VulkrDescriptorSetLayout::Builder &VulkrDescriptorSetLayout::Builder::addBinding(
+        uint32_t binding, VkDescriptorType descriptorType, VkShaderStageFlags stageFlags, uint32_t count) {
+        assert(bindings.count(binding) == 0 && "Binding already in use");
+        VkDescriptorSetLayoutBinding layoutBinding{};
+        layoutBinding.binding = binding;
+        layoutBinding.descriptorType = descriptorType;
+        layoutBinding.descriptorCount = count;
+        layoutBinding.stageFlags = stageFlags;
+        bindings[binding] = layoutBinding;
+        return *this;
+    }
+
+    std::unique_ptr<VulkrDescriptorSetLayout> VulkrDescriptorSetLayout::Builder::build() const {
+        return std::make_unique<VulkrDescriptorSetLayout>(vulkrDevice, bindings);
+    }
+
+    // *************** Descriptor Set Layout *********************
+
+    VulkrDescriptorSetLayout::VulkrDescriptorSetLayout(
+        VulkrDevice &vulkrDevice, std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> bindings)
+        : vulkrDevice{vulkrDevice}, bindings{bindings} {
+        std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings{};
+        for (auto kv: bindings) {
+            setLayoutBindings.push_back(kv.second);
+        }
+
+        VkDescriptorSetLayoutCreateInfo descriptorSetLayoutInfo{};
+        descriptorSetLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        descriptorSetLayoutInfo.bindingCount = static_cast<uint32_t>(setLayoutBindings.size());
+        descriptorSetLayoutInfo.pBindings = setLayoutBindings.data();
+
+        if (vkCreateDescriptorSetLayout(vulkrDevice.device(), &descriptorSetLayoutInfo, nullptr,
+                                        &descriptorSetLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create descriptor set layout!");
+        }
+    }
+
+    VulkrDescriptorSetLayout::~VulkrDescriptorSetLayout() {
+        vkDestroyDescriptorSetLayout(vulkrDevice.device(), descriptorSetLayout, nullptr);
+    }
+
+    // *************** Descriptor Pool Builder *********************
+
+    VulkrDescriptorPool::Builder &VulkrDescriptorPool::Builder::addPoolSize(
+        VkDescriptorType descriptorType, uint32_t count) {
+        poolSizes.push_back({descriptorType, count});
+        return *this;
+    }
+
+    VulkrDescriptorPool::Builder &VulkrDescriptorPool::Builder::setPoolFlags(VkDescriptorPoolCreateFlags flags) {
+        poolFlags = flags;
+        return *this;
+    }
+
+    VulkrDescriptorPool::Builder &VulkrDescriptorPool::Builder::setMaxSets(uint32_t count) {
+        maxSets = count;
+        return *this;
+    }
+
+    std::unique_ptr<VulkrDescriptorPool> VulkrDescriptorPool::Builder::build() const {
+        return std::make_unique<VulkrDescriptorPool>(vulkrDevice, maxSets, poolFlags, poolSizes);
+    }
+
+    // *************** Descriptor Pool *********************
+
+    VulkrDescriptorPool::VulkrDescriptorPool(VulkrDevice &vulkrDevice, uint32_t maxSets,
+                                             VkDescriptorPoolCreateFlags poolFlags,
+                                             const std::vector<VkDescriptorPoolSize> &poolSizes)
+        : vulkrDevice{vulkrDevice} {
+        VkDescriptorPoolCreateInfo descriptorPoolInfo{};
+        descriptorPoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        descriptorPoolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        descriptorPoolInfo.pPoolSizes = poolSizes.data();
+        descriptorPoolInfo.maxSets = maxSets;
+        descriptorPoolInfo.flags = poolFlags;
+
+        if (vkCreateDescriptorPool(vulkrDevice.device(), &descriptorPoolInfo, nullptr, &descriptorPool) !=
+            VK_SUCCESS) {
+            throw std::runtime_error("failed to create descriptor pool!");
+        }
+    }
+
+    VulkrDescriptorPool::~VulkrDescriptorPool() {
+        vkDestroyDescriptorPool(vulkrDevice.device(), descriptorPool, nullptr);
+    }
+
+    bool VulkrDescriptorPool::allocateDescriptor(const VkDescriptorSetLayout descriptorSetLayout,
+                                                 VkDescriptorSet &descriptor) const {
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.pSetLayouts = &descriptorSetLayout;
+        allocInfo.descriptorSetCount = 1;
+
+        // Might want to create a "DescriptorPoolManager" class that handles this case, and builds
+        // a new pool whenever an old pool fills up. But this is beyond our current scope
+        if (vkAllocateDescriptorSets(vulkrDevice.device(), &allocInfo, &descriptor) != VK_SUCCESS) {
+            return false;
+        }
+        return true;
+    }
+
+    void VulkrDescriptorPool::freeDescriptors(std::vector<VkDescriptorSet> &descriptors) const {
+        vkFreeDescriptorSets(vulkrDevice.device(), descriptorPool, static_cast<uint32_t>(descriptors.size()),
+                             descriptors.data());
+    }
+
+    void VulkrDescriptorPool::resetPool() {
+        vkResetDescriptorPool(vulkrDevice.device(), descriptorPool, 0);
+    }
+
+    // *************** Descriptor Writer *********************
+
+    VulkrDescriptorWriter::VulkrDescriptorWriter(VulkrDescriptorSetLayout &setLayout, VulkrDescriptorPool &pool)
+        : setLayout{setLayout}, pool{pool} {
+    }
+
+    VulkrDescriptorWriter &VulkrDescriptorWriter::writeBuffer(uint32_t binding,
+                                                              const VkDescriptorBufferInfo *bufferInfo) {
+        assert(setLayout.bindings.count(binding) == 1 && "Layout does not contain specified binding");
+
+        auto &bindingDescription = setLayout.bindings[binding];
+
+        assert(bindingDescription.descriptorCount == 1 &&
+            "Binding single descriptor info, but binding expects multiple");
+
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.descriptorType = bindingDescription.descriptorType;
+        write.dstBinding = binding;
+        write.pBufferInfo = bufferInfo;
+        write.descriptorCount = 1;
+
+        writes.push_back(write);
+        return *this;
+    }
+
+    VulkrDescriptorWriter &VulkrDescriptorWriter::writeImage(uint32_t binding,
+                                                             const VkDescriptorImageInfo *imageInfo) {
+        assert(setLayout.bindings.count(binding) == 1 && "Layout does not contain specified binding");
+
+        auto &bindingDescription = setLayout.bindings[binding];
+
+        assert(bindingDescription.descriptorCount == 1 &&
+            "Binding single descriptor info, but binding expects multiple");
+
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.descriptorType = bindingDescription.descriptorType;
+        write.dstBinding = binding;
+        write.pImageInfo = imageInfo;
+        write.descriptorCount = 1;
+
+        writes.push_back(write);
+        return *this;
+    }
+
+    bool VulkrDescriptorWriter::build(VkDescriptorSet &set) {
+        bool success = pool.allocateDescriptor(setLayout.getDescriptorSetLayout(), set);
+        if (!success) {
+            return false;
+        }
+        overwrite(set);
+        return true;
+    }
+
+    void VulkrDescriptorWriter::overwrite(VkDescriptorSet &set) {
+        for (auto &write: writes) {
+            write.dstSet = set;
+        }
+        vkUpdateDescriptorSets(pool.vulkrDevice.device(), static_cast<uint32_t>(writes.size()), writes.data(), 0,
+                               nullptr);
+    }
+}
@@ -0,0 +1,114 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef VULKR_DESCRIPTORS_H
+#define VULKR_DESCRIPTORS_H
+
+#include "vulkr_device.hpp"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace vulkr {
+    class VulkrDescriptorSetLayout {
+    public:
+        class Builder {
+        public:
+            Builder(VulkrDevice &vulkrDevice) : vulkrDevice{vulkrDevice} {
+            }
+
+            Builder &addBinding(uint32_t binding, VkDescriptorType descriptorType, VkShaderStageFlags stageFlags,
+                                uint32_t count = 1);
+
+            std::unique_ptr<VulkrDescriptorSetLayout> build() const;
+
+        private:
+            VulkrDevice &vulkrDevice;
+            std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> bindings{};
+        };
+
+        VulkrDescriptorSetLayout(VulkrDevice &vulkrDevice,
+                                 std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> bindings);
+
+        ~VulkrDescriptorSetLayout();
+
+        VulkrDescriptorSetLayout(const VulkrDescriptorSetLayout &) = delete;
+
+        VulkrDescriptorSetLayout &operator=(const VulkrDescriptorSetLayout &) = delete;
+
+        VkDescriptorSetLayout getDescriptorSetLayout() const { return descriptorSetLayout; }
+
+    private:
+        VulkrDevice &vulkrDevice;
+        VkDescriptorSetLayout descriptorSetLayout;
+        std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> bindings;
+
+        friend class VulkrDescriptorWriter;
+    };
+
+    class VulkrDescriptorPool {
+    public:
+        class Builder {
+        public:
+            Builder(VulkrDevice &vulkrDevice) : vulkrDevice{vulkrDevice} {
+            }
+
+            Builder &addPoolSize(VkDescriptorType descriptorType, uint32_t count);
+
+            Builder &setPoolFlags(VkDescriptorPoolCreateFlags flags);
+
+            Builder &setMaxSets(uint32_t count);
+
+            std::unique_ptr<VulkrDescriptorPool> build() const;
+
+        private:
+            VulkrDevice &vulkrDevice;
+            std::vector<VkDescriptorPoolSize> poolSizes{};
+            uint32_t maxSets = 1000;
+            VkDescriptorPoolCreateFlags poolFlags = 0;
+        };
+
+        VulkrDescriptorPool(VulkrDevice &vulkrDevice, uint32_t maxSets, VkDescriptorPoolCreateFlags poolFlags,
+                            const std::vector<VkDescriptorPoolSize> &poolSizes);
+
+        ~VulkrDescriptorPool();
+
+        VulkrDescriptorPool(const VulkrDescriptorPool &) = delete;
+
+        VulkrDescriptorPool &operator=(const VulkrDescriptorPool &) = delete;
+
+        bool allocateDescriptor(VkDescriptorSetLayout descriptorSetLayout, VkDescriptorSet &descriptor) const;
+
+        void freeDescriptors(std::vector<VkDescriptorSet> &descriptors) const;
+
+        void resetPool();
+
+    private:
+        VulkrDevice &vulkrDevice;
+        VkDescriptorPool descriptorPool;
+
+        friend class VulkrDescriptorWriter;
+    };
+
+    class VulkrDescriptorWriter {
+    public:
+        VulkrDescriptorWriter(VulkrDescriptorSetLayout &setLayout, VulkrDescriptorPool &pool);
+
+        VulkrDescriptorWriter &writeBuffer(uint32_t binding, const VkDescriptorBufferInfo *bufferInfo);
+
+        VulkrDescriptorWriter &writeImage(uint32_t binding, const VkDescriptorImageInfo *imageInfo);
+
+        bool build(VkDescriptorSet &set);
+
+        void overwrite(VkDescriptorSet &set);
+
+    private:
+        VulkrDescriptorSetLayout &setLayout;
+        VulkrDescriptorPool &pool;
+        std::vector<VkWriteDescriptorSet> writes;
+    };
+}
+
+#endif //VULKR_DESCRIPTORS_H
@@ -1,6 +1,7 @@
 #include "vulkr_device.hpp"
 
 // std headers
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <set>
@@ -53,9 +54,14 @@ namespace vulkr {
     pickPhysicalDevice();
     createLogicalDevice();
     createCommandPool();
+    createFrameTimeline();
   }
 
   VulkrDevice::~VulkrDevice() {
+    // anything still queued may be referenced by in-flight frames
+    vkDeviceWaitIdle(device_);
+    deletionQueue_.reset();
+    frameTimeline_.reset();
     vkDestroyCommandPool(device_, commandPool, nullptr);
     vkDestroyDevice(device_, nullptr);
 
@@ -78,7 +84,15 @@ namespace vulkr {
     appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
     appInfo.pEngineName = "No Engine";
     appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-    appInfo.apiVersion = VK_API_VERSION_1_0;
+    // 1.0 loaders don't have vkEnumerateInstanceVersion and reject any apiVersion above 1.0
+    auto enumerateInstanceVersion = reinterpret_cast<PFN_vkEnumerateInstanceVersion>(
+      vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceVersion"));
+    if (enumerateInstanceVersion != nullptr) {
+      enumerateInstanceVersion(&instanceApiVersion);
+    }
+    // nothing past 1.2 is used, older instances keep the fence based frame sync
+    instanceApiVersion = std::min(instanceApiVersion, VK_API_VERSION_1_2);
+    appInfo.apiVersion = instanceApiVersion;
 
     VkInstanceCreateInfo createInfo = {};
     createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -130,6 +144,35 @@ namespace vulkr {
 
     vkGetPhysicalDeviceProperties(physicalDevice, &properties);
     std::cout << "physical device: " << properties.deviceName << std::endl;
+    const uint32_t apiVersion = std::min(properties.apiVersion, instanceApiVersion);
+
+    // timeline semaphores are core in 1.2, older devices keep the fence based frame sync
+    if (apiVersion >= VK_API_VERSION_1_2) {
+      VkPhysicalDeviceVulkan12Features vulkan12Features{};
+      vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+      VkPhysicalDeviceFeatures2 features2{};
+      features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+      features2.pNext = &vulkan12Features;
+      vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+
+      timelineSemaphoresSupported = vulkan12Features.timelineSemaphore == VK_TRUE;
+    }
+
+    // optional, the texture streamer falls back to its configured budget without it
+    if (apiVersion >= VK_API_VERSION_1_1) {
+      uint32_t extensionCount;
+      vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+      std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+      vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, availableExtensions.data());
+      for (const auto &extension: availableExtensions) {
+        if (std::strcmp(extension.extensionName, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == 0) {
+          memoryBudgetSupported = true;
+        }
+      }
+    }
+    std::cout << "timeline semaphores: " << (timelineSemaphoresSupported ? "yes" : "no") << std::endl;
+    std::cout << "memory budget: " << (memoryBudgetSupported ? "yes" : "no") << std::endl;
   }
 
   void VulkrDevice::createLogicalDevice() {
@@ -150,6 +193,8 @@ namespace vulkr {
 
     VkPhysicalDeviceFeatures deviceFeatures = {};
     deviceFeatures.samplerAnisotropy = VK_TRUE;
+    // texture streaming feedback is written with atomics from the fragment shader
+    deviceFeatures.fragmentStoresAndAtomics = VK_TRUE;
 
     VkDeviceCreateInfo createInfo = {};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -158,8 +203,19 @@ namespace vulkr {
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
 
     createInfo.pEnabledFeatures = &deviceFeatures;
-    createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
-    createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+
+    VkPhysicalDeviceVulkan12Features vulkan12Features{};
+    vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    vulkan12Features.timelineSemaphore = timelineSemaphoresSupported ? VK_TRUE : VK_FALSE;
+    if (timelineSemaphoresSupported) {
+      createInfo.pNext = &vulkan12Features;
+    }
+    std::vector<const char *> extensions = deviceExtensions;
+    if (memoryBudgetSupported) {
+      extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    }
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    createInfo.ppEnabledExtensionNames = extensions.data();
 
     // might not really be necessary anymore because device specific validation layers
     // have been deprecated
@@ -192,6 +248,11 @@ namespace vulkr {
     }
   }
 
+  void VulkrDevice::createFrameTimeline() {
+    frameTimeline_ = std::make_unique<VulkrFrameTimeline>(device_, timelineSemaphoresSupported);
+    deletionQueue_ = std::make_unique<VulkrDeletionQueue>(device_, *frameTimeline_);
+  }
+
   void VulkrDevice::createSurface() { window.createWindowSurface(instance, &surface_); }
 
   bool VulkrDevice::isDeviceSuitable(VkPhysicalDevice device) {
@@ -209,7 +270,7 @@ namespace vulkr {
     vkGetPhysicalDeviceFeatures(device, &supportedFeatures);
 
     return indices.isComplete() && extensionsSupported && swapChainAdequate &&
-           supportedFeatures.samplerAnisotropy;
+           supportedFeatures.samplerAnisotropy && supportedFeatures.fragmentStoresAndAtomics;
   }
 
   void VulkrDevice::populateDebugMessengerCreateInfo(
@@ -389,17 +450,71 @@ namespace vulkr {
     throw std::runtime_error("failed to find supported format!");
   }
 
+  bool VulkrDevice::supportsFormatFeatures(VkFormat format, VkImageTiling tiling, VkFormatFeatureFlags features) {
+    VkFormatProperties props;
+    vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &props);
+    const VkFormatFeatureFlags supported =
+        tiling == VK_IMAGE_TILING_LINEAR ? props.linearTilingFeatures : props.optimalTilingFeatures;
+    return (supported & features) == features;
+  }
+
+  MemoryBudget VulkrDevice::getDeviceLocalMemoryBudget() {
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{};
+    budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+    VkPhysicalDeviceMemoryProperties2 memoryProperties{};
+    memoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    if (memoryBudgetSupported) {
+      memoryProperties.pNext = &budgetProperties;
+      vkGetPhysicalDeviceMemoryProperties2(physicalDevice, &memoryProperties);
+    } else {
+      vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties.memoryProperties);
+    }
+
+    MemoryBudget result{};
+    const VkPhysicalDeviceMemoryProperties &heaps = memoryProperties.memoryProperties;
+    for (uint32_t i = 0; i < heaps.memoryHeapCount; i++) {
+      if ((heaps.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) == 0) continue;
+      if (memoryBudgetSupported) {
+        result.budget += budgetProperties.heapBudget[i];
+        result.usage += budgetProperties.heapUsage[i];
+      } else {
+        result.budget += heaps.memoryHeaps[i].size;
+      }
+    }
+    return result;
+  }
+
   uint32_t VulkrDevice::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
+    uint32_t typeIndex;
+    if (tryFindMemoryType(typeFilter, properties, typeIndex)) {
+      return typeIndex;
+    }
+
+    throw std::runtime_error("failed to find suitable memory type!");
+  }
+
+  bool VulkrDevice::tryFindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties, uint32_t &typeIndex) {
     VkPhysicalDeviceMemoryProperties memProperties;
     vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
     for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
       if ((typeFilter & (1 << i)) &&
           (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-        return i;
+        typeIndex = i;
+        return true;
       }
     }
+    return false;
+  }
 
-    throw std::runtime_error("failed to find suitable memory type!");
+  uint32_t VulkrDevice::findTransientMemoryType(uint32_t typeFilter) {
+    // tilers keep lazily allocated attachments in tile memory and never back them with real pages
+    uint32_t typeIndex;
+    if (tryFindMemoryType(typeFilter, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT,
+                          typeIndex)) {
+      return typeIndex;
+    }
+    return findMemoryType(typeFilter, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
   }
 
   void VulkrDevice::createBuffer(
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "../window/vulkr_window.h"
+#include "vulkr_deletion_queue.h"
+#include "vulkr_frame_timeline.h"
 
 // std lib headers
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -13,6 +16,16 @@ namespace vulkr {
         std::vector<VkPresentModeKHR> presentModes;
     };
 
+    /**
+     * Device local memory summed over the heaps that have it.
+     */
+    struct MemoryBudget {
+        // what the process may allocate before the driver starts paging, the heap size without VK_EXT_memory_budget
+        VkDeviceSize budget{0};
+        // allocated by the process, 0 without VK_EXT_memory_budget
+        VkDeviceSize usage{0};
+    };
+
     struct QueueFamilyIndices {
         uint32_t graphicsFamily;
         uint32_t presentFamily;
@@ -44,19 +57,38 @@ namespace vulkr {
 
         VkCommandPool getCommandPool() const { return commandPool; }
         VkDevice device() const { return device_; }
+        VkPhysicalDevice getPhysicalDevice() const { return physicalDevice; }
         VkSurfaceKHR surface() const { return surface_; }
         VkQueue graphicsQueue() const { return graphicsQueue_; }
         VkQueue presentQueue() const { return presentQueue_; }
+        VulkrFrameTimeline &frameTimeline() const { return *frameTimeline_; }
+        VulkrDeletionQueue &deletionQueue() const { return *deletionQueue_; }
+        bool supportsTimelineSemaphores() const { return timelineSemaphoresSupported; }
+        bool supportsMemoryBudget() const { return memoryBudgetSupported; }
 
         SwapChainSupportDetails getSwapChainSupport() { return querySwapChainSupport(physicalDevice); }
 
         uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
 
+        bool tryFindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties, uint32_t &typeIndex);
+
+        /**
+         * Lazily allocated device local memory when the device has it, plain device local memory otherwise.
+         */
+        uint32_t findTransientMemoryType(uint32_t typeFilter);
+
         QueueFamilyIndices findPhysicalQueueFamilies() { return findQueueFamilies(physicalDevice); }
 
         VkFormat findSupportedFormat(
             const std::vector<VkFormat> &candidates, VkImageTiling tiling, VkFormatFeatureFlags features);
 
+        bool supportsFormatFeatures(VkFormat format, VkImageTiling tiling, VkFormatFeatureFlags features);
+
+        /**
+         * Queried every call, the budget follows what other processes hold on the GPU.
+         */
+        MemoryBudget getDeviceLocalMemoryBudget();
+
         // Buffer Helper Functions
         void createBuffer(
             VkDeviceSize size,
@@ -95,6 +127,8 @@ namespace vulkr {
 
         void createCommandPool();
 
+        void createFrameTimeline();
+
         // helper functions
         bool isDeviceSuitable(VkPhysicalDevice device);
 
@@ -123,6 +157,13 @@ namespace vulkr {
         VkQueue graphicsQueue_;
         VkQueue presentQueue_;
 
+        // the instance version, the device's own version is only usable up to it
+        uint32_t instanceApiVersion = VK_API_VERSION_1_0;
+        bool timelineSemaphoresSupported = false;
+        bool memoryBudgetSupported = false;
+        std::unique_ptr<VulkrFrameTimeline> frameTimeline_;
+        std::unique_ptr<VulkrDeletionQueue> deletionQueue_;
+
         const std::vector<const char *> validationLayers = {"VK_LAYER_KHRONOS_validation"};
         const std::vector<const char *> deviceExtensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
     };
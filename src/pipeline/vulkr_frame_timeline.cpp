@@ -0,0 +1,77 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "vulkr_frame_timeline.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace vulkr {
+    VulkrFrameTimeline::VulkrFrameTimeline(VkDevice device, bool useTimelineSemaphore) : device(device) {
+        if (!useTimelineSemaphore) {
+            return;
+        }
+
+        VkSemaphoreTypeCreateInfo typeInfo{};
+        typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeInfo.initialValue = 0;
+
+        VkSemaphoreCreateInfo semaphoreInfo{};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreInfo.pNext = &typeInfo;
+
+        if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create frame timeline semaphore!");
+        }
+    }
+
+    VulkrFrameTimeline::~VulkrFrameTimeline() {
+        if (semaphore != VK_NULL_HANDLE) {
+            vkDestroySemaphore(device, semaphore, nullptr);
+        }
+    }
+
+    uint64_t VulkrFrameTimeline::getCompletedValue() {
+        if (usesTimelineSemaphore()) {
+            uint64_t value = 0;
+            if (vkGetSemaphoreCounterValue(device, semaphore, &value) != VK_SUCCESS) {
+                throw std::runtime_error("failed to query frame timeline value!");
+            }
+            completedValue = std::max(completedValue, value);
+        }
+        return completedValue;
+    }
+
+    bool VulkrFrameTimeline::isComplete(uint64_t value) {
+        // avoid the driver round trip when the cached value already answers the question
+        return value <= completedValue || value <= getCompletedValue();
+    }
+
+    void VulkrFrameTimeline::wait(uint64_t value) {
+        if (value <= completedValue) {
+            return;
+        }
+
+        if (!usesTimelineSemaphore()) {
+            throw std::runtime_error("cannot wait on the frame timeline without timeline semaphore support!");
+        }
+
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &semaphore;
+        waitInfo.pValues = &value;
+
+        if (vkWaitSemaphores(device, &waitInfo, std::numeric_limits<uint64_t>::max()) != VK_SUCCESS) {
+            throw std::runtime_error("failed to wait on frame timeline!");
+        }
+        completedValue = std::max(completedValue, value);
+    }
+
+    void VulkrFrameTimeline::markCompleted(uint64_t value) {
+        completedValue = std::max(completedValue, value);
+    }
+}
@@ -0,0 +1,58 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef VULKR_FRAME_TIMELINE_H
+#define VULKR_FRAME_TIMELINE_H
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+
+namespace vulkr {
+    /**
+     * Monotonically increasing frame counter backed by a timeline semaphore (Vulkan 1.2 core).
+     * Every submitted frame signals its own value, so "has the GPU finished with X" becomes a single
+     * comparison against the value X was last used at, and CPU waits are one vkWaitSemaphores call.
+     * When timeline semaphores are unavailable the swap chain falls back to fences and reports
+     * completed values through markCompleted().
+     */
+    class VulkrFrameTimeline {
+    public:
+        VulkrFrameTimeline(VkDevice device, bool useTimelineSemaphore);
+
+        ~VulkrFrameTimeline();
+
+        VulkrFrameTimeline(const VulkrFrameTimeline &) = delete;
+
+        VulkrFrameTimeline &operator=(const VulkrFrameTimeline &) = delete;
+
+        bool usesTimelineSemaphore() const { return semaphore != VK_NULL_HANDLE; }
+        VkSemaphore getSemaphore() const { return semaphore; }
+
+        /**
+         * Value signalled once the frame currently being recorded (or, between frames, the last
+         * submitted frame) has completed on the GPU.
+         */
+        uint64_t getCurrentValue() const { return currentValue; }
+
+        uint64_t advance() { return ++currentValue; }
+
+        uint64_t getCompletedValue();
+
+        bool isComplete(uint64_t value);
+
+        void wait(uint64_t value);
+
+        void markCompleted(uint64_t value);
+
+    private:
+        VkDevice device;
+        VkSemaphore semaphore = VK_NULL_HANDLE;
+
+        uint64_t currentValue = 0;
+        uint64_t completedValue = 0;
+    };
+}
+
+#endif //VULKR_FRAME_TIMELINE_H
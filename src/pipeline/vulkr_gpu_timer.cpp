@@ -0,0 +1,99 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "vulkr_gpu_timer.h"
+
+#include <stdexcept>
+
+namespace vulkr {
+    VulkrGpuTimer::VulkrGpuTimer(VulkrDevice &device, uint32_t frameCount)
+        : device(device), pending(frameCount, false) {
+        // without this limit some graphics queues may not support timestamps at all
+        if (!device.properties.limits.timestampComputeAndGraphics) {
+            return;
+        }
+        timestampPeriod = device.properties.limits.timestampPeriod;
+
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(device.getPhysicalDevice(), &queueFamilyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(device.getPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+        const uint32_t validBits = queueFamilies[device.findPhysicalQueueFamilies().graphicsFamily].timestampValidBits;
+        if (validBits == 0) {
+            return;
+        }
+        timestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+
+        VkQueryPoolCreateInfo queryPoolInfo{};
+        queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        queryPoolInfo.queryCount = frameCount * 2;
+
+        if (vkCreateQueryPool(device.device(), &queryPoolInfo, nullptr, &queryPool) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create timestamp query pool!");
+        }
+    }
+
+    VulkrGpuTimer::~VulkrGpuTimer() {
+        if (queryPool == VK_NULL_HANDLE) {
+            return;
+        }
+
+        VkDevice vkDevice = device.device();
+        VkQueryPool pool = queryPool;
+        device.deletionQueue().retire(device.frameTimeline().getCurrentValue(), [vkDevice, pool]() {
+            vkDestroyQueryPool(vkDevice, pool, nullptr);
+        });
+    }
+
+    void VulkrGpuTimer::begin(VkCommandBuffer commandBuffer, int frameIndex) {
+        if (!isSupported()) {
+            return;
+        }
+
+        const uint32_t firstQuery = static_cast<uint32_t>(frameIndex) * 2;
+        vkCmdResetQueryPool(commandBuffer, queryPool, firstQuery, 2);
+        // the submit waits for the swap chain image at this stage, so time spent blocked on acquire, vsync or
+        // present is not counted as GPU work
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, queryPool, firstQuery);
+    }
+
+    void VulkrGpuTimer::end(VkCommandBuffer commandBuffer, int frameIndex) {
+        if (!isSupported()) {
+            return;
+        }
+
+        const uint32_t firstQuery = static_cast<uint32_t>(frameIndex) * 2;
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, firstQuery + 1);
+        pending[frameIndex] = true;
+    }
+
+    bool VulkrGpuTimer::readMilliseconds(int frameIndex, float &milliseconds) {
+        if (!isSupported() || !pending[frameIndex]) {
+            return false;
+        }
+
+        uint64_t timestamps[2] = {};
+        const VkResult result = vkGetQueryPoolResults(
+            device.device(),
+            queryPool,
+            static_cast<uint32_t>(frameIndex) * 2,
+            2,
+            sizeof(timestamps),
+            timestamps,
+            sizeof(uint64_t),
+            VK_QUERY_RESULT_64_BIT);
+
+        if (result != VK_SUCCESS) {
+            return false;
+        }
+
+        pending[frameIndex] = false;
+        // only the valid bits count, the subtraction wraps within them
+        const uint64_t ticks = ((timestamps[1] & timestampMask) - (timestamps[0] & timestampMask)) & timestampMask;
+        milliseconds = static_cast<float>(ticks) * timestampPeriod / 1000000.0f;
+        return true;
+    }
+}
@@ -0,0 +1,49 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef VULKR_GPU_TIMER_H
+#define VULKR_GPU_TIMER_H
+
+#include "vulkr_device.hpp"
+
+#include <vector>
+
+namespace vulkr {
+    /**
+     * Measures GPU time of a frame with a pair of timestamp queries per frame slot, starting once the frame's
+     * swap chain image is available.
+     * Results are read back the next time the slot comes around, after the renderer has waited on it,
+     * so reading never stalls.
+     */
+    class VulkrGpuTimer {
+    public:
+        VulkrGpuTimer(VulkrDevice &device, uint32_t frameCount);
+
+        ~VulkrGpuTimer();
+
+        VulkrGpuTimer(const VulkrGpuTimer &) = delete;
+
+        VulkrGpuTimer &operator=(const VulkrGpuTimer &) = delete;
+
+        bool isSupported() const { return queryPool != VK_NULL_HANDLE; }
+
+        void begin(VkCommandBuffer commandBuffer, int frameIndex);
+
+        void end(VkCommandBuffer commandBuffer, int frameIndex);
+
+        /**
+         * Returns false if the slot has no finished measurement.
+         */
+        bool readMilliseconds(int frameIndex, float &milliseconds);
+
+    private:
+        VulkrDevice &device;
+        VkQueryPool queryPool = VK_NULL_HANDLE;
+        float timestampPeriod = 1.0f;
+        uint64_t timestampMask = ~0ull;
+        std::vector<bool> pending;
+    };
+}
+
+#endif //VULKR_GPU_TIMER_H
@@ -20,11 +20,14 @@ namespace vulkr {
 
     VulkrPipeline::~VulkrPipeline() {
         vkDestroyShaderModule(vulkrDevice.device(), vertShaderModule, nullptr);
-        vkDestroyShaderModule(vulkrDevice.device(), fragShaderModule, nullptr);
-        vkDestroyPipeline(vulkrDevice.device(), graphicsPipeline, nullptr);
+        if (fragShaderModule != VK_NULL_HANDLE) {
+            vkDestroyShaderModule(vulkrDevice.device(), fragShaderModule, nullptr);
+        }
+        vulkrDevice.deletionQueue().retirePipeline(graphicsPipeline, lastUsedFrameValue);
     }
 
     void VulkrPipeline::bind(VkCommandBuffer commandBuffer) {
+        lastUsedFrameValue = vulkrDevice.frameTimeline().getCurrentValue();
         vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
     }
 
@@ -100,6 +103,9 @@ namespace vulkr {
         configInfo.dynamicStateInfo.pDynamicStates = configInfo.dynamicStateEnables.data();
         configInfo.dynamicStateInfo.dynamicStateCount = static_cast<uint32_t>(configInfo.dynamicStateEnables.size());
         configInfo.dynamicStateInfo.flags = 0;
+
+        configInfo.bindingDescriptions = VulkrModel::Vertex::getBindingDescriptions();
+        configInfo.attributeDescriptions = VulkrModel::Vertex::getAttributeDescriptions();
     }
 
     std::vector<char> VulkrPipeline::readFile(const std::string &filepath) {
@@ -128,14 +134,18 @@ namespace vulkr {
             "Cannot create graphics pipeline: no renderPass provided in configinfo");
 
         const auto vertCode = readFile(vertFilepath);
-        const auto fragCode = readFile(fragFilepath);
 
         // print size
         std::cout << "Vertex shader code size: " << vertCode.size() << " bytes" << std::endl;
-        std::cout << "Fragment shader code size: " << fragCode.size() << " bytes" << std::endl;
-
         createShaderModule(vertCode, &vertShaderModule);
-        createShaderModule(fragCode, &fragShaderModule);
+
+        // no fragment shader means a depth-only pipeline, the rasterizer still writes depth
+        const bool hasFragmentStage = !fragFilepath.empty();
+        if (hasFragmentStage) {
+            const auto fragCode = readFile(fragFilepath);
+            std::cout << "Fragment shader code size: " << fragCode.size() << " bytes" << std::endl;
+            createShaderModule(fragCode, &fragShaderModule);
+        }
 
         // vertex
         VkPipelineShaderStageCreateInfo shaderStages[2];
@@ -156,8 +166,8 @@ namespace vulkr {
         shaderStages[1].flags = 0;
         shaderStages[1].pNext = nullptr;
 
-        auto bindingDescriptions = VulkrModel::Vertex::getBindingDescriptions();
-        auto attributeDescriptions = VulkrModel::Vertex::getAttributeDescriptions();
+        auto &bindingDescriptions = configInfo.bindingDescriptions;
+        auto &attributeDescriptions = configInfo.attributeDescriptions;
 
         VkPipelineVertexInputStateCreateInfo vertexInputInfo = {};
         vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
@@ -168,7 +178,7 @@ namespace vulkr {
 
         VkGraphicsPipelineCreateInfo pipelineInfo{};
         pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-        pipelineInfo.stageCount = 2;
+        pipelineInfo.stageCount = hasFragmentStage ? 2 : 1;
         pipelineInfo.pStages = shaderStages;
         pipelineInfo.pVertexInputState = &vertexInputInfo;
         pipelineInfo.pInputAssemblyState = &configInfo.inputAssemblyInfo;
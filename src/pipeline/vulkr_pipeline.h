@@ -16,6 +16,8 @@ namespace vulkr {
 
         PipelineConfigInfo &operator=(const PipelineConfigInfo &) = delete;
 
+        std::vector<VkVertexInputBindingDescription> bindingDescriptions{};
+        std::vector<VkVertexInputAttributeDescription> attributeDescriptions{};
         VkPipelineViewportStateCreateInfo viewportInfo;
         VkPipelineInputAssemblyStateCreateInfo inputAssemblyInfo;
         VkPipelineRasterizationStateCreateInfo rasterizationInfo;
@@ -34,6 +36,9 @@ namespace vulkr {
 
     class VulkrPipeline {
     public:
+        /**
+         * An empty fragFilepath creates a vertex-only pipeline, e.g. for depth pre-passes and shadow maps.
+         */
         VulkrPipeline(VulkrDevice &device, const std::string &vertFilepath, const std::string &fragFilepath,
                       const PipelineConfigInfo &configInfo);
 
@@ -45,11 +50,14 @@ namespace vulkr {
 
         void bind(VkCommandBuffer commandBuffer);
 
+        uint64_t getLastUsedFrameValue() const { return lastUsedFrameValue; }
+
         static void defaultPipelineConfigInfo(PipelineConfigInfo &configInfo);
 
-    private:
         static std::vector<char> readFile(const std::string &filepath);
 
+    private:
+
         void createGraphicsPipeline(const std::string &vertFilepath, const std::string &fragFilepath,
                                     const PipelineConfigInfo &configInfo);
 
@@ -57,9 +65,10 @@ namespace vulkr {
 
         VulkrDevice &vulkrDevice;
         VkPipeline graphicsPipeline;
+        uint64_t lastUsedFrameValue{0};
 
         VkShaderModule vertShaderModule;
-        VkShaderModule fragShaderModule;
+        VkShaderModule fragShaderModule = VK_NULL_HANDLE;
     };
 }
 
@@ -1,6 +1,7 @@
 #include "vulkr_swap_chain.hpp"
 
 // std
+#include <algorithm>
 #include <array>
 #include <cstdlib>
 #include <cstring>
@@ -24,10 +25,31 @@ namespace vulkr {
   void VulkrSwapChain::init() {
     createSwapChain();
     createImageViews();
-    createRenderPass();
-    createDepthResources();
-    createFramebuffers();
+    swapChainDepthFormat = findDepthFormat();
+    if (!adoptRenderPass()) {
+      createRenderPass();
+    }
     createSyncObjects();
+
+    if (oldSwapChain != nullptr) {
+      // keep the frame slots in step with the renderer's command buffers, which outlive the swap chain
+      currentFrame = oldSwapChain->currentFrame;
+      frameTimelineValues = oldSwapChain->frameTimelineValues;
+    }
+  }
+
+  bool VulkrSwapChain::adoptRenderPass() {
+    if (oldSwapChain == nullptr || oldSwapChain->renderPass == VK_NULL_HANDLE) {
+      return false;
+    }
+    if (oldSwapChain->swapChainImageFormat != swapChainImageFormat ||
+        oldSwapChain->swapChainDepthFormat != swapChainDepthFormat) {
+      return false;
+    }
+
+    renderPass = oldSwapChain->renderPass;
+    oldSwapChain->renderPass = VK_NULL_HANDLE;
+    return true;
   }
 
   VulkrSwapChain::~VulkrSwapChain() {
@@ -41,33 +63,33 @@ namespace vulkr {
       swapChain = nullptr;
     }
 
-    for (int i = 0; i < depthImages.size(); i++) {
-      vkDestroyImageView(device.device(), depthImageViews[i], nullptr);
-      vkDestroyImage(device.device(), depthImages[i], nullptr);
-      vkFreeMemory(device.device(), depthImageMemorys[i], nullptr);
+    if (renderPass != VK_NULL_HANDLE) {
+      vkDestroyRenderPass(device.device(), renderPass, nullptr);
     }
 
-    for (auto framebuffer: swapChainFramebuffers) {
-      vkDestroyFramebuffer(device.device(), framebuffer, nullptr);
-    }
-
-    vkDestroyRenderPass(device.device(), renderPass, nullptr);
-
     // cleanup synchronization objects
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
       vkDestroySemaphore(device.device(), renderFinishedSemaphores[i], nullptr);
       vkDestroySemaphore(device.device(), imageAvailableSemaphores[i], nullptr);
-      vkDestroyFence(device.device(), inFlightFences[i], nullptr);
+    }
+    for (auto fence: inFlightFences) {
+      vkDestroyFence(device.device(), fence, nullptr);
     }
   }
 
   VkResult VulkrSwapChain::acquireNextImage(uint32_t *imageIndex) {
-    vkWaitForFences(
-      device.device(),
-      1,
-      &inFlightFences[currentFrame],
-      VK_TRUE,
-      std::numeric_limits<uint64_t>::max());
+    auto &timeline = device.frameTimeline();
+    if (timeline.usesTimelineSemaphore()) {
+      timeline.wait(frameTimelineValues[currentFrame]);
+    } else {
+      vkWaitForFences(
+        device.device(),
+        1,
+        &inFlightFences[currentFrame],
+        VK_TRUE,
+        std::numeric_limits<uint64_t>::max());
+      timeline.markCompleted(frameTimelineValues[currentFrame]);
+    }
 
     VkResult result = vkAcquireNextImageKHR(
       device.device(),
@@ -81,11 +103,20 @@ namespace vulkr {
   }
 
   VkResult VulkrSwapChain::submitCommandBuffers(
-    const VkCommandBuffer *buffers, uint32_t *imageIndex) {
-    if (imagesInFlight[*imageIndex] != VK_NULL_HANDLE) {
-      vkWaitForFences(device.device(), 1, &imagesInFlight[*imageIndex], VK_TRUE, UINT64_MAX);
+    const VkCommandBuffer *buffers, uint32_t *imageIndex, uint64_t timelineValue) {
+    auto &timeline = device.frameTimeline();
+    const bool useTimeline = timeline.usesTimelineSemaphore();
+
+    if (useTimeline) {
+      timeline.wait(imageTimelineValues[*imageIndex]);
+      imageTimelineValues[*imageIndex] = timelineValue;
+    } else {
+      if (imagesInFlight[*imageIndex] != VK_NULL_HANDLE) {
+        vkWaitForFences(device.device(), 1, &imagesInFlight[*imageIndex], VK_TRUE, UINT64_MAX);
+      }
+      imagesInFlight[*imageIndex] = inFlightFences[currentFrame];
     }
-    imagesInFlight[*imageIndex] = inFlightFences[currentFrame];
+    frameTimelineValues[currentFrame] = timelineValue;
 
     VkSubmitInfo submitInfo = {};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -99,13 +130,29 @@ namespace vulkr {
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = buffers;
 
-    VkSemaphore signalSemaphores[] = {renderFinishedSemaphores[currentFrame]};
-    submitInfo.signalSemaphoreCount = 1;
+    VkSemaphore signalSemaphores[] = {renderFinishedSemaphores[currentFrame], timeline.getSemaphore()};
+    submitInfo.signalSemaphoreCount = useTimeline ? 2 : 1;
     submitInfo.pSignalSemaphores = signalSemaphores;
 
-    vkResetFences(device.device(), 1, &inFlightFences[currentFrame]);
-    if (vkQueueSubmit(device.graphicsQueue(), 1, &submitInfo, inFlightFences[currentFrame]) !=
-        VK_SUCCESS) {
+    // binary semaphores ignore their entry in the value arrays
+    uint64_t waitValues[] = {0};
+    uint64_t signalValues[] = {0, timelineValue};
+    VkTimelineSemaphoreSubmitInfo timelineInfo{};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.waitSemaphoreValueCount = 1;
+    timelineInfo.pWaitSemaphoreValues = waitValues;
+    timelineInfo.signalSemaphoreValueCount = 2;
+    timelineInfo.pSignalSemaphoreValues = signalValues;
+
+    VkFence submitFence = VK_NULL_HANDLE;
+    if (useTimeline) {
+      submitInfo.pNext = &timelineInfo;
+    } else {
+      submitFence = inFlightFences[currentFrame];
+      vkResetFences(device.device(), 1, &submitFence);
+    }
+
+    if (vkQueueSubmit(device.graphicsQueue(), 1, &submitInfo, submitFence) != VK_SUCCESS) {
       throw std::runtime_error("failed to submit draw command buffer!");
     }
 
@@ -213,7 +260,7 @@ namespace vulkr {
 
   void VulkrSwapChain::createRenderPass() {
     VkAttachmentDescription depthAttachment{};
-    depthAttachment.format = findDepthFormat();
+    depthAttachment.format = swapChainDepthFormat;
     depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
     depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
     depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
@@ -252,9 +299,9 @@ namespace vulkr {
     dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
                               VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
     dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-    dependency.srcAccessMask = 0;
+    dependency.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
     dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
-                              VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+                              VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
 
     std::array<VkAttachmentDescription, 2> attachments = {colorAttachment, depthAttachment};
     VkRenderPassCreateInfo renderPassInfo = {};
@@ -271,99 +318,37 @@ namespace vulkr {
     }
   }
 
-  void VulkrSwapChain::createFramebuffers() {
-    swapChainFramebuffers.resize(imageCount());
-    for (size_t i = 0; i < imageCount(); i++) {
-      std::array<VkImageView, 2> attachments = {swapChainImageViews[i], depthImageViews[i]};
-
-      VkExtent2D swapChainExtent = getSwapChainExtent();
-      VkFramebufferCreateInfo framebufferInfo = {};
-      framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-      framebufferInfo.renderPass = renderPass;
-      framebufferInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
-      framebufferInfo.pAttachments = attachments.data();
-      framebufferInfo.width = swapChainExtent.width;
-      framebufferInfo.height = swapChainExtent.height;
-      framebufferInfo.layers = 1;
-
-      if (vkCreateFramebuffer(
-            device.device(),
-            &framebufferInfo,
-            nullptr,
-            &swapChainFramebuffers[i]) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create framebuffer!");
-      }
-    }
-  }
-
-  void VulkrSwapChain::createDepthResources() {
-    VkFormat depthFormat = findDepthFormat();
-    swapChainDepthFormat = depthFormat;
-    VkExtent2D swapChainExtent = getSwapChainExtent();
-
-    depthImages.resize(imageCount());
-    depthImageMemorys.resize(imageCount());
-    depthImageViews.resize(imageCount());
-
-    for (int i = 0; i < depthImages.size(); i++) {
-      VkImageCreateInfo imageInfo{};
-      imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-      imageInfo.imageType = VK_IMAGE_TYPE_2D;
-      imageInfo.extent.width = swapChainExtent.width;
-      imageInfo.extent.height = swapChainExtent.height;
-      imageInfo.extent.depth = 1;
-      imageInfo.mipLevels = 1;
-      imageInfo.arrayLayers = 1;
-      imageInfo.format = depthFormat;
-      imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-      imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-      imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
-      imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-      imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-      imageInfo.flags = 0;
-
-      device.createImageWithInfo(
-        imageInfo,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        depthImages[i],
-        depthImageMemorys[i]);
+  void VulkrSwapChain::createSyncObjects() {
+    imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
+    renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
+    imageTimelineValues.resize(imageCount(), 0);
 
-      VkImageViewCreateInfo viewInfo{};
-      viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-      viewInfo.image = depthImages[i];
-      viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-      viewInfo.format = depthFormat;
-      viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-      viewInfo.subresourceRange.baseMipLevel = 0;
-      viewInfo.subresourceRange.levelCount = 1;
-      viewInfo.subresourceRange.baseArrayLayer = 0;
-      viewInfo.subresourceRange.layerCount = 1;
+    VkSemaphoreCreateInfo semaphoreInfo = {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-      if (vkCreateImageView(device.device(), &viewInfo, nullptr, &depthImageViews[i]) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create texture image view!");
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+      if (vkCreateSemaphore(device.device(), &semaphoreInfo, nullptr, &imageAvailableSemaphores[i]) !=
+          VK_SUCCESS ||
+          vkCreateSemaphore(device.device(), &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]) !=
+          VK_SUCCESS) {
+        throw std::runtime_error("failed to create synchronization objects for a frame!");
       }
     }
-  }
 
-  void VulkrSwapChain::createSyncObjects() {
-    imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-    renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
+    // the frame timeline replaces the per frame and per image fences
+    if (device.frameTimeline().usesTimelineSemaphore()) {
+      return;
+    }
+
     inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
     imagesInFlight.resize(imageCount(), VK_NULL_HANDLE);
 
-    VkSemaphoreCreateInfo semaphoreInfo = {};
-    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-
     VkFenceCreateInfo fenceInfo = {};
     fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
     fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
     for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-      if (vkCreateSemaphore(device.device(), &semaphoreInfo, nullptr, &imageAvailableSemaphores[i]) !=
-          VK_SUCCESS ||
-          vkCreateSemaphore(device.device(), &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]) !=
-          VK_SUCCESS ||
-          vkCreateFence(device.device(), &fenceInfo, nullptr, &inFlightFences[i]) != VK_SUCCESS) {
+      if (vkCreateFence(device.device(), &fenceInfo, nullptr, &inFlightFences[i]) != VK_SUCCESS) {
         throw std::runtime_error("failed to create synchronization objects for a frame!");
       }
     }
@@ -3,6 +3,7 @@
 
 #include <vulkan/vulkan.h>
 
+#include <array>
 #include <string>
 #include <vector>
 #include <memory>
@@ -22,11 +23,16 @@ namespace vulkr {
 
         void operator=(const VulkrSwapChain &) = delete;
 
-        VkFramebuffer getFrameBuffer(const int index) const { return swapChainFramebuffers[index]; }
+        /**
+         * Never begun, the render graph draws into its own framebuffers. Pipelines are built against it because
+         * it is compatible with the graph's passes, which use the same formats.
+         */
         VkRenderPass getRenderPass() const { return renderPass; }
+        VkImage getImage(const int index) const { return swapChainImages[index]; }
         VkImageView getImageView(const int index) const { return swapChainImageViews[index]; }
         size_t imageCount() const { return swapChainImages.size(); }
         VkFormat getSwapChainImageFormat() const { return swapChainImageFormat; }
+        VkFormat getSwapChainDepthFormat() const { return swapChainDepthFormat; }
         VkExtent2D getSwapChainExtent() const { return swapChainExtent; }
         uint32_t width() const { return swapChainExtent.width; }
         uint32_t height() const { return swapChainExtent.height; }
@@ -39,7 +45,7 @@ namespace vulkr {
 
         VkResult acquireNextImage(uint32_t *imageIndex);
 
-        VkResult submitCommandBuffers(const VkCommandBuffer *buffers, uint32_t *imageIndex);
+        VkResult submitCommandBuffers(const VkCommandBuffer *buffers, uint32_t *imageIndex, uint64_t timelineValue);
 
         bool compareSwapFormats(const VulkrSwapChain &swapChain) const {
             return swapChain.swapChainImageFormat == swapChainImageFormat &&
@@ -53,12 +59,10 @@ namespace vulkr {
 
         void createImageViews();
 
-        void createDepthResources();
+        bool adoptRenderPass();
 
         void createRenderPass();
 
-        void createFramebuffers();
-
         void createSyncObjects();
 
         // Helper functions
@@ -74,12 +78,8 @@ namespace vulkr {
         VkFormat swapChainDepthFormat;
         VkExtent2D swapChainExtent;
 
-        std::vector<VkFramebuffer> swapChainFramebuffers;
-        VkRenderPass renderPass;
+        VkRenderPass renderPass = VK_NULL_HANDLE;
 
-        std::vector<VkImage> depthImages;
-        std::vector<VkDeviceMemory> depthImageMemorys;
-        std::vector<VkImageView> depthImageViews;
         std::vector<VkImage> swapChainImages;
         std::vector<VkImageView> swapChainImageViews;
 
@@ -94,5 +94,9 @@ namespace vulkr {
         std::vector<VkFence> inFlightFences;
         std::vector<VkFence> imagesInFlight;
         size_t currentFrame = 0;
+
+        // frame timeline values last submitted per frame slot and per swap chain image
+        std::array<uint64_t, MAX_FRAMES_IN_FLIGHT> frameTimelineValues{};
+        std::vector<uint64_t> imageTimelineValues;
     };
 }
@@ -0,0 +1,153 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "clustered_lighting_system.h"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "../pipeline/vulkr_swap_chain.hpp"
+
+namespace vulkr {
+    // must match local_size_x in cluster_lights.comp
+    static constexpr uint32_t CULL_GROUP_SIZE = 64;
+
+    ClusteredLightingSystem::ClusteredLightingSystem(VulkrDevice &device) : vulkrDevice(device) {
+        createBuffers();
+        createDescriptors();
+        createPipelineLayout();
+        cullPipeline = std::make_unique<VulkrComputePipeline>(vulkrDevice, "shaders/cluster_lights.comp.spv",
+                                                              pipelineLayout);
+    }
+
+    ClusteredLightingSystem::~ClusteredLightingSystem() {
+        vkDestroyPipelineLayout(vulkrDevice.device(), pipelineLayout, nullptr);
+    }
+
+    void ClusteredLightingSystem::createBuffers() {
+        for (int i = 0; i < VulkrSwapChain::MAX_FRAMES_IN_FLIGHT; i++) {
+            auto &ubo = uboBuffers.emplace_back(std::make_unique<VulkrBuffer>(
+                vulkrDevice, sizeof(GlobalUbo), 1, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+            ubo->map();
+
+            auto &lights = lightBuffers.emplace_back(std::make_unique<VulkrBuffer>(
+                vulkrDevice, sizeof(GpuLight), MAX_LIGHTS, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+            lights->map();
+
+            clusterCountBuffers.emplace_back(std::make_unique<VulkrBuffer>(
+                vulkrDevice, sizeof(uint32_t), CLUSTER_COUNT, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT));
+
+            clusterIndexBuffers.emplace_back(std::make_unique<VulkrBuffer>(
+                vulkrDevice, sizeof(uint32_t), CLUSTER_COUNT * MAX_LIGHTS_PER_CLUSTER,
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT));
+        }
+    }
+
+    void ClusteredLightingSystem::createDescriptors() {
+        constexpr VkShaderStageFlags lightingStages = VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+
+        globalSetLayout = VulkrDescriptorSetLayout::Builder(vulkrDevice)
+                .addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                            VK_SHADER_STAGE_VERTEX_BIT | lightingStages)
+                .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, lightingStages)
+                .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, lightingStages)
+                .addBinding(3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, lightingStages)
+                .build();
+
+        globalPool = VulkrDescriptorPool::Builder(vulkrDevice)
+                .setMaxSets(VulkrSwapChain::MAX_FRAMES_IN_FLIGHT)
+                .addPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VulkrSwapChain::MAX_FRAMES_IN_FLIGHT)
+                .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3 * VulkrSwapChain::MAX_FRAMES_IN_FLIGHT)
+                .build();
+
+        globalDescriptorSets.resize(VulkrSwapChain::MAX_FRAMES_IN_FLIGHT);
+        for (int i = 0; i < VulkrSwapChain::MAX_FRAMES_IN_FLIGHT; i++) {
+            auto uboInfo = uboBuffers[i]->descriptorInfo();
+            auto lightInfo = lightBuffers[i]->descriptorInfo();
+            auto countInfo = clusterCountBuffers[i]->descriptorInfo();
+            auto indexInfo = clusterIndexBuffers[i]->descriptorInfo();
+
+            if (!VulkrDescriptorWriter(*globalSetLayout, *globalPool)
+                    .writeBuffer(0, &uboInfo)
+                    .writeBuffer(1, &lightInfo)
+                    .writeBuffer(2, &countInfo)
+                    .writeBuffer(3, &indexInfo)
+                    .build(globalDescriptorSets[i])) {
+                throw std::runtime_error("failed to allocate global descriptor set!");
+            }
+        }
+    }
+
+    void ClusteredLightingSystem::createPipelineLayout() {
+        VkDescriptorSetLayout setLayout = globalSetLayout->getDescriptorSetLayout();
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &setLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 0;
+        pipelineLayoutInfo.pPushConstantRanges = nullptr;
+
+        if (vkCreatePipelineLayout(vulkrDevice.device(), &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create light culling pipeline layout!");
+        }
+    }
+
+    void ClusteredLightingSystem::update(const FrameInfo &frameInfo, std::vector<GameObject> &gameObjects,
+                                         VkExtent2D renderExtent) {
+        auto *gpuLights = static_cast<GpuLight *>(lightBuffers[frameInfo.frameIndex]->getMappedMemory());
+
+        lightCount = 0;
+        for (auto &obj: gameObjects) {
+            if (obj.light == nullptr || lightCount >= MAX_LIGHTS) {
+                continue;
+            }
+
+            const auto &light = *obj.light;
+            const bool isSpot = light.type == LightComponent::Type::Spot;
+
+            GpuLight &gpuLight = gpuLights[lightCount++];
+            gpuLight.positionRange = glm::vec4(obj.transform.translation, light.range);
+            gpuLight.colorIntensity = glm::vec4(light.color, light.intensity);
+            gpuLight.directionType = glm::vec4(glm::normalize(light.direction), isSpot ? 1.0f : 0.0f);
+            gpuLight.spotAngles = glm::vec4(std::cos(light.innerConeAngle), std::cos(light.outerConeAngle), 0.0f,
+                                            0.0f);
+        }
+
+        const Camera &camera = frameInfo.camera;
+        const float nearPlane = camera.getNear();
+        const float farPlane = camera.getFar();
+        const float logDepthRange = std::log(farPlane / nearPlane);
+
+        GlobalUbo ubo{};
+        ubo.projection = camera.getProjectionMatrix();
+        ubo.view = camera.getView();
+        ubo.inverseView = camera.getInverseView();
+        ubo.inverseProjection = camera.getInverseProjection();
+        ubo.ambientLightColor = ambientLightColor;
+        ubo.directionalLight = directionalLight;
+        ubo.clusterGrid = glm::uvec4(CLUSTER_GRID_X, CLUSTER_GRID_Y, CLUSTER_GRID_Z, lightCount);
+        // slice = log(viewZ) * scale + bias distributes slices exponentially between the near and far planes
+        ubo.clusterDepth = glm::vec4(nearPlane, farPlane, static_cast<float>(CLUSTER_GRID_Z) / logDepthRange,
+                                     -static_cast<float>(CLUSTER_GRID_Z) * std::log(nearPlane) / logDepthRange);
+        ubo.screenSize = glm::vec4(renderExtent.width, renderExtent.height,
+                                   1.0f / static_cast<float>(renderExtent.width),
+                                   1.0f / static_cast<float>(renderExtent.height));
+
+        uboBuffers[frameInfo.frameIndex]->writeToBuffer(&ubo);
+    }
+
+    void ClusteredLightingSystem::cullLights(const FrameInfo &frameInfo) {
+        VkCommandBuffer commandBuffer = frameInfo.commandBuffer;
+
+        cullPipeline->bind(commandBuffer);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1,
+                                &globalDescriptorSets[frameInfo.frameIndex], 0, nullptr);
+        vkCmdDispatch(commandBuffer, (CLUSTER_COUNT + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE, 1, 1);
+
+    }
+}
@@ -0,0 +1,113 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef CLUSTERED_LIGHTING_SYSTEM_H
+#define CLUSTERED_LIGHTING_SYSTEM_H
+
+#include <memory>
+#include <vector>
+
+#include "frame_info.h"
+#include "../game/game_object.h"
+#include "../pipeline/vulkr_buffer.h"
+#include "../pipeline/vulkr_compute_pipeline.h"
+#include "../pipeline/vulkr_descriptors.h"
+#include "../pipeline/vulkr_device.hpp"
+
+namespace vulkr {
+    /**
+     * Global per-frame uniforms, bound as set 0 binding 0 by every scene shader.
+     */
+    struct GlobalUbo {
+        glm::mat4 projection{1.0f};
+        glm::mat4 view{1.0f};
+        glm::mat4 inverseView{1.0f};
+        glm::mat4 inverseProjection{1.0f};
+        glm::vec4 ambientLightColor{1.0f, 1.0f, 1.0f, 0.05f}; // w is intensity
+        glm::vec4 directionalLight{glm::normalize(glm::vec3(1.0f, -3.0f, 1.0f)), 1.0f}; // w is intensity
+        glm::uvec4 clusterGrid{0}; // xyz cluster counts, w light count
+        glm::vec4 clusterDepth{0.0f}; // near, far, slice scale, slice bias
+        glm::vec4 screenSize{0.0f}; // xy render extent, zw its reciprocal
+    };
+
+    /**
+     * Clustered forward lighting. Lights from game objects are uploaded to a storage buffer, a compute pass
+     * bins them into a froxel grid built from the camera projection, and the simple shader only loops over
+     * the lights of the cluster a fragment falls in.
+     * Owns the global descriptor set (uniforms, light list and cluster lists) shared by the scene pipelines.
+     */
+    class ClusteredLightingSystem {
+    public:
+        static constexpr uint32_t CLUSTER_GRID_X = 16;
+        static constexpr uint32_t CLUSTER_GRID_Y = 9;
+        static constexpr uint32_t CLUSTER_GRID_Z = 24;
+        static constexpr uint32_t CLUSTER_COUNT = CLUSTER_GRID_X * CLUSTER_GRID_Y * CLUSTER_GRID_Z;
+        static constexpr uint32_t MAX_LIGHTS = 1024;
+        // must match cluster_lights.comp and simple_shader.frag
+        static constexpr uint32_t MAX_LIGHTS_PER_CLUSTER = 128;
+
+        explicit ClusteredLightingSystem(VulkrDevice &device);
+
+        ~ClusteredLightingSystem();
+
+        ClusteredLightingSystem(const ClusteredLightingSystem &) = delete;
+
+        ClusteredLightingSystem &operator=(const ClusteredLightingSystem &) = delete;
+
+        VkDescriptorSetLayout getGlobalSetLayout() const { return globalSetLayout->getDescriptorSetLayout(); }
+        VkDescriptorSet getGlobalDescriptorSet(int frameIndex) const { return globalDescriptorSets[frameIndex]; }
+
+        /**
+         * Writes this frame's uniforms and light list. renderExtent is the extent the scene is rendered at.
+         */
+        void update(const FrameInfo &frameInfo, std::vector<GameObject> &gameObjects, VkExtent2D renderExtent);
+
+        /**
+         * Bins the lights into clusters, must be recorded outside of a render pass. The cluster buffers are
+         * written by the compute stage, the caller makes them visible to the fragment shaders that read them.
+         */
+        void cullLights(const FrameInfo &frameInfo);
+
+        VkBuffer getClusterCountBuffer(int frameIndex) const { return clusterCountBuffers[frameIndex]->getBuffer(); }
+        VkBuffer getClusterIndexBuffer(int frameIndex) const { return clusterIndexBuffers[frameIndex]->getBuffer(); }
+
+        uint32_t getLightCount() const { return lightCount; }
+
+        glm::vec4 ambientLightColor{1.0f, 1.0f, 1.0f, 0.05f};
+        glm::vec4 directionalLight{glm::normalize(glm::vec3(1.0f, -3.0f, 1.0f)), 1.0f};
+
+    private:
+        struct GpuLight {
+            glm::vec4 positionRange;
+            glm::vec4 colorIntensity;
+            glm::vec4 directionType; // w is 0 for point, 1 for spot
+            glm::vec4 spotAngles; // x cos inner, y cos outer
+        };
+
+        void createBuffers();
+
+        void createDescriptors();
+
+        void createPipelineLayout();
+
+        VulkrDevice &vulkrDevice;
+
+        std::unique_ptr<VulkrDescriptorSetLayout> globalSetLayout;
+        std::unique_ptr<VulkrDescriptorPool> globalPool;
+        std::vector<VkDescriptorSet> globalDescriptorSets;
+
+        // every buffer is per frame slot so the compute pass never races the previous frame's shading
+        std::vector<std::unique_ptr<VulkrBuffer>> uboBuffers;
+        std::vector<std::unique_ptr<VulkrBuffer>> lightBuffers;
+        std::vector<std::unique_ptr<VulkrBuffer>> clusterCountBuffers;
+        std::vector<std::unique_ptr<VulkrBuffer>> clusterIndexBuffers;
+
+        VkPipelineLayout pipelineLayout;
+        std::unique_ptr<VulkrComputePipeline> cullPipeline;
+
+        uint32_t lightCount{0};
+    };
+}
+
+#endif //CLUSTERED_LIGHTING_SYSTEM_H
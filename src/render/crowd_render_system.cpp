@@ -0,0 +1,288 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "crowd_render_system.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+#include "../pipeline/vulkr_swap_chain.hpp"
+
+namespace vulkr {
+    // matches the push block of simple_shader.frag, the crowd's playback parameters follow it
+    struct CrowdPushConstantData {
+        glm::mat4 modelMatrix{1.0f};
+        glm::mat4 normalMatrix{1.0f};
+        int enableLighting{1};
+        float time{0.0f};
+        float framesPerSecond{0.0f};
+        uint32_t frameCount{0};
+    };
+
+    // std430 layout of Instance in crowd.vert
+    struct CrowdInstanceData {
+        glm::mat4 transform;
+        glm::vec4 playback; // time offset, speed
+    };
+
+    CrowdRenderSystem::CrowdRenderSystem(VulkrDevice &device, VkRenderPass renderPass,
+                                         VkDescriptorSetLayout globalSetLayout,
+                                         VkDescriptorSetLayout shadowSetLayout, TextureManager &textureManager)
+        : vulkrDevice{device}, textureManager{textureManager} {
+        createBuffers();
+        createDescriptors();
+        createPipelineLayout(globalSetLayout, shadowSetLayout);
+        createPipeline(renderPass);
+    }
+
+    CrowdRenderSystem::~CrowdRenderSystem() {
+        vkDestroyPipelineLayout(vulkrDevice.device(), pipelineLayout, nullptr);
+
+        for (auto &crowd: crowds) {
+            vulkrDevice.deletionQueue().retireImage(crowd.image, crowd.imageView, crowd.imageMemory,
+                                                    lastUsedFrameValue);
+        }
+
+        VkDevice vkDevice = vulkrDevice.device();
+        VkSampler sampler = animationSampler;
+        vulkrDevice.deletionQueue().retire(lastUsedFrameValue, [vkDevice, sampler]() {
+            vkDestroySampler(vkDevice, sampler, nullptr);
+        });
+    }
+
+    void CrowdRenderSystem::createBuffers() {
+        for (int i = 0; i < VulkrSwapChain::MAX_FRAMES_IN_FLIGHT; i++) {
+            auto &buffer = instanceBuffers.emplace_back(std::make_unique<VulkrBuffer>(
+                vulkrDevice, sizeof(CrowdInstanceData), MAX_INSTANCES, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+            buffer->map();
+        }
+
+        // the frames are fetched texel by texel and blended in the shader
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_NEAREST;
+        samplerInfo.minFilter = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod = 0.0f;
+
+        if (vkCreateSampler(vulkrDevice.device(), &samplerInfo, nullptr, &animationSampler) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create crowd animation sampler!");
+        }
+    }
+
+    void CrowdRenderSystem::createDescriptors() {
+        // set 2 is taken by the material, so the instances and the animation share set 3
+        crowdSetLayout = VulkrDescriptorSetLayout::Builder(vulkrDevice)
+                .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT)
+                .addBinding(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_VERTEX_BIT)
+                .build();
+
+        constexpr uint32_t setCount = VulkrSwapChain::MAX_FRAMES_IN_FLIGHT * MAX_CROWDS;
+        descriptorPool = VulkrDescriptorPool::Builder(vulkrDevice)
+                .setMaxSets(setCount)
+                .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, setCount)
+                .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, setCount)
+                .build();
+    }
+
+    void CrowdRenderSystem::createPipelineLayout(VkDescriptorSetLayout globalSetLayout,
+                                                 VkDescriptorSetLayout shadowSetLayout) {
+        VkPushConstantRange pushConstants{};
+        pushConstants.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+        pushConstants.offset = 0;
+        pushConstants.size = sizeof(CrowdPushConstantData);
+
+        std::array<VkDescriptorSetLayout, 4> setLayouts = {
+            globalSetLayout, shadowSetLayout, textureManager.getMaterialSetLayout(),
+            crowdSetLayout->getDescriptorSetLayout()
+        };
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+        pipelineLayoutInfo.pSetLayouts = setLayouts.data();
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstants;
+
+        if (vkCreatePipelineLayout(vulkrDevice.device(), &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create crowd pipeline layout!");
+        }
+    }
+
+    void CrowdRenderSystem::createPipeline(VkRenderPass renderPass) {
+        PipelineConfigInfo pipelineConfig{};
+        VulkrPipeline::defaultPipelineConfigInfo(pipelineConfig);
+        pipelineConfig.renderPass = renderPass;
+        pipelineConfig.pipelineLayout = pipelineLayout;
+
+        crowdPipeline = std::make_unique<VulkrPipeline>(
+            vulkrDevice,
+            "shaders/crowd.vert.spv",
+            "shaders/simple_shader.frag.spv",
+            pipelineConfig
+        );
+    }
+
+    uint32_t CrowdRenderSystem::createCrowd(std::shared_ptr<VulkrModel> model, uint32_t animationIndex,
+                                            float framesPerSecond) {
+        if (crowds.size() >= MAX_CROWDS) {
+            throw std::runtime_error("failed to create crowd, too many crowds!");
+        }
+        if (!model->isSkinned() || animationIndex >= model->getAnimations().size()) {
+            throw std::runtime_error("failed to create crowd, the model has no such skinned animation!");
+        }
+
+        const BakedAnimation baked = bakeAnimation(model->getSkeleton(), model->getRestPose(),
+                                                   model->getAnimations()[animationIndex], framesPerSecond);
+        if (baked.getWidth() > vulkrDevice.properties.limits.maxImageDimension2D ||
+            baked.frameCount > vulkrDevice.properties.limits.maxImageDimension2D) {
+            throw std::runtime_error("failed to create crowd, the baked animation exceeds the image size limit!");
+        }
+
+        Crowd &crowd = crowds.emplace_back();
+        crowd.model = std::move(model);
+        crowd.frameCount = baked.frameCount;
+        crowd.framesPerSecond = baked.framesPerSecond;
+        crowd.duration = baked.duration;
+        uploadAnimation(crowd, baked);
+
+        VkDescriptorImageInfo imageInfo{};
+        imageInfo.sampler = animationSampler;
+        imageInfo.imageView = crowd.imageView;
+        imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        crowd.descriptorSets.resize(VulkrSwapChain::MAX_FRAMES_IN_FLIGHT);
+        for (int i = 0; i < VulkrSwapChain::MAX_FRAMES_IN_FLIGHT; i++) {
+            auto bufferInfo = instanceBuffers[i]->descriptorInfo();
+            if (!VulkrDescriptorWriter(*crowdSetLayout, *descriptorPool)
+                    .writeBuffer(0, &bufferInfo)
+                    .writeImage(1, &imageInfo)
+                    .build(crowd.descriptorSets[i])) {
+                throw std::runtime_error("failed to allocate crowd descriptor set!");
+            }
+        }
+
+        return static_cast<uint32_t>(crowds.size() - 1);
+    }
+
+    void CrowdRenderSystem::uploadAnimation(Crowd &crowd, const BakedAnimation &baked) {
+        VulkrBuffer stagingBuffer{
+            vulkrDevice, sizeof(glm::vec4), static_cast<uint32_t>(baked.texels.size()),
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+        };
+        stagingBuffer.map();
+        stagingBuffer.writeToBuffer(baked.texels.data());
+        stagingBuffer.unmap();
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = baked.getWidth();
+        imageInfo.extent.height = baked.frameCount;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        vulkrDevice.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, crowd.image, crowd.imageMemory);
+
+        VkCommandBuffer commandBuffer = vulkrDevice.beginSingleTimeCommands();
+
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = crowd.image;
+        barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        VkBufferImageCopy region{};
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.imageExtent = {baked.getWidth(), baked.frameCount, 1};
+        vkCmdCopyBufferToImage(commandBuffer, stagingBuffer.getBuffer(), crowd.image,
+                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        vulkrDevice.endSingleTimeCommands(commandBuffer);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = crowd.image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+        viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+
+        if (vkCreateImageView(vulkrDevice.device(), &viewInfo, nullptr, &crowd.imageView) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create crowd animation view!");
+        }
+    }
+
+    void CrowdRenderSystem::render(FrameInfo &frameInfo) {
+        time += frameInfo.frameTime;
+        instanceCount = 0;
+        if (crowds.empty()) return;
+
+        lastUsedFrameValue = vulkrDevice.frameTimeline().getCurrentValue();
+        VkCommandBuffer commandBuffer = frameInfo.commandBuffer;
+        auto *instances = static_cast<CrowdInstanceData *>(instanceBuffers[frameInfo.frameIndex]->getMappedMemory());
+
+        crowdPipeline->bind(commandBuffer);
+        std::array<VkDescriptorSet, 2> descriptorSets = {frameInfo.globalDescriptorSet, frameInfo.shadowDescriptorSet};
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0,
+                                static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(), 0, nullptr);
+
+        for (auto &crowd: crowds) {
+            const auto count = static_cast<uint32_t>(
+                std::min<size_t>(crowd.instances.size(), MAX_INSTANCES - instanceCount));
+            if (count == 0) continue;
+
+            const uint32_t firstInstance = instanceCount;
+            for (uint32_t i = 0; i < count; i++) {
+                const Instance &instance = crowd.instances[i];
+                instances[firstInstance + i] = {instance.transform, {instance.timeOffset, instance.speed, 0.0f, 0.0f}};
+            }
+            instanceCount += count;
+
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 3, 1,
+                                    &crowd.descriptorSets[frameInfo.frameIndex], 0, nullptr);
+
+            CrowdPushConstantData push{};
+            push.time = static_cast<float>(time);
+            push.framesPerSecond = crowd.framesPerSecond;
+            push.frameCount = crowd.frameCount;
+            vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                               0, sizeof(CrowdPushConstantData), &push);
+
+            crowd.model->bind(commandBuffer);
+            const auto &submeshes = crowd.model->getSubmeshes();
+            for (uint32_t i = 0; i < submeshes.size(); i++) {
+                const auto &material = submeshes[i].material ? submeshes[i].material
+                                                             : textureManager.getDefaultMaterial();
+                material->bind(commandBuffer, pipelineLayout, 2, frameInfo.frameIndex);
+                crowd.model->drawSubmesh(commandBuffer, i, count, firstInstance);
+            }
+        }
+    }
+}
@@ -0,0 +1,105 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef CROWD_RENDER_SYSTEM_H
+#define CROWD_RENDER_SYSTEM_H
+
+#include <memory>
+#include <vector>
+
+#include "frame_info.h"
+#include "../animation/animation_baker.h"
+#include "../model/vulkr_model.h"
+#include "../pipeline/vulkr_buffer.h"
+#include "../pipeline/vulkr_descriptors.h"
+#include "../pipeline/vulkr_device.hpp"
+#include "../pipeline/vulkr_pipeline.h"
+#include "../texture/texture_manager.h"
+
+namespace vulkr {
+    /**
+     * Draws crowds of one skinned model playing one baked animation, each crowd in a single instanced draw.
+     * The clip's joint palettes are baked once into a texture (see BakedAnimation) and the vertex shader
+     * skins every instance from it at the crowd's clock plus the instance's time offset, so agents cost no
+     * CPU animation work at all, only their instance data is uploaded every frame.
+     */
+    class CrowdRenderSystem {
+    public:
+        // instances drawn per frame over all crowds
+        static constexpr uint32_t MAX_INSTANCES = 65536;
+        static constexpr uint32_t MAX_CROWDS = 16;
+
+        struct Instance {
+            glm::mat4 transform{1.0f};
+            float timeOffset{0.0f};
+            float speed{1.0f};
+        };
+
+        CrowdRenderSystem(VulkrDevice &device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout,
+                          VkDescriptorSetLayout shadowSetLayout, TextureManager &textureManager);
+
+        ~CrowdRenderSystem();
+
+        CrowdRenderSystem(const CrowdRenderSystem &) = delete;
+
+        CrowdRenderSystem &operator=(const CrowdRenderSystem &) = delete;
+
+        /**
+         * Bakes one of a skinned model's animations at about framesPerSecond and returns the new crowd.
+         */
+        uint32_t createCrowd(std::shared_ptr<VulkrModel> model, uint32_t animationIndex, float framesPerSecond = 30.0f);
+
+        std::vector<Instance> &getInstances(uint32_t crowd) { return crowds[crowd].instances; }
+
+        /**
+         * Advances the crowds' clock by the frame time and draws every crowd, must be recorded in the scene pass.
+         */
+        void render(FrameInfo &frameInfo);
+
+        uint32_t getInstanceCount() const { return instanceCount; }
+
+    private:
+        struct Crowd {
+            std::shared_ptr<VulkrModel> model;
+            uint32_t frameCount;
+            float framesPerSecond;
+            float duration;
+            VkImage image = VK_NULL_HANDLE;
+            VkDeviceMemory imageMemory = VK_NULL_HANDLE;
+            VkImageView imageView = VK_NULL_HANDLE;
+            // the frame slot's instance buffer and the crowd's animation, one per frame slot
+            std::vector<VkDescriptorSet> descriptorSets;
+            std::vector<Instance> instances;
+        };
+
+        void createBuffers();
+
+        void createDescriptors();
+
+        void createPipelineLayout(VkDescriptorSetLayout globalSetLayout, VkDescriptorSetLayout shadowSetLayout);
+
+        void createPipeline(VkRenderPass renderPass);
+
+        void uploadAnimation(Crowd &crowd, const BakedAnimation &baked);
+
+        VulkrDevice &vulkrDevice;
+        TextureManager &textureManager;
+
+        std::unique_ptr<VulkrPipeline> crowdPipeline;
+        VkPipelineLayout pipelineLayout;
+
+        std::unique_ptr<VulkrDescriptorSetLayout> crowdSetLayout;
+        std::unique_ptr<VulkrDescriptorPool> descriptorPool;
+        // one persistently mapped instance buffer per frame slot, shared by all crowds
+        std::vector<std::unique_ptr<VulkrBuffer>> instanceBuffers;
+        VkSampler animationSampler = VK_NULL_HANDLE;
+
+        std::vector<Crowd> crowds;
+        double time{0.0};
+        uint32_t instanceCount{0};
+        uint64_t lastUsedFrameValue{0};
+    };
+}
+
+#endif //CROWD_RENDER_SYSTEM_H
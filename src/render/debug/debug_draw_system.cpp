@@ -0,0 +1,249 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "debug_draw_system.h"
+
+#if VULKR_DEBUG_DRAW
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+#include <glm/gtc/constants.hpp>
+
+#include "../../pipeline/vulkr_swap_chain.hpp"
+
+namespace vulkr {
+    struct DebugDrawPushConstantData {
+        glm::mat4 projectionView{1.0f};
+    };
+
+    DebugDrawSystem::DebugDrawSystem(VulkrDevice &device, VkRenderPass renderPass) : vulkrDevice{device} {
+        createPipelineLayout();
+        createPipelines(renderPass);
+        createBuffer();
+    }
+
+    DebugDrawSystem::~DebugDrawSystem() {
+        vkDestroyPipelineLayout(vulkrDevice.device(), pipelineLayout, nullptr);
+    }
+
+    void DebugDrawSystem::createPipelineLayout() {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(DebugDrawPushConstantData);
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 0;
+        pipelineLayoutInfo.pSetLayouts = nullptr;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(vulkrDevice.device(), &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create debug draw pipeline layout!");
+        }
+    }
+
+    void DebugDrawSystem::createPipelines(VkRenderPass renderPass) {
+        for (uint32_t batch = 0; batch < BATCH_COUNT; batch++) {
+            const bool lines = batch == LINES_DEPTH || batch == LINES_OVERLAY;
+            const bool depthTest = batch == LINES_DEPTH || batch == TRIANGLES_DEPTH;
+
+            PipelineConfigInfo pipelineConfig{};
+            VulkrPipeline::defaultPipelineConfigInfo(pipelineConfig);
+            pipelineConfig.renderPass = renderPass;
+            pipelineConfig.pipelineLayout = pipelineLayout;
+
+            pipelineConfig.bindingDescriptions = {{0, sizeof(DebugVertex), VK_VERTEX_INPUT_RATE_VERTEX}};
+            pipelineConfig.attributeDescriptions = {
+                {0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(DebugVertex, position)},
+                {1, 0, VK_FORMAT_R8G8B8A8_UNORM, offsetof(DebugVertex, color)},
+            };
+
+            pipelineConfig.inputAssemblyInfo.topology = lines
+                                                            ? VK_PRIMITIVE_TOPOLOGY_LINE_LIST
+                                                            : VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+            // debug shapes never occlude each other or the scene
+            pipelineConfig.depthStencilInfo.depthTestEnable = depthTest ? VK_TRUE : VK_FALSE;
+            pipelineConfig.depthStencilInfo.depthWriteEnable = VK_FALSE;
+
+            pipelineConfig.colorBlendAttachment.blendEnable = VK_TRUE;
+            pipelineConfig.colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+            pipelineConfig.colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+            pipelineConfig.colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+            pipelineConfig.colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+
+            pipelines[batch] = std::make_unique<VulkrPipeline>(
+                vulkrDevice,
+                "shaders/debug_draw.vert.spv",
+                "shaders/debug_draw.frag.spv",
+                pipelineConfig);
+        }
+    }
+
+    void DebugDrawSystem::createBuffer() {
+        ringBuffer = std::make_unique<VulkrBuffer>(
+            vulkrDevice, sizeof(DebugVertex), MAX_VERTICES * VulkrSwapChain::MAX_FRAMES_IN_FLIGHT,
+            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        ringBuffer->map();
+
+        for (auto &batch: batches) {
+            batch.reserve(MAX_VERTICES / 4);
+        }
+    }
+
+    void DebugDrawSystem::begin(int frameIndex) {
+        segmentOffset = static_cast<uint32_t>(frameIndex) * MAX_VERTICES;
+        vertexCount = 0;
+        // clear() keeps the capacity, so steady state frames do not allocate
+        for (auto &batch: batches) {
+            batch.clear();
+        }
+    }
+
+    uint32_t DebugDrawSystem::packColor(const glm::vec4 &color) {
+        const glm::uvec4 c = glm::uvec4(glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f);
+        return c.r | (c.g << 8) | (c.b << 16) | (c.a << 24);
+    }
+
+    void DebugDrawSystem::push(Batch batch, std::initializer_list<glm::vec3> positions, uint32_t color) {
+        const auto count = static_cast<uint32_t>(positions.size());
+        if (vertexCount + count > MAX_VERTICES) return;
+
+        for (const auto &position: positions) {
+            batches[batch].push_back({position, color});
+        }
+        vertexCount += count;
+    }
+
+    void DebugDrawSystem::line(const glm::vec3 &a, const glm::vec3 &b, const glm::vec4 &color, bool depthTest) {
+        push(depthTest ? LINES_DEPTH : LINES_OVERLAY, {a, b}, packColor(color));
+    }
+
+    void DebugDrawSystem::triangle(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c,
+                                   const glm::vec4 &color, bool depthTest) {
+        push(depthTest ? TRIANGLES_DEPTH : TRIANGLES_OVERLAY, {a, b, c}, packColor(color));
+    }
+
+    void DebugDrawSystem::box(const glm::vec3 &min, const glm::vec3 &max, const glm::vec4 &color, bool depthTest) {
+        const glm::vec3 center = (min + max) * 0.5f;
+        const glm::vec3 halfExtent = (max - min) * 0.5f;
+
+        glm::mat4 transform{1.0f};
+        transform[0][0] = halfExtent.x;
+        transform[1][1] = halfExtent.y;
+        transform[2][2] = halfExtent.z;
+        transform[3] = glm::vec4(center, 1.0f);
+        box(transform, color, depthTest);
+    }
+
+    void DebugDrawSystem::box(const glm::mat4 &transform, const glm::vec4 &color, bool depthTest) {
+        // corner i has x = bit 0, y = bit 1, z = bit 2
+        glm::vec3 corners[8];
+        for (int i = 0; i < 8; i++) {
+            const glm::vec4 local{i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f, 1.0f};
+            corners[i] = glm::vec3(transform * local);
+        }
+
+        const Batch batch = depthTest ? LINES_DEPTH : LINES_OVERLAY;
+        const uint32_t packed = packColor(color);
+        for (int i = 0; i < 8; i++) {
+            for (int axisBit = 1; axisBit < 8; axisBit <<= 1) {
+                // every edge once, from the corner with the bit cleared
+                if (!(i & axisBit)) push(batch, {corners[i], corners[i | axisBit]}, packed);
+            }
+        }
+    }
+
+    void DebugDrawSystem::sphere(const glm::vec3 &center, float radius, const glm::vec4 &color, bool depthTest,
+                                 uint32_t segments) {
+        const Batch batch = depthTest ? LINES_DEPTH : LINES_OVERLAY;
+        const uint32_t packed = packColor(color);
+        const float step = glm::two_pi<float>() / static_cast<float>(segments);
+
+        glm::vec2 previous{radius, 0.0f};
+        for (uint32_t i = 1; i <= segments; i++) {
+            const float angle = step * static_cast<float>(i);
+            const glm::vec2 current{radius * glm::cos(angle), radius * glm::sin(angle)};
+
+            push(batch, {center + glm::vec3(previous.x, previous.y, 0.0f), center + glm::vec3(current.x, current.y, 0.0f)},
+                 packed);
+            push(batch, {center + glm::vec3(previous.x, 0.0f, previous.y), center + glm::vec3(current.x, 0.0f, current.y)},
+                 packed);
+            push(batch, {center + glm::vec3(0.0f, previous.x, previous.y), center + glm::vec3(0.0f, current.x, current.y)},
+                 packed);
+            previous = current;
+        }
+    }
+
+    void DebugDrawSystem::frustum(const glm::mat4 &projectionView, const glm::vec4 &color, bool depthTest) {
+        // the NDC box, z in [0, 1], mapped back to world space
+        glm::mat4 ndcToCube{1.0f};
+        ndcToCube[2][2] = 0.5f;
+        ndcToCube[3][2] = 0.5f;
+
+        const glm::mat4 inverse = glm::inverse(projectionView);
+        glm::vec3 corners[8];
+        for (int i = 0; i < 8; i++) {
+            const glm::vec4 local{i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f, 1.0f};
+            const glm::vec4 world = inverse * (ndcToCube * local);
+            corners[i] = glm::vec3(world) / world.w;
+        }
+
+        const Batch batch = depthTest ? LINES_DEPTH : LINES_OVERLAY;
+        const uint32_t packed = packColor(color);
+        for (int i = 0; i < 8; i++) {
+            for (int axisBit = 1; axisBit < 8; axisBit <<= 1) {
+                if (!(i & axisBit)) push(batch, {corners[i], corners[i | axisBit]}, packed);
+            }
+        }
+    }
+
+    void DebugDrawSystem::axis(const glm::mat4 &transform, float size, bool depthTest) {
+        const glm::vec3 origin{transform[3]};
+        line(origin, origin + glm::vec3(transform[0]) * size, {1.0f, 0.0f, 0.0f, 1.0f}, depthTest);
+        line(origin, origin + glm::vec3(transform[1]) * size, {0.0f, 1.0f, 0.0f, 1.0f}, depthTest);
+        line(origin, origin + glm::vec3(transform[2]) * size, {0.0f, 0.0f, 1.0f, 1.0f}, depthTest);
+    }
+
+    void DebugDrawSystem::render(VkCommandBuffer commandBuffer, const Camera &camera) {
+        if (vertexCount == 0) return;
+
+        // the batches are packed back to back into this frame's segment
+        auto *mapped = static_cast<DebugVertex *>(ringBuffer->getMappedMemory()) + segmentOffset;
+        uint32_t firstVertex = segmentOffset;
+        std::array<uint32_t, BATCH_COUNT> batchFirstVertex{};
+        for (uint32_t batch = 0; batch < BATCH_COUNT; batch++) {
+            batchFirstVertex[batch] = firstVertex;
+            if (batches[batch].empty()) continue;
+
+            std::memcpy(mapped, batches[batch].data(), batches[batch].size() * sizeof(DebugVertex));
+            mapped += batches[batch].size();
+            firstVertex += static_cast<uint32_t>(batches[batch].size());
+        }
+
+        DebugDrawPushConstantData push{};
+        push.projectionView = camera.getProjectionMatrix() * camera.getView();
+
+        VkBuffer buffer = ringBuffer->getBuffer();
+        VkDeviceSize offset = 0;
+        vkCmdBindVertexBuffers(commandBuffer, 0, 1, &buffer, &offset);
+
+        // triangles first so the outlines stay visible on top of filled volumes
+        for (Batch batch: {TRIANGLES_DEPTH, LINES_DEPTH, TRIANGLES_OVERLAY, LINES_OVERLAY}) {
+            if (batches[batch].empty()) continue;
+
+            pipelines[batch]->bind(commandBuffer);
+            vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0,
+                               sizeof(DebugDrawPushConstantData), &push);
+            vkCmdDraw(commandBuffer, static_cast<uint32_t>(batches[batch].size()), 1, batchFirstVertex[batch], 0);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,164 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef DEBUG_DRAW_SYSTEM_H
+#define DEBUG_DRAW_SYSTEM_H
+
+#include <array>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../../game/camera.h"
+#include "../../pipeline/vulkr_buffer.h"
+#include "../../pipeline/vulkr_device.hpp"
+#include "../../pipeline/vulkr_pipeline.h"
+
+#ifndef NDEBUG
+#define VULKR_DEBUG_DRAW 1
+#else
+#define VULKR_DEBUG_DRAW 0
+#endif
+
+namespace vulkr {
+    /**
+     * Immediate mode debug shapes. Everything queued between begin() and render() is written into the frame's
+     * segment of a persistently mapped ring buffer and drawn with at most one draw per topology and depth mode.
+     * With depthTest the shapes are hidden by scene geometry, without it they are drawn on top.
+     * In release builds (NDEBUG) every call is an empty inline function and no Vulkan objects are created.
+     */
+    class DebugDrawSystem {
+    public:
+        // vertices per frame, shapes past this are dropped
+        static constexpr uint32_t MAX_VERTICES = 65536;
+
+#if VULKR_DEBUG_DRAW
+        DebugDrawSystem(VulkrDevice &device, VkRenderPass renderPass);
+
+        ~DebugDrawSystem();
+#else
+        DebugDrawSystem(VulkrDevice &, VkRenderPass) {
+        }
+#endif
+
+        DebugDrawSystem(const DebugDrawSystem &) = delete;
+
+        DebugDrawSystem &operator=(const DebugDrawSystem &) = delete;
+
+#if VULKR_DEBUG_DRAW
+        void begin(int frameIndex);
+
+        void line(const glm::vec3 &a, const glm::vec3 &b, const glm::vec4 &color, bool depthTest = true);
+
+        /**
+         * Filled and alpha blended, e.g. for light volumes or culling regions.
+         */
+        void triangle(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c, const glm::vec4 &color,
+                      bool depthTest = true);
+
+        void box(const glm::vec3 &min, const glm::vec3 &max, const glm::vec4 &color, bool depthTest = true);
+
+        /**
+         * The cube [-1, 1]^3 transformed by transform, i.e. an oriented box.
+         */
+        void box(const glm::mat4 &transform, const glm::vec4 &color, bool depthTest = true);
+
+        /**
+         * Three great circles around the axes.
+         */
+        void sphere(const glm::vec3 &center, float radius, const glm::vec4 &color, bool depthTest = true,
+                    uint32_t segments = 24);
+
+        /**
+         * Outline of the volume a projection * view matrix sees, depth in [0, 1].
+         */
+        void frustum(const glm::mat4 &projectionView, const glm::vec4 &color, bool depthTest = true);
+
+        /**
+         * The x, y and z axes of transform in red, green and blue.
+         */
+        void axis(const glm::mat4 &transform, float size = 1.0f, bool depthTest = true);
+
+        /**
+         * Draws the batch, must be recorded inside a render pass with a depth attachment.
+         */
+        void render(VkCommandBuffer commandBuffer, const Camera &camera);
+
+        uint32_t getVertexCount() const { return vertexCount; }
+#else
+        void begin(int) {
+        }
+
+        void line(const glm::vec3 &, const glm::vec3 &, const glm::vec4 &, bool = true) {
+        }
+
+        void triangle(const glm::vec3 &, const glm::vec3 &, const glm::vec3 &, const glm::vec4 &, bool = true) {
+        }
+
+        void box(const glm::vec3 &, const glm::vec3 &, const glm::vec4 &, bool = true) {
+        }
+
+        void box(const glm::mat4 &, const glm::vec4 &, bool = true) {
+        }
+
+        void sphere(const glm::vec3 &, float, const glm::vec4 &, bool = true, uint32_t = 24) {
+        }
+
+        void frustum(const glm::mat4 &, const glm::vec4 &, bool = true) {
+        }
+
+        void axis(const glm::mat4 &, float = 1.0f, bool = true) {
+        }
+
+        void render(VkCommandBuffer, const Camera &) {
+        }
+
+        uint32_t getVertexCount() const { return 0; }
+#endif
+
+    private:
+#if VULKR_DEBUG_DRAW
+        struct DebugVertex {
+            glm::vec3 position;
+            uint32_t color;
+        };
+
+        // one bucket, and so one draw, per topology and depth mode
+        enum Batch : uint32_t {
+            LINES_DEPTH = 0,
+            LINES_OVERLAY,
+            TRIANGLES_DEPTH,
+            TRIANGLES_OVERLAY,
+            BATCH_COUNT
+        };
+
+        void createPipelineLayout();
+
+        void createPipelines(VkRenderPass renderPass);
+
+        void createBuffer();
+
+        /**
+         * Appends a whole primitive or nothing, so a full buffer never leaves half a line behind.
+         */
+        void push(Batch batch, std::initializer_list<glm::vec3> positions, uint32_t color);
+
+        static uint32_t packColor(const glm::vec4 &color);
+
+        VulkrDevice &vulkrDevice;
+        VkPipelineLayout pipelineLayout;
+        std::array<std::unique_ptr<VulkrPipeline>, BATCH_COUNT> pipelines;
+
+        // MAX_FRAMES_IN_FLIGHT segments of MAX_VERTICES, each frame slot writes only its own
+        std::unique_ptr<VulkrBuffer> ringBuffer;
+        std::array<std::vector<DebugVertex>, BATCH_COUNT> batches;
+        uint32_t segmentOffset{0};
+        uint32_t vertexCount{0};
+#endif
+    };
+}
+
+#endif //DEBUG_DRAW_SYSTEM_H
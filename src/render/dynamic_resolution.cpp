@@ -0,0 +1,46 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "dynamic_resolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace vulkr {
+    void DynamicResolutionController::update(float gpuMilliseconds) {
+        if (gpuMilliseconds <= 0.0f) {
+            return;
+        }
+
+        if (!hasSample) {
+            smoothedGpuMs = gpuMilliseconds;
+            hasSample = true;
+        } else {
+            smoothedGpuMs += (gpuMilliseconds - smoothedGpuMs) * settings.smoothing;
+        }
+
+        const float budget = settings.targetFrameMs * settings.headroom;
+        const float desired = scale * std::sqrt(budget / smoothedGpuMs);
+        const float delta = std::clamp(desired - scale, -settings.maxStepDown, settings.maxStepUp);
+
+        if (std::abs(delta) < settings.deadZone) {
+            return;
+        }
+
+        scale = std::clamp(scale + delta, settings.minScale, settings.maxScale);
+    }
+
+    void DynamicResolutionController::reset() {
+        scale = settings.maxScale;
+        smoothedGpuMs = 0.0f;
+        hasSample = false;
+    }
+
+    VkExtent2D DynamicResolutionController::getRenderExtent(VkExtent2D fullExtent) const {
+        const auto scaled = [this](uint32_t size) {
+            return std::clamp(static_cast<uint32_t>(std::lround(static_cast<float>(size) * scale)), 1u, size);
+        };
+        return {scaled(fullExtent.width), scaled(fullExtent.height)};
+    }
+}
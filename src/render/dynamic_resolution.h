@@ -0,0 +1,53 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include <vulkan/vulkan.h>
+
+namespace vulkr {
+    /**
+     * Picks the scene render scale from measured GPU frame time.
+     * GPU cost is treated as proportional to pixel count, so the scale moves with the square root of
+     * budget / measured time. Drops react quickly, recovery is rate limited so the resolution does not pump.
+     */
+    class DynamicResolutionController {
+    public:
+        struct Settings {
+            float targetFrameMs = 1000.0f / 60.0f;
+            float headroom = 0.9f; // fraction of the target the GPU is allowed to use
+            float minScale = 0.5f;
+            float maxScale = 1.0f;
+            float smoothing = 0.15f; // weight of the newest sample in the running average
+            float maxStepUp = 0.02f;
+            float maxStepDown = 0.1f;
+            float deadZone = 0.01f;
+        };
+
+        DynamicResolutionController() = default;
+
+        explicit DynamicResolutionController(const Settings &settings) : settings(settings) {
+        }
+
+        void update(float gpuMilliseconds);
+
+        void reset();
+
+        float getScale() const { return scale; }
+        float getSmoothedGpuMs() const { return smoothedGpuMs; }
+
+        Settings &getSettings() { return settings; }
+
+        VkExtent2D getRenderExtent(VkExtent2D fullExtent) const;
+
+    private:
+        Settings settings{};
+        float scale{1.0f};
+        float smoothedGpuMs{0.0f};
+        bool hasSample{false};
+    };
+}
+
+#endif //DYNAMIC_RESOLUTION_H
@@ -0,0 +1,23 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef FRAME_INFO_H
+#define FRAME_INFO_H
+
+#include <vulkan/vulkan.h>
+
+#include "../game/camera.h"
+
+namespace vulkr {
+    struct FrameInfo {
+        int frameIndex;
+        float frameTime;
+        VkCommandBuffer commandBuffer;
+        Camera &camera;
+        VkDescriptorSet globalDescriptorSet;
+        VkDescriptorSet shadowDescriptorSet;
+    };
+}
+
+#endif //FRAME_INFO_H
@@ -0,0 +1,902 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "render_graph.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <stdexcept>
+
+namespace vulkr {
+    namespace {
+        constexpr VkAccessFlags READ_ACCESS_MASK =
+                VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_INDEX_READ_BIT |
+                VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT |
+                VK_ACCESS_INPUT_ATTACHMENT_READ_BIT | VK_ACCESS_SHADER_READ_BIT |
+                VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_HOST_READ_BIT | VK_ACCESS_MEMORY_READ_BIT;
+    }
+
+    // ---------------------------------------------------------------------------------------------------------
+    // PassBuilder
+
+    void RenderGraph::PassBuilder::writeColor(ImageHandle image, VkAttachmentLoadOp loadOp,
+                                              VkClearColorValue clearColor) {
+        const bool load = loadOp == VK_ATTACHMENT_LOAD_OP_LOAD;
+        VkAccessFlags access = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        if (load) access |= VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
+
+        graph.addAccess(passIndex, image.index, true,
+                        {VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, access, true},
+                        load);
+
+        Attachment attachment{};
+        attachment.image = image.index;
+        attachment.loadOp = loadOp;
+        attachment.clearValue.color = clearColor;
+        graph.passes[passIndex].colorAttachments.push_back(attachment);
+    }
+
+    void RenderGraph::PassBuilder::writeDepth(ImageHandle image, VkAttachmentLoadOp loadOp, float clearDepth) {
+        // the depth test reads the attachment even when it was cleared
+        graph.addAccess(passIndex, image.index, true,
+                        {
+                            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                            VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                            true
+                        },
+                        loadOp == VK_ATTACHMENT_LOAD_OP_LOAD);
+
+        Pass &pass = graph.passes[passIndex];
+        pass.hasDepthAttachment = true;
+        pass.depthAttachment.image = image.index;
+        pass.depthAttachment.loadOp = loadOp;
+        pass.depthAttachment.clearValue.depthStencil = {clearDepth, 0};
+    }
+
+    void RenderGraph::PassBuilder::sampleImage(ImageHandle image, VkPipelineStageFlags stages) {
+        const VkImageLayout layout = isDepthFormat(graph.images[image.index].desc.format)
+                                         ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
+                                         : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        graph.addAccess(passIndex, image.index, true, {layout, stages, VK_ACCESS_SHADER_READ_BIT, false}, true);
+    }
+
+    void RenderGraph::PassBuilder::accessImage(ImageHandle image, VkImageLayout layout, VkPipelineStageFlags stages,
+                                               VkAccessFlags access, bool write) {
+        graph.addAccess(passIndex, image.index, true, {layout, stages, access, write},
+                        !write || (access & READ_ACCESS_MASK) != 0);
+    }
+
+    void RenderGraph::PassBuilder::readBuffer(BufferHandle buffer, VkPipelineStageFlags stages, VkAccessFlags access) {
+        graph.addAccess(passIndex, buffer.index, false, {VK_IMAGE_LAYOUT_UNDEFINED, stages, access, false}, true);
+    }
+
+    void RenderGraph::PassBuilder::writeBuffer(BufferHandle buffer, VkPipelineStageFlags stages, VkAccessFlags access) {
+        graph.addAccess(passIndex, buffer.index, false, {VK_IMAGE_LAYOUT_UNDEFINED, stages, access, true},
+                        (access & READ_ACCESS_MASK) != 0);
+    }
+
+    void RenderGraph::PassBuilder::setSideEffect() {
+        graph.passes[passIndex].sideEffect = true;
+    }
+
+    // ---------------------------------------------------------------------------------------------------------
+    // Declaration
+
+    RenderGraph::RenderGraph(VulkrDevice &device) : vulkrDevice(device) {
+    }
+
+    RenderGraph::~RenderGraph() {
+        releaseCompiledResources();
+        releaseRetainedImages();
+
+        VkDevice vkDevice = vulkrDevice.device();
+        for (auto &[key, renderPass]: renderPassCache) {
+            VkRenderPass pass = renderPass;
+            vulkrDevice.deletionQueue().retire(lastUsedFrameValue, [vkDevice, pass]() {
+                vkDestroyRenderPass(vkDevice, pass, nullptr);
+            });
+        }
+    }
+
+    RenderGraph::ImageHandle RenderGraph::createImage(const std::string &name, const ImageDesc &desc) {
+        Image image{};
+        image.name = name;
+        image.desc = desc;
+        images.push_back(image);
+        compiled = false;
+        return {static_cast<uint32_t>(images.size() - 1)};
+    }
+
+    RenderGraph::ImageHandle RenderGraph::importImage(const std::string &name, VkFormat format, VkExtent2D extent,
+                                                      VkImageLayout initialLayout, VkImageLayout finalLayout,
+                                                      VkPipelineStageFlags initialStages) {
+        Image image{};
+        image.name = name;
+        image.desc.format = format;
+        image.desc.extent = extent;
+        image.imported = true;
+        image.initialLayout = initialLayout;
+        image.finalLayout = finalLayout;
+        image.initialStages = initialStages;
+        images.push_back(image);
+        compiled = false;
+        return {static_cast<uint32_t>(images.size() - 1)};
+    }
+
+    RenderGraph::BufferHandle RenderGraph::importBuffer(const std::string &name) {
+        Buffer buffer{};
+        buffer.name = name;
+        buffers.push_back(buffer);
+        compiled = false;
+        return {static_cast<uint32_t>(buffers.size() - 1)};
+    }
+
+    RenderGraph::PassHandle RenderGraph::addPass(const std::string &name, const SetupFunction &setup,
+                                                 ExecuteFunction execute) {
+        Pass pass{};
+        pass.name = name;
+        pass.execute = std::move(execute);
+        passes.push_back(std::move(pass));
+        compiled = false;
+
+        const auto passIndex = static_cast<uint32_t>(passes.size() - 1);
+        PassBuilder builder{*this, passIndex};
+        setup(builder);
+        return {passIndex};
+    }
+
+    void RenderGraph::addAccess(uint32_t passIndex, uint32_t resource, bool isImage, const ResourceState &state,
+                                bool read) {
+        if (resource >= (isImage ? images.size() : buffers.size())) {
+            throw std::runtime_error("render graph pass '" + passes[passIndex].name + "' uses an invalid handle!");
+        }
+        passes[passIndex].accesses.push_back({resource, isImage, state, read});
+    }
+
+    void RenderGraph::reset() {
+        releaseCompiledResources();
+        images.clear();
+        buffers.clear();
+        passes.clear();
+        compiled = false;
+    }
+
+    void RenderGraph::setImportedImage(ImageHandle image, VkImage vkImage, VkImageView view) {
+        Image &target = images[image.index];
+        assert(target.imported && "Only imported images can be set!");
+        target.image = vkImage;
+        target.view = view;
+    }
+
+    void RenderGraph::setImportedBuffer(BufferHandle buffer, VkBuffer vkBuffer) {
+        buffers[buffer.index].buffer = vkBuffer;
+    }
+
+    void RenderGraph::setRenderArea(PassHandle pass, VkExtent2D extent) {
+        passes[pass.index].renderArea = extent;
+    }
+
+    VkRenderPass RenderGraph::getRenderPass(PassHandle pass) const {
+        assert(compiled && "Render graph has not been compiled!");
+        return passes[pass.index].renderPass;
+    }
+
+    VkImageView RenderGraph::getImageView(ImageHandle image) const {
+        return images[image.index].view;
+    }
+
+    VkExtent2D RenderGraph::getImageExtent(ImageHandle image) const {
+        return images[image.index].desc.extent;
+    }
+
+    bool RenderGraph::isPassCulled(PassHandle pass) const {
+        return passes[pass.index].culled;
+    }
+
+    // ---------------------------------------------------------------------------------------------------------
+    // Compilation
+
+    void RenderGraph::compile() {
+        releaseCompiledResources();
+
+        cullPasses();
+        computeLifetimes();
+        // e.g. a resize that fits the images, only the imports and render areas changed
+        if (!adoptRetainedImages()) {
+            releaseRetainedImages();
+            allocateTransientImages();
+        }
+        createRenderPasses();
+        planBarriers();
+
+        compiled = true;
+        generation++;
+    }
+
+    void RenderGraph::cullPasses() {
+        // walk backwards from the outputs, a pass survives if something downstream consumes what it writes
+        std::vector<bool> imageNeeded(images.size(), false);
+        std::vector<bool> bufferNeeded(buffers.size(), false);
+
+        for (size_t i = passes.size(); i-- > 0;) {
+            Pass &pass = passes[i];
+
+            bool keep = pass.sideEffect;
+            for (const auto &access: pass.accesses) {
+                if (!access.state.write) continue;
+                if (access.isImage) {
+                    keep |= images[access.resource].imported || imageNeeded[access.resource];
+                } else {
+                    // imported buffers are always external
+                    keep = true;
+                }
+            }
+
+            pass.culled = !keep;
+            if (pass.culled) continue;
+
+            // a pure write hides every earlier producer of the resource, reads make them needed again
+            for (const auto &access: pass.accesses) {
+                if (access.isImage && access.state.write && !access.read) {
+                    imageNeeded[access.resource] = false;
+                }
+            }
+            for (const auto &access: pass.accesses) {
+                if (!access.read) continue;
+                if (access.isImage) {
+                    imageNeeded[access.resource] = true;
+                } else {
+                    bufferNeeded[access.resource] = true;
+                }
+            }
+        }
+    }
+
+    void RenderGraph::computeLifetimes() {
+        for (auto &image: images) {
+            image.firstPass = UINT32_MAX;
+            image.lastPass = 0;
+            image.usage = image.desc.usage;
+            image.transientAttachment = false;
+        }
+
+        for (uint32_t i = 0; i < passes.size(); i++) {
+            if (passes[i].culled) continue;
+
+            for (const auto &access: passes[i].accesses) {
+                if (!access.isImage) continue;
+
+                Image &image = images[access.resource];
+                image.firstPass = std::min(image.firstPass, i);
+                image.lastPass = std::max(image.lastPass, i);
+                image.usage |= usageForLayout(access.state.layout);
+            }
+        }
+
+        // attachments that are written and consumed by the same pass never need backing memory on tilers
+        constexpr VkImageUsageFlags attachmentUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+                                                      VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT |
+                                                      VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+        for (auto &image: images) {
+            if (image.imported || image.firstPass == UINT32_MAX) continue;
+
+            if (image.firstPass == image.lastPass && (image.usage & ~attachmentUsage) == 0) {
+                image.transientAttachment = true;
+                image.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+            }
+        }
+    }
+
+    void RenderGraph::allocateTransientImages() {
+        VkDevice device = vulkrDevice.device();
+
+        std::vector<uint32_t> transients;
+        std::vector<VkMemoryRequirements> requirements(images.size());
+
+        for (uint32_t i = 0; i < images.size(); i++) {
+            Image &image = images[i];
+            if (image.imported || image.firstPass == UINT32_MAX) continue;
+
+            VkImageCreateInfo imageInfo{};
+            imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageInfo.imageType = VK_IMAGE_TYPE_2D;
+            imageInfo.extent.width = image.desc.extent.width;
+            imageInfo.extent.height = image.desc.extent.height;
+            imageInfo.extent.depth = 1;
+            imageInfo.mipLevels = 1;
+            imageInfo.arrayLayers = 1;
+            imageInfo.format = image.desc.format;
+            imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+            imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            imageInfo.usage = image.usage;
+            imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+            imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+            if (vkCreateImage(device, &imageInfo, nullptr, &image.image) != VK_SUCCESS) {
+                throw std::runtime_error("failed to create render graph image '" + image.name + "'!");
+            }
+
+            vkGetImageMemoryRequirements(device, image.image, &requirements[i]);
+            transients.push_back(i);
+        }
+
+        // largest first, each image goes into the first block none of whose images is alive at the same time
+        std::sort(transients.begin(), transients.end(), [&requirements](uint32_t a, uint32_t b) {
+            return requirements[a].size > requirements[b].size;
+        });
+
+        for (uint32_t index: transients) {
+            const Image &image = images[index];
+            const VkMemoryRequirements &memRequirements = requirements[index];
+
+            MemoryBlock *target = nullptr;
+            for (auto &block: memoryBlocks) {
+                // lazily allocated memory only takes transient attachments
+                if (block.transientAttachment != image.transientAttachment) continue;
+                if ((block.memoryTypeBits & memRequirements.memoryTypeBits) == 0) continue;
+
+                const bool overlaps = std::any_of(block.images.begin(), block.images.end(), [&](uint32_t other) {
+                    return images[other].firstPass <= image.lastPass && image.firstPass <= images[other].lastPass;
+                });
+                if (!overlaps) {
+                    target = &block;
+                    break;
+                }
+            }
+
+            if (target == nullptr) {
+                memoryBlocks.emplace_back();
+                target = &memoryBlocks.back();
+                target->transientAttachment = image.transientAttachment;
+            }
+
+            target->size = std::max(target->size, memRequirements.size);
+            target->alignment = std::max(target->alignment, memRequirements.alignment);
+            target->memoryTypeBits &= memRequirements.memoryTypeBits;
+            target->images.push_back(index);
+            unaliasedTransientMemorySize += memRequirements.size;
+        }
+
+        for (auto &block: memoryBlocks) {
+            VkMemoryAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            allocInfo.allocationSize = block.size;
+            allocInfo.memoryTypeIndex = block.transientAttachment
+                                            ? vulkrDevice.findTransientMemoryType(block.memoryTypeBits)
+                                            : vulkrDevice.findMemoryType(block.memoryTypeBits,
+                                                                         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+            if (vkAllocateMemory(device, &allocInfo, nullptr, &block.memory) != VK_SUCCESS) {
+                throw std::runtime_error("failed to allocate render graph memory!");
+            }
+            transientMemorySize += block.size;
+
+            // every image of a block starts at offset 0, their lifetimes never overlap
+            for (uint32_t index: block.images) {
+                Image &image = images[index];
+                if (vkBindImageMemory(device, image.image, block.memory, 0) != VK_SUCCESS) {
+                    throw std::runtime_error("failed to bind render graph image '" + image.name + "'!");
+                }
+
+                VkImageViewCreateInfo viewInfo{};
+                viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+                viewInfo.image = image.image;
+                viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+                viewInfo.format = image.desc.format;
+                viewInfo.subresourceRange.aspectMask = aspectForFormat(image.desc.format) & ~VK_IMAGE_ASPECT_STENCIL_BIT;
+                viewInfo.subresourceRange.baseMipLevel = 0;
+                viewInfo.subresourceRange.levelCount = 1;
+                viewInfo.subresourceRange.baseArrayLayer = 0;
+                viewInfo.subresourceRange.layerCount = 1;
+
+                if (vkCreateImageView(device, &viewInfo, nullptr, &image.view) != VK_SUCCESS) {
+                    throw std::runtime_error("failed to create render graph image view '" + image.name + "'!");
+                }
+            }
+        }
+    }
+
+    void RenderGraph::createRenderPasses() {
+        for (uint32_t i = 0; i < passes.size(); i++) {
+            Pass &pass = passes[i];
+            if (pass.culled || (pass.colorAttachments.empty() && !pass.hasDepthAttachment)) continue;
+
+            // only keep the contents if someone looks at them after this pass
+            auto resolveStoreOp = [this, i](Attachment &attachment) {
+                const Image &image = images[attachment.image];
+                attachment.storeOp = image.imported || image.lastPass > i
+                                         ? VK_ATTACHMENT_STORE_OP_STORE
+                                         : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            };
+
+            // attachments may be larger than the pass, transients are kept across resizes that fit them
+            pass.extent = {UINT32_MAX, UINT32_MAX};
+            auto fitExtent = [this, &pass](const Attachment &attachment) {
+                const VkExtent2D extent = images[attachment.image].desc.extent;
+                pass.extent.width = std::min(pass.extent.width, extent.width);
+                pass.extent.height = std::min(pass.extent.height, extent.height);
+            };
+
+            for (auto &attachment: pass.colorAttachments) {
+                resolveStoreOp(attachment);
+                fitExtent(attachment);
+            }
+            if (pass.hasDepthAttachment) {
+                resolveStoreOp(pass.depthAttachment);
+                fitExtent(pass.depthAttachment);
+            }
+
+            pass.renderPass = getOrCreateRenderPass(pass);
+        }
+    }
+
+    VkRenderPass RenderGraph::getOrCreateRenderPass(const Pass &pass) {
+        std::vector<VkAttachmentDescription> attachments;
+        std::vector<VkAttachmentReference> colorRefs;
+        std::string key;
+
+        auto describe = [&](const Attachment &attachment, VkImageLayout layout) {
+            VkAttachmentDescription description{};
+            description.format = images[attachment.image].desc.format;
+            description.samples = VK_SAMPLE_COUNT_1_BIT;
+            description.loadOp = attachment.loadOp;
+            description.storeOp = attachment.storeOp;
+            description.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            description.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            // the graph's barriers do the layout transitions, the render pass never changes layouts
+            description.initialLayout = layout;
+            description.finalLayout = layout;
+            attachments.push_back(description);
+
+            key += std::to_string(description.format) + ":" + std::to_string(description.loadOp) + ":" +
+                    std::to_string(description.storeOp) + ";";
+            return VkAttachmentReference{static_cast<uint32_t>(attachments.size() - 1), layout};
+        };
+
+        for (const auto &attachment: pass.colorAttachments) {
+            colorRefs.push_back(describe(attachment, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL));
+        }
+        key += "|";
+        VkAttachmentReference depthRef{};
+        if (pass.hasDepthAttachment) {
+            depthRef = describe(pass.depthAttachment, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+        }
+
+        auto cached = renderPassCache.find(key);
+        if (cached != renderPassCache.end()) {
+            return cached->second;
+        }
+
+        VkSubpassDescription subpass{};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount = static_cast<uint32_t>(colorRefs.size());
+        subpass.pColorAttachments = colorRefs.data();
+        subpass.pDepthStencilAttachment = pass.hasDepthAttachment ? &depthRef : nullptr;
+
+        VkRenderPassCreateInfo renderPassInfo{};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+        renderPassInfo.pAttachments = attachments.data();
+        renderPassInfo.subpassCount = 1;
+        renderPassInfo.pSubpasses = &subpass;
+
+        VkRenderPass renderPass;
+        if (vkCreateRenderPass(vulkrDevice.device(), &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create render graph render pass!");
+        }
+
+        renderPassCache[key] = renderPass;
+        return renderPass;
+    }
+
+    void RenderGraph::planBarriers() {
+        std::vector<SyncState> imageStates(images.size());
+        std::vector<SyncState> bufferStates(buffers.size());
+
+        for (size_t i = 0; i < images.size(); i++) {
+            SyncState &sync = imageStates[i];
+            const Image &image = images[i];
+            sync.touched = true;
+            if (image.imported) {
+                sync.layout = image.initialLayout;
+                sync.syncStages = image.initialStages;
+            } else {
+                // the memory may hold an aliased image or the previous frame's copy, wait for all of it
+                sync.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+                sync.syncStages = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+                sync.syncAccess = VK_ACCESS_MEMORY_WRITE_BIT;
+            }
+        }
+
+        for (auto &pass: passes) {
+            pass.barriers.clear();
+            if (pass.culled) continue;
+
+            // merge multiple declarations of the same resource into one access
+            std::vector<Access> merged;
+            for (const auto &access: pass.accesses) {
+                auto existing = std::find_if(merged.begin(), merged.end(), [&access](const Access &other) {
+                    return other.isImage == access.isImage && other.resource == access.resource;
+                });
+                if (existing == merged.end()) {
+                    merged.push_back(access);
+                    continue;
+                }
+                if (access.isImage && existing->state.layout != access.state.layout) {
+                    throw std::runtime_error("render graph pass '" + pass.name + "' uses image '" +
+                                             images[access.resource].name + "' in two layouts!");
+                }
+                existing->state.stages |= access.state.stages;
+                existing->state.access |= access.state.access;
+                existing->state.write |= access.state.write;
+                existing->read |= access.read;
+            }
+
+            for (const auto &access: merged) {
+                SyncState &sync = access.isImage ? imageStates[access.resource] : bufferStates[access.resource];
+                planAccess(pass.barriers, sync, access.resource, access.isImage, access.state);
+            }
+        }
+
+        finalBarriers.clear();
+        for (uint32_t i = 0; i < images.size(); i++) {
+            const Image &image = images[i];
+            const SyncState &sync = imageStates[i];
+            if (!image.imported || image.finalLayout == VK_IMAGE_LAYOUT_UNDEFINED || sync.layout == image.finalLayout) {
+                continue;
+            }
+
+            Barrier barrier{};
+            barrier.resource = i;
+            barrier.isImage = true;
+            barrier.src = {sync.layout, sync.syncStages | sync.readStages, sync.syncAccess, false};
+            barrier.dst = {image.finalLayout, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, false};
+            finalBarriers.push_back(barrier);
+        }
+    }
+
+    void RenderGraph::planAccess(std::vector<Barrier> &barriers, SyncState &sync, uint32_t resource, bool isImage,
+                                 const ResourceState &dst) {
+        // imported buffers are idle when the graph starts, their frame slot has already been waited on
+        if (!sync.touched) {
+            sync.touched = true;
+            sync.syncStages = dst.stages;
+            sync.syncAccess = dst.write ? dst.access : 0;
+            sync.readStages = dst.write ? 0 : dst.stages;
+            return;
+        }
+
+        const bool layoutChange = isImage && sync.layout != dst.layout;
+
+        if (!layoutChange && !dst.write) {
+            // read after read needs nothing, unless these stages have not seen the last write yet
+            if ((dst.stages & ~sync.readStages) == 0) return;
+
+            barriers.push_back({resource, isImage, {sync.layout, sync.syncStages, sync.syncAccess, false}, dst});
+            sync.readStages |= dst.stages;
+            return;
+        }
+
+        barriers.push_back({
+            resource, isImage, {sync.layout, sync.syncStages | sync.readStages, sync.syncAccess, false}, dst
+        });
+
+        // later barriers chain on this one, which already made earlier writes available
+        sync.layout = dst.layout;
+        sync.syncStages = dst.stages;
+        sync.syncAccess = dst.write ? dst.access : 0;
+        sync.readStages = dst.write ? 0 : dst.stages;
+    }
+
+    // ---------------------------------------------------------------------------------------------------------
+    // Execution
+
+    void RenderGraph::execute(VkCommandBuffer commandBuffer) {
+        assert(compiled && "Render graph must be compiled before it is executed!");
+        lastUsedFrameValue = vulkrDevice.frameTimeline().getCurrentValue();
+
+        for (auto &pass: passes) {
+            if (pass.culled) continue;
+
+            recordBarriers(commandBuffer, pass.barriers);
+
+            if (pass.renderPass == VK_NULL_HANDLE) {
+                pass.execute(commandBuffer);
+                continue;
+            }
+
+            VkExtent2D renderArea = pass.extent;
+            if (pass.renderArea.width != 0 && pass.renderArea.height != 0) {
+                renderArea.width = std::min(renderArea.width, pass.renderArea.width);
+                renderArea.height = std::min(renderArea.height, pass.renderArea.height);
+            }
+
+            std::vector<VkClearValue> clearValues;
+            for (const auto &attachment: pass.colorAttachments) {
+                clearValues.push_back(attachment.clearValue);
+            }
+            if (pass.hasDepthAttachment) {
+                clearValues.push_back(pass.depthAttachment.clearValue);
+            }
+
+            VkRenderPassBeginInfo renderPassInfo{};
+            renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            renderPassInfo.renderPass = pass.renderPass;
+            renderPassInfo.framebuffer = getOrCreateFramebuffer(pass);
+            renderPassInfo.renderArea.offset = {0, 0};
+            renderPassInfo.renderArea.extent = renderArea;
+            renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
+            renderPassInfo.pClearValues = clearValues.data();
+
+            vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+            VkViewport viewport{};
+            viewport.x = 0.0f;
+            viewport.y = 0.0f;
+            viewport.width = static_cast<float>(renderArea.width);
+            viewport.height = static_cast<float>(renderArea.height);
+            viewport.minDepth = 0.0f;
+            viewport.maxDepth = 1.0f;
+            VkRect2D scissor{{0, 0}, renderArea};
+            vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+            vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+            pass.execute(commandBuffer);
+
+            vkCmdEndRenderPass(commandBuffer);
+        }
+
+        recordBarriers(commandBuffer, finalBarriers);
+    }
+
+    VkFramebuffer RenderGraph::getOrCreateFramebuffer(Pass &pass) {
+        std::vector<VkImageView> views;
+        for (const auto &attachment: pass.colorAttachments) {
+            views.push_back(images[attachment.image].view);
+        }
+        if (pass.hasDepthAttachment) {
+            views.push_back(images[pass.depthAttachment.image].view);
+        }
+
+        for (size_t i = 0; i < views.size(); i++) {
+            if (views[i] == VK_NULL_HANDLE) {
+                throw std::runtime_error("render graph pass '" + pass.name + "' has an attachment that was not set!");
+            }
+        }
+
+        // imported attachments such as the swap chain image change every frame, keep one framebuffer per set
+        auto cached = pass.framebuffers.find(views);
+        if (cached != pass.framebuffers.end()) {
+            return cached->second;
+        }
+
+        VkFramebufferCreateInfo framebufferInfo{};
+        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass = pass.renderPass;
+        framebufferInfo.attachmentCount = static_cast<uint32_t>(views.size());
+        framebufferInfo.pAttachments = views.data();
+        framebufferInfo.width = pass.extent.width;
+        framebufferInfo.height = pass.extent.height;
+        framebufferInfo.layers = 1;
+
+        VkFramebuffer framebuffer;
+        if (vkCreateFramebuffer(vulkrDevice.device(), &framebufferInfo, nullptr, &framebuffer) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create render graph framebuffer!");
+        }
+
+        pass.framebuffers[views] = framebuffer;
+        return framebuffer;
+    }
+
+    void RenderGraph::recordBarriers(VkCommandBuffer commandBuffer, const std::vector<Barrier> &barriers) const {
+        if (barriers.empty()) return;
+
+        std::vector<VkImageMemoryBarrier> imageBarriers;
+        std::vector<VkBufferMemoryBarrier> bufferBarriers;
+        VkPipelineStageFlags srcStages = 0;
+        VkPipelineStageFlags dstStages = 0;
+
+        for (const auto &barrier: barriers) {
+            srcStages |= barrier.src.stages;
+            dstStages |= barrier.dst.stages;
+
+            if (barrier.isImage) {
+                const Image &image = images[barrier.resource];
+                if (image.image == VK_NULL_HANDLE) {
+                    throw std::runtime_error("render graph image '" + image.name + "' was not set!");
+                }
+
+                VkImageMemoryBarrier imageBarrier{};
+                imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                imageBarrier.srcAccessMask = barrier.src.access;
+                imageBarrier.dstAccessMask = barrier.dst.access;
+                imageBarrier.oldLayout = barrier.src.layout;
+                imageBarrier.newLayout = barrier.dst.layout;
+                imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                imageBarrier.image = image.image;
+                imageBarrier.subresourceRange.aspectMask = aspectForFormat(image.desc.format);
+                imageBarrier.subresourceRange.baseMipLevel = 0;
+                imageBarrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+                imageBarrier.subresourceRange.baseArrayLayer = 0;
+                imageBarrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+                imageBarriers.push_back(imageBarrier);
+            } else {
+                const Buffer &buffer = buffers[barrier.resource];
+                if (buffer.buffer == VK_NULL_HANDLE) {
+                    throw std::runtime_error("render graph buffer '" + buffer.name + "' was not set!");
+                }
+
+                VkBufferMemoryBarrier bufferBarrier{};
+                bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+                bufferBarrier.srcAccessMask = barrier.src.access;
+                bufferBarrier.dstAccessMask = barrier.dst.access;
+                bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                bufferBarrier.buffer = buffer.buffer;
+                bufferBarrier.offset = 0;
+                bufferBarrier.size = VK_WHOLE_SIZE;
+                bufferBarriers.push_back(bufferBarrier);
+            }
+        }
+
+        if (srcStages == 0) srcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        if (dstStages == 0) dstStages = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer, srcStages, dstStages, 0, 0, nullptr,
+                             static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(),
+                             static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+    }
+
+    void RenderGraph::releaseCompiledResources() {
+        VkDevice vkDevice = vulkrDevice.device();
+        auto &deletionQueue = vulkrDevice.deletionQueue();
+
+        for (auto &pass: passes) {
+            for (auto &[views, framebuffer]: pass.framebuffers) {
+                VkFramebuffer fb = framebuffer;
+                deletionQueue.retire(lastUsedFrameValue, [vkDevice, fb]() {
+                    vkDestroyFramebuffer(vkDevice, fb, nullptr);
+                });
+            }
+            pass.framebuffers.clear();
+            pass.renderPass = VK_NULL_HANDLE;
+            pass.barriers.clear();
+        }
+
+        retainTransientImages();
+        finalBarriers.clear();
+
+        transientMemorySize = 0;
+        unaliasedTransientMemorySize = 0;
+        compiled = false;
+    }
+
+    void RenderGraph::retainTransientImages() {
+        // nothing was allocated since the last retain, keep what is already set aside
+        if (memoryBlocks.empty()) return;
+        releaseRetainedImages();
+
+        retainedImages = images;
+        retainedBlocks = std::move(memoryBlocks);
+        retainedUnaliasedSize = unaliasedTransientMemorySize;
+        memoryBlocks.clear();
+
+        for (auto &image: images) {
+            if (image.imported) continue;
+            image.image = VK_NULL_HANDLE;
+            image.view = VK_NULL_HANDLE;
+        }
+    }
+
+    bool RenderGraph::adoptRetainedImages() {
+        if (retainedBlocks.empty() || retainedImages.size() != images.size()) return false;
+
+        // the aliasing plan follows from the lifetimes, so those have to match as well
+        for (uint32_t i = 0; i < images.size(); i++) {
+            const Image &image = images[i];
+            const Image &retained = retainedImages[i];
+            if (image.imported != retained.imported) return false;
+            if (image.imported) continue;
+
+            if (image.name != retained.name || image.desc.format != retained.desc.format ||
+                image.desc.extent.width != retained.desc.extent.width ||
+                image.desc.extent.height != retained.desc.extent.height || image.usage != retained.usage ||
+                image.transientAttachment != retained.transientAttachment ||
+                image.firstPass != retained.firstPass || image.lastPass != retained.lastPass) {
+                return false;
+            }
+        }
+
+        for (uint32_t i = 0; i < images.size(); i++) {
+            if (images[i].imported) continue;
+            images[i].image = retainedImages[i].image;
+            images[i].view = retainedImages[i].view;
+        }
+        memoryBlocks = std::move(retainedBlocks);
+        for (const auto &block: memoryBlocks) {
+            transientMemorySize += block.size;
+        }
+        unaliasedTransientMemorySize = retainedUnaliasedSize;
+
+        retainedImages.clear();
+        retainedBlocks.clear();
+        retainedUnaliasedSize = 0;
+        return true;
+    }
+
+    void RenderGraph::releaseRetainedImages() {
+        VkDevice vkDevice = vulkrDevice.device();
+        auto &deletionQueue = vulkrDevice.deletionQueue();
+
+        for (const auto &image: retainedImages) {
+            if (image.imported || image.image == VK_NULL_HANDLE) continue;
+            deletionQueue.retireImage(image.image, image.view, VK_NULL_HANDLE, lastUsedFrameValue);
+        }
+
+        // the images bound to the blocks are retired first, in the same frame
+        for (const auto &block: retainedBlocks) {
+            VkDeviceMemory memory = block.memory;
+            if (memory == VK_NULL_HANDLE) continue;
+            deletionQueue.retire(lastUsedFrameValue, [vkDevice, memory]() {
+                vkFreeMemory(vkDevice, memory, nullptr);
+            });
+        }
+
+        retainedImages.clear();
+        retainedBlocks.clear();
+        retainedUnaliasedSize = 0;
+    }
+
+    // ---------------------------------------------------------------------------------------------------------
+    // Helpers
+
+    bool RenderGraph::isDepthFormat(VkFormat format) {
+        switch (format) {
+            case VK_FORMAT_D16_UNORM:
+            case VK_FORMAT_X8_D24_UNORM_PACK32:
+            case VK_FORMAT_D32_SFLOAT:
+            case VK_FORMAT_D16_UNORM_S8_UINT:
+            case VK_FORMAT_D24_UNORM_S8_UINT:
+            case VK_FORMAT_D32_SFLOAT_S8_UINT:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    VkImageAspectFlags RenderGraph::aspectForFormat(VkFormat format) {
+        switch (format) {
+            case VK_FORMAT_D16_UNORM_S8_UINT:
+            case VK_FORMAT_D24_UNORM_S8_UINT:
+            case VK_FORMAT_D32_SFLOAT_S8_UINT:
+                return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+            default:
+                return isDepthFormat(format) ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+        }
+    }
+
+    VkImageUsageFlags RenderGraph::usageForLayout(VkImageLayout layout) {
+        switch (layout) {
+            case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+                return VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+            case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+                return VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+            case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+            case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:
+                return VK_IMAGE_USAGE_SAMPLED_BIT;
+            case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+                return VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+            case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+                return VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+            case VK_IMAGE_LAYOUT_GENERAL:
+                return VK_IMAGE_USAGE_STORAGE_BIT;
+            default:
+                return 0;
+        }
+    }
+}
@@ -0,0 +1,298 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef RENDER_GRAPH_H
+#define RENDER_GRAPH_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../../pipeline/vulkr_device.hpp"
+
+namespace vulkr {
+    /**
+     * Frame graph. Passes declare which images and buffers they read and write, compile() then
+     * - culls passes whose results never reach an imported resource or a side effect,
+     * - creates the transient images, aliasing the memory of images whose lifetimes do not overlap,
+     *   attachments that never leave their render pass get lazily allocated memory where available,
+     *   the images of the previous compile are kept when the same ones are declared again,
+     * - creates render passes and framebuffers for passes with attachments, a pass renders the area that all
+     *   of its attachments cover,
+     * - plans the pipeline barriers and layout transitions between passes.
+     * execute() records everything into a command buffer. The graph is declared once and rebuilt with
+     * reset() + compile() when its inputs change (e.g. on resize); imported resources may change every frame.
+     */
+    class RenderGraph {
+    public:
+        struct ImageHandle {
+            uint32_t index = UINT32_MAX;
+            bool isValid() const { return index != UINT32_MAX; }
+        };
+
+        struct BufferHandle {
+            uint32_t index = UINT32_MAX;
+            bool isValid() const { return index != UINT32_MAX; }
+        };
+
+        struct PassHandle {
+            uint32_t index = UINT32_MAX;
+            bool isValid() const { return index != UINT32_MAX; }
+        };
+
+        struct ImageDesc {
+            VkExtent2D extent{};
+            VkFormat format{VK_FORMAT_UNDEFINED};
+            /**
+             * Usage on top of what the declared accesses imply.
+             */
+            VkImageUsageFlags usage{0};
+        };
+
+        class PassBuilder {
+        public:
+            void writeColor(ImageHandle image, VkAttachmentLoadOp loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+                            VkClearColorValue clearColor = {{0.0f, 0.0f, 0.0f, 1.0f}});
+
+            void writeDepth(ImageHandle image, VkAttachmentLoadOp loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+                            float clearDepth = 1.0f);
+
+            /**
+             * Sampled in shaders, in SHADER_READ_ONLY or DEPTH_STENCIL_READ_ONLY layout depending on the format.
+             */
+            void sampleImage(ImageHandle image, VkPipelineStageFlags stages = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+
+            /**
+             * Raw access for passes that record their own render passes or copies.
+             */
+            void accessImage(ImageHandle image, VkImageLayout layout, VkPipelineStageFlags stages,
+                             VkAccessFlags access, bool write);
+
+            void readBuffer(BufferHandle buffer, VkPipelineStageFlags stages,
+                            VkAccessFlags access = VK_ACCESS_SHADER_READ_BIT);
+
+            void writeBuffer(BufferHandle buffer, VkPipelineStageFlags stages,
+                             VkAccessFlags access = VK_ACCESS_SHADER_WRITE_BIT);
+
+            /**
+             * Keeps the pass even if nothing reads its results.
+             */
+            void setSideEffect();
+
+        private:
+            friend class RenderGraph;
+
+            PassBuilder(RenderGraph &graph, uint32_t passIndex) : graph(graph), passIndex(passIndex) {
+            }
+
+            RenderGraph &graph;
+            uint32_t passIndex;
+        };
+
+        using SetupFunction = std::function<void(PassBuilder &)>;
+        using ExecuteFunction = std::function<void(VkCommandBuffer)>;
+
+        explicit RenderGraph(VulkrDevice &device);
+
+        ~RenderGraph();
+
+        RenderGraph(const RenderGraph &) = delete;
+
+        RenderGraph &operator=(const RenderGraph &) = delete;
+
+        ImageHandle createImage(const std::string &name, const ImageDesc &desc);
+
+        /**
+         * An image owned outside the graph, set with setImportedImage before each execute. It is expected in
+         * initialLayout, last used at initialStages, and left in finalLayout.
+         */
+        ImageHandle importImage(const std::string &name, VkFormat format, VkExtent2D extent,
+                                VkImageLayout initialLayout, VkImageLayout finalLayout,
+                                VkPipelineStageFlags initialStages = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+
+        BufferHandle importBuffer(const std::string &name);
+
+        PassHandle addPass(const std::string &name, const SetupFunction &setup, ExecuteFunction execute);
+
+        void compile();
+
+        void execute(VkCommandBuffer commandBuffer);
+
+        /**
+         * Drops all passes and resources so the graph can be declared again. Render passes are cached, transient
+         * images are set aside for the next compile() in case it declares them unchanged.
+         */
+        void reset();
+
+        void setImportedImage(ImageHandle image, VkImage vkImage, VkImageView view);
+
+        void setImportedBuffer(BufferHandle buffer, VkBuffer vkBuffer);
+
+        /**
+         * Restricts a pass to part of its attachments, e.g. for dynamic resolution. Defaults to the full extent.
+         */
+        void setRenderArea(PassHandle pass, VkExtent2D extent);
+
+        VkRenderPass getRenderPass(PassHandle pass) const;
+        VkImageView getImageView(ImageHandle image) const;
+        VkExtent2D getImageExtent(ImageHandle image) const;
+        bool isPassCulled(PassHandle pass) const;
+
+        /**
+         * Bumped by every compile(), image views handed out by an older generation are gone.
+         */
+        uint32_t getGeneration() const { return generation; }
+
+        VkDeviceSize getTransientMemorySize() const { return transientMemorySize; }
+        VkDeviceSize getUnaliasedTransientMemorySize() const { return unaliasedTransientMemorySize; }
+
+    private:
+        struct ResourceState {
+            VkImageLayout layout{VK_IMAGE_LAYOUT_UNDEFINED};
+            VkPipelineStageFlags stages{0};
+            VkAccessFlags access{0};
+            bool write{false};
+        };
+
+        /**
+         * What the barrier planner knows about a resource between passes.
+         */
+        struct SyncState {
+            bool touched{false};
+            VkImageLayout layout{VK_IMAGE_LAYOUT_UNDEFINED};
+            // stages and writes the next hazard has to wait on
+            VkPipelineStageFlags syncStages{0};
+            VkAccessFlags syncAccess{0};
+            // stages that already see the last write
+            VkPipelineStageFlags readStages{0};
+        };
+
+        struct Access {
+            uint32_t resource;
+            bool isImage;
+            ResourceState state;
+            bool read;
+        };
+
+        struct Attachment {
+            uint32_t image;
+            VkAttachmentLoadOp loadOp;
+            VkAttachmentStoreOp storeOp{VK_ATTACHMENT_STORE_OP_STORE};
+            VkClearValue clearValue;
+        };
+
+        struct Barrier {
+            uint32_t resource;
+            bool isImage;
+            ResourceState src;
+            ResourceState dst;
+        };
+
+        struct Image {
+            std::string name;
+            ImageDesc desc;
+            bool imported{false};
+            VkImage image{VK_NULL_HANDLE};
+            VkImageView view{VK_NULL_HANDLE};
+            VkImageLayout initialLayout{VK_IMAGE_LAYOUT_UNDEFINED};
+            VkImageLayout finalLayout{VK_IMAGE_LAYOUT_UNDEFINED};
+            VkPipelineStageFlags initialStages{VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT};
+            uint32_t firstPass{UINT32_MAX};
+            uint32_t lastPass{0};
+            // desc.usage plus what the accesses imply, derived by every compile
+            VkImageUsageFlags usage{0};
+            // lives and dies inside a single render pass, may be lazily allocated
+            bool transientAttachment{false};
+        };
+
+        struct Buffer {
+            std::string name;
+            VkBuffer buffer{VK_NULL_HANDLE};
+        };
+
+        struct Pass {
+            std::string name;
+            std::vector<Access> accesses;
+            std::vector<Attachment> colorAttachments;
+            bool hasDepthAttachment{false};
+            Attachment depthAttachment{};
+            bool sideEffect{false};
+            bool culled{false};
+            ExecuteFunction execute;
+            VkRenderPass renderPass{VK_NULL_HANDLE};
+            VkExtent2D extent{};
+            VkExtent2D renderArea{};
+            std::vector<Barrier> barriers;
+            std::map<std::vector<VkImageView>, VkFramebuffer> framebuffers;
+        };
+
+        struct MemoryBlock {
+            VkDeviceSize size{0};
+            VkDeviceSize alignment{1};
+            uint32_t memoryTypeBits{~0u};
+            bool transientAttachment{false};
+            std::vector<uint32_t> images;
+            VkDeviceMemory memory{VK_NULL_HANDLE};
+        };
+
+        static bool isDepthFormat(VkFormat format);
+
+        static VkImageAspectFlags aspectForFormat(VkFormat format);
+
+        static VkImageUsageFlags usageForLayout(VkImageLayout layout);
+
+        void addAccess(uint32_t passIndex, uint32_t resource, bool isImage, const ResourceState &state, bool read);
+
+        void planAccess(std::vector<Barrier> &barriers, SyncState &sync, uint32_t resource, bool isImage,
+                        const ResourceState &dst);
+
+        void cullPasses();
+
+        void computeLifetimes();
+
+        void allocateTransientImages();
+
+        void createRenderPasses();
+
+        void planBarriers();
+
+        VkRenderPass getOrCreateRenderPass(const Pass &pass);
+
+        VkFramebuffer getOrCreateFramebuffer(Pass &pass);
+
+        void recordBarriers(VkCommandBuffer commandBuffer, const std::vector<Barrier> &barriers) const;
+
+        void releaseCompiledResources();
+
+        void retainTransientImages();
+
+        bool adoptRetainedImages();
+
+        void releaseRetainedImages();
+
+        VulkrDevice &vulkrDevice;
+
+        std::vector<Image> images;
+        std::vector<Buffer> buffers;
+        std::vector<Pass> passes;
+        std::vector<MemoryBlock> memoryBlocks;
+        std::vector<Barrier> finalBarriers;
+        std::map<std::string, VkRenderPass> renderPassCache;
+
+        // transient images of the last compile and their memory, waiting for a declaration that matches them
+        std::vector<Image> retainedImages;
+        std::vector<MemoryBlock> retainedBlocks;
+        VkDeviceSize retainedUnaliasedSize{0};
+
+        bool compiled{false};
+        uint32_t generation{0};
+        uint64_t lastUsedFrameValue{0};
+        VkDeviceSize transientMemorySize{0};
+        VkDeviceSize unaliasedTransientMemorySize{0};
+    };
+}
+
+#endif //RENDER_GRAPH_H
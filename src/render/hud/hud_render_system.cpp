@@ -3,159 +3,293 @@
 //
 
 #include "hud_render_system.h"
-#include <glm/gtc/matrix_transform.hpp>
-#include <stdexcept>
+#include <algorithm>
 #include <array>
-#include <iostream>
-#include <string>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+#include "../../pipeline/vulkr_swap_chain.hpp"
 
 namespace vulkr {
-    // Push constant structure for the HUD
     struct HudPushConstantData {
-        glm::mat4 transform{1.0f};
+        glm::vec2 pixelToNdc{0.0f}; // 2 / screen extent
     };
 
-    // Vertex definitions for numbers 0-9
-    // Each number is defined within a 1x1 box
+    // Glyphs of the built-in 5x7 font, one byte per row from the top, bit 4 is the leftmost column
     namespace {
-        // --- 0 ---
-        const std::vector<VulkrModel::Vertex> vertices_0 = {
-            {{-0.5f, 0.0f, 0}}, {{-0.25f, 0.5f, 0}}, {{0.25f, 0.5f, 0}}, {{0.5f, 0.0f, 0}},
-            {{0.25f, -0.5f, 0}}, {{-0.25f, -0.5f, 0}}
-        };
-        const std::vector<uint32_t> indices_0 = {
-            0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 0
+        constexpr char FIRST_GLYPH = ' ';
+        constexpr char LAST_GLYPH = 127; // solid cell, used for rectangles
+        constexpr uint32_t GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+        constexpr uint32_t ATLAS_COLUMNS = 16;
+
+        struct Glyph {
+            char character;
+            std::array<uint8_t, 7> rows;
         };
 
-        // --- 1 ---
-        const std::vector<VulkrModel::Vertex> vertices_1 = {
-            {{0.0f, -0.5f, 0}}, {{0.0f, 0.5f, 0}}
-        };
-        const std::vector<uint32_t> indices_1 = {
-            0, 1
-        };
+        const std::array<Glyph, 58> fontGlyphs = {{
+            {'0', {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}},
+            {'1', {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}},
+            {'2', {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}},
+            {'3', {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}},
+            {'4', {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}},
+            {'5', {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}},
+            {'6', {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}},
+            {'7', {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}},
+            {'8', {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}},
+            {'9', {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}},
+            {'A', {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}},
+            {'B', {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}},
+            {'C', {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}},
+            {'D', {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}},
+            {'E', {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}},
+            {'F', {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}},
+            {'G', {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}},
+            {'H', {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}},
+            {'I', {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}},
+            {'J', {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}},
+            {'K', {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}},
+            {'L', {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}},
+            {'M', {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}},
+            {'N', {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}},
+            {'O', {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},
+            {'P', {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}},
+            {'Q', {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}},
+            {'R', {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}},
+            {'S', {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}},
+            {'T', {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}},
+            {'U', {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},
+            {'V', {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}},
+            {'W', {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}},
+            {'X', {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}},
+            {'Y', {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04}},
+            {'Z', {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}},
+            {'.', {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}},
+            {',', {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08}},
+            {':', {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00}},
+            {'-', {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}},
+            {'+', {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}},
+            {'/', {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}},
+            {'%', {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}},
+            {'(', {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02}},
+            {')', {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08}},
+            {'[', {0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E}},
+            {']', {0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E}},
+            {'<', {0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02}},
+            {'>', {0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08}},
+            {'=', {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00}},
+            {'!', {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04}},
+            {'?', {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}},
+            {'_', {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F}},
+            {'|', {0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}},
+            {'*', {0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00}},
+            {'#', {0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A}},
+            {'\'', {0x0C, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00}},
+            {'"', {0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00}},
+        }};
+
+        char glyphFor(char c) {
+            if (c >= 'a' && c <= 'z') return static_cast<char>(c - 'a' + 'A');
+            if (c < FIRST_GLYPH || c >= LAST_GLYPH) return '?';
+            return c;
+        }
 
-        // --- 2 ---
-        const std::vector<VulkrModel::Vertex> vertices_2 = {
-            {{-0.5f, -0.5f, 0}}, {{0.5f, -0.5f, 0}}, {{0.5f, 0.0f, 0}}, {{-0.5f, 0.0f, 0}},
-            {{-0.5f, 0.5f, 0}}, {{0.5f, 0.5f, 0}}
-        };
-        const std::vector<uint32_t> indices_2 = {
-            0, 1, 1, 2, 2, 3, 3, 4, 4, 5
-        };
+        // formats into the end of buffer and returns the first character, no allocation
+        std::string_view formatInteger(long long value, char *buffer, size_t size) {
+            char *end = buffer + size;
+            char *cursor = end;
+            const bool negative = value < 0;
+            unsigned long long magnitude = negative ? 0ull - static_cast<unsigned long long>(value)
+                                                    : static_cast<unsigned long long>(value);
+            do {
+                *--cursor = static_cast<char>('0' + magnitude % 10);
+                magnitude /= 10;
+            } while (magnitude != 0 && cursor > buffer + 1);
+            if (negative) *--cursor = '-';
+            return {cursor, static_cast<size_t>(end - cursor)};
+        }
+    } // anonymous namespace
 
-        // --- 3 ---
-        const std::vector<VulkrModel::Vertex> vertices_3 = {
-            {{-0.5f, -0.5f, 0}}, {{0.5f, -0.5f, 0}}, {{0.0f, 0.0f, 0}}, {{0.5f, 0.0f, 0}},
-            {{-0.5f, 0.5f, 0}}, {{0.5f, 0.5f, 0}}
-        };
-        const std::vector<uint32_t> indices_3 = {
-            0, 1, 1, 2, 2, 3, 3, 5, 5, 4
-        };
+    HudRenderSystem::HudRenderSystem(VulkrDevice &device, VkRenderPass renderPass)
+        : vulkrDevice{device} {
+        createFontAtlas();
+        createBuffers();
+        createDescriptors();
+        createPipelineLayout();
+        createPipeline(renderPass);
+    }
 
-        // --- 4 ---
-        // Corrected --- 4 ---
-        const std::vector<VulkrModel::Vertex> vertices_4 = {
-            {{-0.5f, -0.5f, 0}}, // top-left
-            {{-0.5f, 0.0f, 0}}, // mid-left
-            {{0.5f, -0.5f, 0}}, // top-right
-            {{0.5f, 0.0f, 0}}, // mid-right
-            {{0.5f, 0.5f, 0}} // bottom-right
-        };
-        const std::vector<uint32_t> indices_4 = {
-            0, 1, // Top-left vertical line
-            1, 3, // Middle horizontal line
-            2, 3, // Top-right vertical line
-            3, 4 // Bottom-right vertical line
-        };
+    HudRenderSystem::~HudRenderSystem() {
+        vkDestroyPipelineLayout(vulkrDevice.device(), pipelineLayout, nullptr);
 
-        // --- 5 ---
-        const std::vector<VulkrModel::Vertex> vertices_5 = {
-            {{0.5f, -0.5f, 0}}, {{-0.5f, -0.5f, 0}}, {{-0.5f, 0.0f, 0}}, {{0.5f, 0.0f, 0}},
-            {{0.5f, 0.5f, 0}}, {{-0.5f, 0.5f, 0}}
-        };
-        const std::vector<uint32_t> indices_5 = {
-            0, 1, 1, 2, 2, 3, 3, 4, 4, 5
-        };
+        VkDevice vkDevice = vulkrDevice.device();
+        VkSampler sampler = atlasSampler;
+        vulkrDevice.deletionQueue().retireImage(atlasImage, atlasImageView, atlasImageMemory, lastUsedFrameValue);
+        vulkrDevice.deletionQueue().retire(lastUsedFrameValue, [vkDevice, sampler]() {
+            vkDestroySampler(vkDevice, sampler, nullptr);
+        });
+    }
 
-        // --- 6 ---
-        const std::vector<VulkrModel::Vertex> vertices_6 = {
-            {{0.5f, -0.5f, 0}}, {{-0.5f, -0.5f, 0}}, {{-0.5f, 0.5f, 0}}, {{0.5f, 0.5f, 0}},
-            {{0.5f, 0.0f, 0}}, {{-0.5f, 0.0f, 0}}
-        };
-        const std::vector<uint32_t> indices_6 = {
-            0, 1, 1, 2, 2, 3, 3, 4, 4, 5
-        };
+    void HudRenderSystem::createFontAtlas() {
+        const uint32_t rows = (GLYPH_COUNT + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS;
+        atlasWidth = ATLAS_COLUMNS * GLYPH_WIDTH;
+        atlasHeight = rows * GLYPH_HEIGHT;
 
-        // --- 7 ---
-        const std::vector<VulkrModel::Vertex> vertices_7 = {
-            {{-0.5f, -0.5f, 0}}, {{0.5f, -0.5f, 0}}, {{0.0f, 0.5f, 0}}
-        };
-        const std::vector<uint32_t> indices_7 = {
-            0, 1, 1, 2
+        std::vector<uint8_t> pixels(static_cast<size_t>(atlasWidth) * atlasHeight, 0);
+        auto cellOrigin = [](char c) {
+            const uint32_t index = static_cast<uint32_t>(c - FIRST_GLYPH);
+            return glm::uvec2{(index % ATLAS_COLUMNS) * GLYPH_WIDTH, (index / ATLAS_COLUMNS) * GLYPH_HEIGHT};
         };
 
-        // --- 8 ---
-        const std::vector<VulkrModel::Vertex> vertices_8 = {
-            {{-0.5f, -0.5f, 0}}, {{0.5f, -0.5f, 0}}, {{0.5f, 0.5f, 0}}, {{-0.5f, 0.5f, 0}},
-            {{-0.5f, 0.0f, 0}}, {{0.5f, 0.0f, 0}}
-        };
-        const std::vector<uint32_t> indices_8 = {
-            0, 1, 1, 2, 2, 3, 3, 0, 4, 5
-        };
+        for (const auto &glyph: fontGlyphs) {
+            const glm::uvec2 origin = cellOrigin(glyph.character);
+            for (uint32_t y = 0; y < glyph.rows.size(); y++) {
+                for (uint32_t x = 0; x < 5; x++) {
+                    if (glyph.rows[y] & (0x10 >> x)) {
+                        pixels[(origin.y + y) * atlasWidth + origin.x + x] = 255;
+                    }
+                }
+            }
+        }
 
-        // --- 9 ---
-        const std::vector<VulkrModel::Vertex> vertices_9 = {
-            {{-0.5f, 0.5f, 0}}, {{0.5f, 0.5f, 0}}, {{0.5f, -0.5f, 0}}, {{-0.5f, -0.5f, 0}},
-            {{-0.5f, 0.0f, 0}}, {{0.5f, 0.0f, 0}}
-        };
-        const std::vector<uint32_t> indices_9 = {
-            0, 1, 1, 2, 2, 3, 3, 4, 4, 5
+        const glm::uvec2 solid = cellOrigin(LAST_GLYPH);
+        for (uint32_t y = 0; y < GLYPH_HEIGHT; y++) {
+            for (uint32_t x = 0; x < GLYPH_WIDTH; x++) {
+                pixels[(solid.y + y) * atlasWidth + solid.x + x] = 255;
+            }
+        }
+
+        VulkrBuffer stagingBuffer{
+            vulkrDevice, 1, static_cast<uint32_t>(pixels.size()), VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
         };
-    } // anonymous namespace
+        stagingBuffer.map();
+        stagingBuffer.writeToBuffer(pixels.data());
+        stagingBuffer.unmap();
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = atlasWidth;
+        imageInfo.extent.height = atlasHeight;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = VK_FORMAT_R8_UNORM;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        vulkrDevice.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, atlasImage, atlasImageMemory);
+
+        VkCommandBuffer commandBuffer = vulkrDevice.beginSingleTimeCommands();
+
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = atlasImage;
+        barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        VkBufferImageCopy region{};
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.imageExtent = {atlasWidth, atlasHeight, 1};
+        vkCmdCopyBufferToImage(commandBuffer, stagingBuffer.getBuffer(), atlasImage,
+                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        vulkrDevice.endSingleTimeCommands(commandBuffer);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = atlasImage;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = VK_FORMAT_R8_UNORM;
+        viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+
+        if (vkCreateImageView(vulkrDevice.device(), &viewInfo, nullptr, &atlasImageView) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create glyph atlas view!");
+        }
 
-    HudRenderSystem::HudRenderSystem(VulkrDevice &device, VkRenderPass renderPass)
-        : vulkrDevice{device} {
-        createPipelineLayout();
-        createPipeline(renderPass);
+        // texel exact glyphs, no filtering across cells
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_NEAREST;
+        samplerInfo.minFilter = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod = 0.0f;
+
+        if (vkCreateSampler(vulkrDevice.device(), &samplerInfo, nullptr, &atlasSampler) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create glyph atlas sampler!");
+        }
+    }
 
-        // Create crosshair model
-        // Create crosshair model as a cross
-        std::vector<VulkrModel::Vertex> crosshairVertices = {
-            {{-0.02f, 0.0f, 0.0f}}, {{0.02f, 0.0f, 0.0f}}, // horizontal line
-            {{0.0f, -0.02f, 0.0f}}, {{0.0f, 0.02f, 0.0f}} // vertical line
-        };
-        std::vector<uint32_t> crosshairIndices = {0, 1, 2, 3};
-        VulkrModel::Builder crosshairBuilder{};
-        crosshairBuilder.vertices = std::move(crosshairVertices);
-        crosshairBuilder.indices = std::move(crosshairIndices);
-        crosshairModel = std::make_unique<VulkrModel>(vulkrDevice, crosshairBuilder);
-
-        // Create digit models
-        auto create_digit_model = [&](const auto &vertices, const auto &indices) {
-            VulkrModel::Builder builder{};
-            builder.vertices = vertices;
-            builder.indices = indices;
-            return std::make_unique<VulkrModel>(vulkrDevice, builder);
-        };
+    void HudRenderSystem::createBuffers() {
+        for (int i = 0; i < VulkrSwapChain::MAX_FRAMES_IN_FLIGHT; i++) {
+            auto &buffer = vertexBuffers.emplace_back(std::make_unique<VulkrBuffer>(
+                vulkrDevice, sizeof(HudVertex), MAX_QUADS * 4, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+            buffer->map();
+        }
 
-        // 0 1 2 3 4 5 6 7 8 9
-        // 0 1 2 3 4 5 8 7 6 9
+        // every quad uses the same two triangles, so the index buffer never changes
+        std::vector<uint16_t> indices(MAX_QUADS * 6);
+        for (uint32_t quad = 0; quad < MAX_QUADS; quad++) {
+            const auto base = static_cast<uint16_t>(quad * 4);
+            const std::array<uint16_t, 6> quadIndices = {
+                base, static_cast<uint16_t>(base + 1), static_cast<uint16_t>(base + 2),
+                static_cast<uint16_t>(base + 2), static_cast<uint16_t>(base + 3), base
+            };
+            std::copy(quadIndices.begin(), quadIndices.end(), indices.begin() + quad * 6);
+        }
 
-        digitModels[0] = create_digit_model(vertices_0, indices_0);
-        digitModels[1] = create_digit_model(vertices_1, indices_1);
-        digitModels[2] = create_digit_model(vertices_2, indices_2);
-        digitModels[3] = create_digit_model(vertices_3, indices_3);
-        digitModels[4] = create_digit_model(vertices_4, indices_4);
-        digitModels[5] = create_digit_model(vertices_5, indices_5);
-        digitModels[6] = create_digit_model(vertices_6, indices_6);
-        digitModels[7] = create_digit_model(vertices_7, indices_7);
-        digitModels[8] = create_digit_model(vertices_8, indices_8);
-        digitModels[9] = create_digit_model(vertices_9, indices_9);
+        indexBuffer = std::make_unique<VulkrBuffer>(
+            vulkrDevice, sizeof(uint16_t), static_cast<uint32_t>(indices.size()), VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        indexBuffer->map();
+        indexBuffer->writeToBuffer(indices.data());
+        indexBuffer->unmap();
     }
 
-    HudRenderSystem::~HudRenderSystem() {
-        vkDestroyPipelineLayout(vulkrDevice.device(), pipelineLayout, nullptr);
+    void HudRenderSystem::createDescriptors() {
+        descriptorSetLayout = VulkrDescriptorSetLayout::Builder(vulkrDevice)
+                .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT)
+                .build();
+
+        descriptorPool = VulkrDescriptorPool::Builder(vulkrDevice)
+                .setMaxSets(1)
+                .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1)
+                .build();
+
+        VkDescriptorImageInfo imageInfo{};
+        imageInfo.sampler = atlasSampler;
+        imageInfo.imageView = atlasImageView;
+        imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        if (!VulkrDescriptorWriter(*descriptorSetLayout, *descriptorPool)
+                .writeImage(0, &imageInfo)
+                .build(atlasDescriptorSet)) {
+            throw std::runtime_error("failed to allocate hud descriptor set!");
+        }
     }
 
     void HudRenderSystem::createPipelineLayout() {
@@ -164,10 +298,12 @@ namespace vulkr {
         pushConstantRange.offset = 0;
         pushConstantRange.size = sizeof(HudPushConstantData);
 
+        VkDescriptorSetLayout setLayout = descriptorSetLayout->getDescriptorSetLayout();
+
         VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
         pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        pipelineLayoutInfo.setLayoutCount = 0;
-        pipelineLayoutInfo.pSetLayouts = nullptr;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &setLayout;
         pipelineLayoutInfo.pushConstantRangeCount = 1;
         pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
 
@@ -180,14 +316,22 @@ namespace vulkr {
         PipelineConfigInfo pipelineConfig{};
         VulkrPipeline::defaultPipelineConfigInfo(pipelineConfig);
 
-        // Configure the pipeline for HUD rendering
-        pipelineConfig.inputAssemblyInfo.topology = VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+        pipelineConfig.bindingDescriptions = {{0, sizeof(HudVertex), VK_VERTEX_INPUT_RATE_VERTEX}};
+        pipelineConfig.attributeDescriptions = {
+            {0, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(HudVertex, position)},
+            {1, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(HudVertex, uv)},
+            {2, 0, VK_FORMAT_R8G8B8A8_UNORM, offsetof(HudVertex, color)},
+        };
 
         pipelineConfig.renderPass = renderPass;
         pipelineConfig.pipelineLayout = pipelineLayout;
         pipelineConfig.depthStencilInfo.depthTestEnable = VK_FALSE;
         pipelineConfig.depthStencilInfo.depthWriteEnable = VK_FALSE;
         pipelineConfig.colorBlendAttachment.blendEnable = VK_TRUE;
+        pipelineConfig.colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+        pipelineConfig.colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        pipelineConfig.colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+        pipelineConfig.colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
 
         hudPipeline = std::make_unique<VulkrPipeline>(
             vulkrDevice,
@@ -197,50 +341,129 @@ namespace vulkr {
         );
     }
 
-    void HudRenderSystem::render(VkCommandBuffer commandBuffer, float aspect) {
-        hudPipeline->bind(commandBuffer);
+    void HudRenderSystem::begin(int frameIndex, VkExtent2D screenExtent) {
+        // this slot's previous frame has completed, so its vertices can be overwritten
+        currentFrameIndex = frameIndex;
+        vertices = static_cast<HudVertex *>(vertexBuffers[frameIndex]->getMappedMemory());
+        quadCount = 0;
+        extent = screenExtent;
+    }
 
-        // Render crosshair
-        HudPushConstantData push{};
-        glm::mat4 crosshairMatrix = glm::scale(glm::mat4(1.0f), {1.0f / aspect, 1.0f, 1.0f});
-        push.transform = crosshairMatrix;
-        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(HudPushConstantData),
-                           &push);
-        crosshairModel->bind(commandBuffer);
-        crosshairModel->draw(commandBuffer);
+    uint32_t HudRenderSystem::packColor(const glm::vec4 &color) {
+        const glm::uvec4 c = glm::uvec4(glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f);
+        return c.r | (c.g << 8) | (c.b << 16) | (c.a << 24);
     }
 
-    void HudRenderSystem::renderNumber(VkCommandBuffer commandBuffer, int number, float x, float y, float scale,
-                                       float aspect) {
-        hudPipeline->bind(commandBuffer);
+    void HudRenderSystem::pushQuad(float x0, float y0, float x1, float y1, const glm::vec2 &uv0,
+                                   const glm::vec2 &uv1, uint32_t color) {
+        assert(vertices != nullptr && "Cannot queue HUD quads before begin!");
+        if (quadCount >= MAX_QUADS) return;
+
+        HudVertex *quad = vertices + quadCount * 4;
+        quad[0] = {{x0, y0}, {uv0.x, uv0.y}, color};
+        quad[1] = {{x1, y0}, {uv1.x, uv0.y}, color};
+        quad[2] = {{x1, y1}, {uv1.x, uv1.y}, color};
+        quad[3] = {{x0, y1}, {uv0.x, uv1.y}, color};
+        quadCount++;
+    }
 
-        std::string numStr = std::to_string(number);
-        float currentX = x;
+    float HudRenderSystem::drawText(std::string_view text, float x, float y, float scale, const glm::vec4 &color) {
+        const uint32_t packed = packColor(color);
+        const glm::vec2 cellUv{
+            static_cast<float>(GLYPH_WIDTH) / static_cast<float>(atlasWidth),
+            static_cast<float>(GLYPH_HEIGHT) / static_cast<float>(atlasHeight)
+        };
+        const float advance = static_cast<float>(GLYPH_WIDTH) * scale;
+
+        float cursorX = x;
+        for (char c: text) {
+            if (c == '\n') {
+                cursorX = x;
+                y += static_cast<float>(GLYPH_HEIGHT) * scale;
+                continue;
+            }
+            if (c != ' ') {
+                const uint32_t index = static_cast<uint32_t>(glyphFor(c) - FIRST_GLYPH);
+                const glm::vec2 uv0 = glm::vec2(index % ATLAS_COLUMNS, index / ATLAS_COLUMNS) * cellUv;
+                pushQuad(cursorX, y, cursorX + advance, y + static_cast<float>(GLYPH_HEIGHT) * scale,
+                         uv0, uv0 + cellUv, packed);
+            }
+            cursorX += advance;
+        }
+        return cursorX;
+    }
+
+    float HudRenderSystem::drawNumber(int value, float x, float y, float scale, const glm::vec4 &color) {
+        char buffer[24];
+        return drawText(formatInteger(value, buffer, sizeof(buffer)), x, y, scale, color);
+    }
+
+    float HudRenderSystem::drawNumber(float value, int decimals, float x, float y, float scale,
+                                      const glm::vec4 &color) {
+        if (decimals <= 0) {
+            return drawNumber(static_cast<int>(std::lround(value)), x, y, scale, color);
+        }
 
-        for (char &digitChar: numStr) {
-            int digit = digitChar - '0';
-            if (digit < 0 || digit > 9) continue; // Skip non-digit characters
+        long long factor = 1;
+        for (int i = 0; i < decimals; i++) factor *= 10;
+        const long long fixed = std::llround(static_cast<double>(value) * static_cast<double>(factor));
+        const long long magnitude = fixed < 0 ? -fixed : fixed;
 
-            HudPushConstantData push{};
-            auto modelMatrix = glm::mat4(1.0f);
-            modelMatrix = glm::translate(modelMatrix, {currentX, y, 0.0f});
-            modelMatrix = glm::scale(modelMatrix, {scale / aspect, scale, 1.0f});
+        // "-0.5" has no integer part to carry the sign
+        if (fixed < 0) x = drawText("-", x, y, scale, color);
 
-            push.transform = modelMatrix;
+        char buffer[24];
+        x = drawText(formatInteger(magnitude / factor, buffer, sizeof(buffer)), x, y, scale, color);
+        x = drawText(".", x, y, scale, color);
 
-            vkCmdPushConstants(
-                commandBuffer,
-                pipelineLayout,
-                VK_SHADER_STAGE_VERTEX_BIT,
-                0,
-                sizeof(HudPushConstantData),
-                &push);
+        std::string_view fraction = formatInteger(magnitude % factor + factor, buffer, sizeof(buffer));
+        return drawText(fraction.substr(1), x, y, scale, color);
+    }
 
-            digitModels[digit]->bind(commandBuffer);
-            digitModels[digit]->draw(commandBuffer);
+    void HudRenderSystem::drawRect(float x, float y, float width, float height, const glm::vec4 &color) {
+        // the centre of the solid cell, so every fragment samples full coverage
+        const uint32_t index = static_cast<uint32_t>(LAST_GLYPH - FIRST_GLYPH);
+        const glm::vec2 uv{
+            (static_cast<float>(index % ATLAS_COLUMNS * GLYPH_WIDTH) + GLYPH_WIDTH * 0.5f) / atlasWidth,
+            (static_cast<float>(index / ATLAS_COLUMNS * GLYPH_HEIGHT) + GLYPH_HEIGHT * 0.5f) / atlasHeight
+        };
+        pushQuad(x, y, x + width, y + height, uv, uv, packColor(color));
+    }
+
+    void HudRenderSystem::drawCrosshair(float size, float thickness, const glm::vec4 &color) {
+        const float cx = static_cast<float>(extent.width) * 0.5f;
+        const float cy = static_cast<float>(extent.height) * 0.5f;
+        drawRect(cx - size * 0.5f, cy - thickness * 0.5f, size, thickness, color);
+        drawRect(cx - thickness * 0.5f, cy - size * 0.5f, thickness, size, color);
+    }
 
-            // Advance cursor position for the next digit
-            currentX += (scale + (scale * 0.3f));
+    float HudRenderSystem::textWidth(std::string_view text, float scale) {
+        size_t longestLine = 0;
+        size_t line = 0;
+        for (char c: text) {
+            line = c == '\n' ? 0 : line + 1;
+            longestLine = std::max(longestLine, line);
         }
+        return static_cast<float>(longestLine * GLYPH_WIDTH) * scale;
+    }
+
+    void HudRenderSystem::render(VkCommandBuffer commandBuffer) {
+        if (quadCount == 0) return;
+        lastUsedFrameValue = vulkrDevice.frameTimeline().getCurrentValue();
+
+        HudPushConstantData push{};
+        push.pixelToNdc = glm::vec2(2.0f / static_cast<float>(extent.width), 2.0f / static_cast<float>(extent.height));
+
+        hudPipeline->bind(commandBuffer);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1,
+                                &atlasDescriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(HudPushConstantData),
+                           &push);
+
+        VkBuffer vertexBuffer = vertexBuffers[currentFrameIndex]->getBuffer();
+        VkDeviceSize offset = 0;
+        vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer, &offset);
+        vkCmdBindIndexBuffer(commandBuffer, indexBuffer->getBuffer(), 0, VK_INDEX_TYPE_UINT16);
+        vkCmdDrawIndexed(commandBuffer, quadCount * 6, 1, 0, 0, 0);
     }
 }
@@ -4,36 +4,115 @@
 
 #ifndef HUD_RENDER_SYSTEM_H
 #define HUD_RENDER_SYSTEM_H
-#include <array>
 #include <memory>
+#include <string_view>
+#include <vector>
 
+#include <glm/glm.hpp>
+
+#include "../../pipeline/vulkr_buffer.h"
+#include "../../pipeline/vulkr_descriptors.h"
 #include "../../pipeline/vulkr_device.hpp"
 #include "../../pipeline/vulkr_pipeline.h"
-#include "../../model/vulkr_model.h"
 
 namespace vulkr {
+    /**
+     * Batched overlay renderer. Text, rectangles and the crosshair are queued as quads in pixel coordinates
+     * (origin top left) between begin() and render(), written into a persistently mapped per-frame vertex
+     * buffer and drawn with a single indexed draw that samples a glyph atlas.
+     */
     class HudRenderSystem {
     public:
+        static constexpr uint32_t MAX_QUADS = 4096;
+        // glyph cell size in atlas texels, every glyph is 5x7 with one texel of spacing
+        static constexpr uint32_t GLYPH_WIDTH = 6;
+        static constexpr uint32_t GLYPH_HEIGHT = 8;
+
         HudRenderSystem(VulkrDevice &device, VkRenderPass renderPass);
 
         ~HudRenderSystem();
 
-        void render(VkCommandBuffer commandBuffer, float aspect);
+        HudRenderSystem(const HudRenderSystem &) = delete;
+
+        HudRenderSystem &operator=(const HudRenderSystem &) = delete;
+
+        /**
+         * Starts a new batch for the frame slot, screenExtent is the extent of the pass the batch is drawn in.
+         */
+        void begin(int frameIndex, VkExtent2D screenExtent);
+
+        /**
+         * Queues a string, scale is the size of one atlas texel in pixels. Returns the x after the last glyph.
+         * Lower case letters are drawn as upper case, unknown characters as '?'.
+         */
+        float drawText(std::string_view text, float x, float y, float scale,
+                       const glm::vec4 &color = glm::vec4{1.0f});
+
+        float drawNumber(int value, float x, float y, float scale, const glm::vec4 &color = glm::vec4{1.0f});
+
+        float drawNumber(float value, int decimals, float x, float y, float scale,
+                         const glm::vec4 &color = glm::vec4{1.0f});
+
+        void drawRect(float x, float y, float width, float height, const glm::vec4 &color);
+
+        void drawCrosshair(float size = 16.0f, float thickness = 2.0f, const glm::vec4 &color = glm::vec4{1.0f});
+
+        static float textWidth(std::string_view text, float scale);
 
-        void renderNumber(VkCommandBuffer commandBuffer, int number, float x, float y, float scale, float aspect);
+        /**
+         * Draws the whole batch, must be recorded in the pass given to begin().
+         */
+        void render(VkCommandBuffer commandBuffer);
+
+        uint32_t getQuadCount() const { return quadCount; }
 
     private:
+        struct HudVertex {
+            glm::vec2 position;
+            glm::vec2 uv;
+            uint32_t color;
+        };
+
+        void createFontAtlas();
+
+        void createBuffers();
+
+        void createDescriptors();
+
         void createPipelineLayout();
 
         void createPipeline(VkRenderPass renderPass);
 
+        void pushQuad(float x0, float y0, float x1, float y1, const glm::vec2 &uv0, const glm::vec2 &uv1,
+                      uint32_t color);
+
+        static uint32_t packColor(const glm::vec4 &color);
+
         VulkrDevice &vulkrDevice;
         std::unique_ptr<VulkrPipeline> hudPipeline;
 
         VkPipelineLayout pipelineLayout;
 
-        std::array<std::unique_ptr<VulkrModel>, 10> digitModels;
-        std::unique_ptr<VulkrModel> crosshairModel;
+        VkImage atlasImage = VK_NULL_HANDLE;
+        VkDeviceMemory atlasImageMemory = VK_NULL_HANDLE;
+        VkImageView atlasImageView = VK_NULL_HANDLE;
+        VkSampler atlasSampler = VK_NULL_HANDLE;
+        uint32_t atlasWidth{0};
+        uint32_t atlasHeight{0};
+
+        std::unique_ptr<VulkrDescriptorSetLayout> descriptorSetLayout;
+        std::unique_ptr<VulkrDescriptorPool> descriptorPool;
+        VkDescriptorSet atlasDescriptorSet = VK_NULL_HANDLE;
+
+        // one persistently mapped vertex buffer per frame slot, the index buffer is shared
+        std::vector<std::unique_ptr<VulkrBuffer>> vertexBuffers;
+        std::unique_ptr<VulkrBuffer> indexBuffer;
+
+        HudVertex *vertices = nullptr;
+        uint32_t quadCount{0};
+        int currentFrameIndex{0};
+        VkExtent2D extent{1, 1};
+        uint64_t lastUsedFrameValue{0};
     };
 }
 
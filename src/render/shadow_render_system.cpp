@@ -0,0 +1,470 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "shadow_render_system.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "../pipeline/vulkr_swap_chain.hpp"
+
+namespace vulkr {
+    struct ShadowPushConstantData {
+        glm::mat4 transform{1.0f};
+    };
+
+    struct CascadeUbo {
+        glm::mat4 viewProjection[ShadowRenderSystem::CASCADE_COUNT];
+        glm::vec4 splits{0.0f}; // far view depth of each cascade
+        glm::vec4 texelWorldSize{0.0f}; // size of one shadow map texel in world units, per cascade
+        glm::vec4 params{0.0f}; // x is one texel in uv space
+    };
+
+    ShadowRenderSystem::ShadowRenderSystem(VulkrDevice &device) : vulkrDevice(device) {
+        depthFormat = vulkrDevice.findSupportedFormat(
+            {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D16_UNORM},
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT);
+
+        createShadowMap();
+        createRenderPass();
+        createFramebuffers();
+        createDescriptors();
+        createPipelineLayout();
+        createPipeline();
+    }
+
+    ShadowRenderSystem::~ShadowRenderSystem() {
+        VkDevice vkDevice = vulkrDevice.device();
+        VkRenderPass pass = renderPass;
+        VkSampler sampler = shadowSampler;
+        auto views = cascadeViews;
+        auto fbs = framebuffers;
+
+        auto &deletionQueue = vulkrDevice.deletionQueue();
+        deletionQueue.retireImage(shadowImage, shadowArrayView, shadowImageMemory, lastUsedFrameValue);
+        deletionQueue.retire(lastUsedFrameValue, [vkDevice, pass, sampler, views, fbs]() {
+            for (size_t i = 0; i < views.size(); i++) {
+                vkDestroyFramebuffer(vkDevice, fbs[i], nullptr);
+                vkDestroyImageView(vkDevice, views[i], nullptr);
+            }
+            vkDestroySampler(vkDevice, sampler, nullptr);
+            vkDestroyRenderPass(vkDevice, pass, nullptr);
+        });
+
+        vkDestroyPipelineLayout(vulkrDevice.device(), pipelineLayout, nullptr);
+    }
+
+    void ShadowRenderSystem::createShadowMap() {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = SHADOW_MAP_SIZE;
+        imageInfo.extent.height = SHADOW_MAP_SIZE;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = CASCADE_COUNT;
+        imageInfo.format = depthFormat;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        vulkrDevice.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, shadowImage, shadowImageMemory);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = shadowImage;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        viewInfo.format = depthFormat;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+        viewInfo.subresourceRange.baseMipLevel = 0;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = CASCADE_COUNT;
+
+        if (vkCreateImageView(vulkrDevice.device(), &viewInfo, nullptr, &shadowArrayView) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create shadow map view!");
+        }
+
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.subresourceRange.layerCount = 1;
+        for (uint32_t i = 0; i < CASCADE_COUNT; i++) {
+            viewInfo.subresourceRange.baseArrayLayer = i;
+            if (vkCreateImageView(vulkrDevice.device(), &viewInfo, nullptr, &cascadeViews[i]) != VK_SUCCESS) {
+                throw std::runtime_error("failed to create shadow cascade view!");
+            }
+        }
+
+        // cached cascades are sampled without being rendered that frame, so every layer has to start out
+        // in the layout the render pass leaves it in
+        VkCommandBuffer commandBuffer = vulkrDevice.beginSingleTimeCommands();
+
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = shadowImage;
+        barrier.subresourceRange = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, CASCADE_COUNT};
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        vulkrDevice.endSingleTimeCommands(commandBuffer);
+
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_LINEAR;
+        samplerInfo.minFilter = VK_FILTER_LINEAR;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+        samplerInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+        samplerInfo.compareEnable = VK_TRUE;
+        samplerInfo.compareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+        samplerInfo.maxLod = 0.0f;
+
+        if (vkCreateSampler(vulkrDevice.device(), &samplerInfo, nullptr, &shadowSampler) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create shadow sampler!");
+        }
+    }
+
+    void ShadowRenderSystem::createRenderPass() {
+        VkAttachmentDescription depthAttachment{};
+        depthAttachment.format = depthFormat;
+        depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+        depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+
+        VkAttachmentReference depthAttachmentRef{};
+        depthAttachmentRef.attachment = 0;
+        depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        VkSubpassDescription subpass{};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount = 0;
+        subpass.pDepthStencilAttachment = &depthAttachmentRef;
+
+        // earlier frames may still be sampling the cascade
+        std::array<VkSubpassDependency, 2> dependencies{};
+        dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+        dependencies[0].dstSubpass = 0;
+        dependencies[0].srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        dependencies[0].srcAccessMask = 0;
+        dependencies[0].dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                       VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        dependencies[0].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                                        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+        dependencies[1].srcSubpass = 0;
+        dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+        dependencies[1].srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        dependencies[1].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        VkRenderPassCreateInfo renderPassInfo{};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        renderPassInfo.attachmentCount = 1;
+        renderPassInfo.pAttachments = &depthAttachment;
+        renderPassInfo.subpassCount = 1;
+        renderPassInfo.pSubpasses = &subpass;
+        renderPassInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
+        renderPassInfo.pDependencies = dependencies.data();
+
+        if (vkCreateRenderPass(vulkrDevice.device(), &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create shadow render pass!");
+        }
+    }
+
+    void ShadowRenderSystem::createFramebuffers() {
+        for (uint32_t i = 0; i < CASCADE_COUNT; i++) {
+            VkFramebufferCreateInfo framebufferInfo{};
+            framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+            framebufferInfo.renderPass = renderPass;
+            framebufferInfo.attachmentCount = 1;
+            framebufferInfo.pAttachments = &cascadeViews[i];
+            framebufferInfo.width = SHADOW_MAP_SIZE;
+            framebufferInfo.height = SHADOW_MAP_SIZE;
+            framebufferInfo.layers = 1;
+
+            if (vkCreateFramebuffer(vulkrDevice.device(), &framebufferInfo, nullptr, &framebuffers[i]) != VK_SUCCESS) {
+                throw std::runtime_error("failed to create shadow framebuffer!");
+            }
+        }
+    }
+
+    void ShadowRenderSystem::createDescriptors() {
+        shadowSetLayout = VulkrDescriptorSetLayout::Builder(vulkrDevice)
+                .addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT)
+                .addBinding(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT)
+                .build();
+
+        shadowPool = VulkrDescriptorPool::Builder(vulkrDevice)
+                .setMaxSets(VulkrSwapChain::MAX_FRAMES_IN_FLIGHT)
+                .addPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VulkrSwapChain::MAX_FRAMES_IN_FLIGHT)
+                .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VulkrSwapChain::MAX_FRAMES_IN_FLIGHT)
+                .build();
+
+        VkDescriptorImageInfo imageInfo{};
+        imageInfo.sampler = shadowSampler;
+        imageInfo.imageView = shadowArrayView;
+        imageInfo.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+
+        shadowDescriptorSets.resize(VulkrSwapChain::MAX_FRAMES_IN_FLIGHT);
+        for (int i = 0; i < VulkrSwapChain::MAX_FRAMES_IN_FLIGHT; i++) {
+            auto &buffer = cascadeBuffers.emplace_back(std::make_unique<VulkrBuffer>(
+                vulkrDevice, sizeof(CascadeUbo), 1, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+            buffer->map();
+
+            auto bufferInfo = buffer->descriptorInfo();
+            if (!VulkrDescriptorWriter(*shadowSetLayout, *shadowPool)
+                    .writeBuffer(0, &bufferInfo)
+                    .writeImage(1, &imageInfo)
+                    .build(shadowDescriptorSets[i])) {
+                throw std::runtime_error("failed to allocate shadow descriptor set!");
+            }
+        }
+    }
+
+    void ShadowRenderSystem::createPipelineLayout() {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(ShadowPushConstantData);
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 0;
+        pipelineLayoutInfo.pSetLayouts = nullptr;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(vulkrDevice.device(), &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create shadow pipeline layout!");
+        }
+    }
+
+    void ShadowRenderSystem::createPipeline() {
+        PipelineConfigInfo pipelineConfig{};
+        VulkrPipeline::defaultPipelineConfigInfo(pipelineConfig);
+        pipelineConfig.bindingDescriptions = VulkrModel::Vertex::getPositionBindingDescriptions();
+        pipelineConfig.attributeDescriptions = VulkrModel::Vertex::getPositionAttributeDescriptions();
+        pipelineConfig.colorBlendInfo.attachmentCount = 0;
+        pipelineConfig.rasterizationInfo.depthBiasEnable = VK_TRUE;
+        pipelineConfig.rasterizationInfo.depthBiasConstantFactor = 1.25f;
+        pipelineConfig.rasterizationInfo.depthBiasSlopeFactor = 1.75f;
+        pipelineConfig.renderPass = renderPass;
+        pipelineConfig.pipelineLayout = pipelineLayout;
+
+        shadowPipeline = std::make_unique<VulkrPipeline>(
+            vulkrDevice,
+            "shaders/shadow.vert.spv",
+            "",
+            pipelineConfig
+        );
+    }
+
+    void ShadowRenderSystem::invalidateCache() {
+        for (auto &cascade: cascades) {
+            cascade.valid = false;
+        }
+    }
+
+    bool ShadowRenderSystem::updateCascadeBounds(Cascade &cascade, const Camera &camera, float splitNear,
+                                                 float splitFar, const glm::vec3 &lightDirection) {
+        // bounding sphere of the camera frustum slice, its size does not change with camera rotation
+        std::array<glm::vec3, 8> corners{};
+        size_t cornerIndex = 0;
+        for (float x: {-1.0f, 1.0f}) {
+            for (float y: {-1.0f, 1.0f}) {
+                glm::vec4 nearPoint = camera.getInverseProjection() * glm::vec4(x, y, 0.0f, 1.0f);
+                glm::vec3 ray = glm::vec3(nearPoint) / nearPoint.w;
+                for (float depth: {splitNear, splitFar}) {
+                    corners[cornerIndex++] = glm::vec3(camera.getInverseView() * glm::vec4(ray * (depth / ray.z), 1.0f));
+                }
+            }
+        }
+
+        glm::vec3 center{0.0f};
+        for (const auto &corner: corners) {
+            center += corner;
+        }
+        center /= static_cast<float>(corners.size());
+
+        float radius = 0.0f;
+        for (const auto &corner: corners) {
+            radius = std::max(radius, glm::length(corner - center));
+        }
+
+        const bool lightMoved = glm::dot(cascade.lightDirection, lightDirection) < 0.99999f;
+        const bool escaped = glm::length(center - cascade.center) + radius > cascade.radius;
+        const bool oversized = radius < cascade.radius * 0.5f;
+        cascade.splitFar = splitFar;
+
+        if (cascade.valid && !lightMoved && !escaped && !oversized) {
+            return false;
+        }
+
+        const float paddedRadius = std::ceil(radius * (1.0f + cascadePadding) * 16.0f) / 16.0f;
+        cascade.center = center;
+        cascade.radius = paddedRadius;
+        cascade.lightDirection = lightDirection;
+        cascade.valid = true;
+
+        // the light rotation only depends on the direction, so snapping in light space keeps texels fixed
+        const glm::vec3 up = std::abs(lightDirection.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, -1.0f, 0.0f);
+        cascade.lightCamera.setViewDirection(glm::vec3(0.0f), -lightDirection, up);
+
+        glm::vec3 lightCenter = glm::vec3(cascade.lightCamera.getView() * glm::vec4(center, 1.0f));
+        const float texelSize = 2.0f * paddedRadius / static_cast<float>(SHADOW_MAP_SIZE);
+        lightCenter.x = std::floor(lightCenter.x / texelSize) * texelSize;
+        lightCenter.y = std::floor(lightCenter.y / texelSize) * texelSize;
+
+        cascade.lightCamera.setOrthographicProjection(
+            lightCenter.x - paddedRadius, lightCenter.x + paddedRadius,
+            lightCenter.y - paddedRadius, lightCenter.y + paddedRadius,
+            lightCenter.z - paddedRadius - casterDistance, lightCenter.z + paddedRadius);
+
+        cascade.lightMin = lightCenter - glm::vec3(paddedRadius, paddedRadius, paddedRadius + casterDistance);
+        cascade.lightMax = lightCenter + glm::vec3(paddedRadius);
+        cascade.viewProjection = cascade.lightCamera.getProjectionMatrix() * cascade.lightCamera.getView();
+        return true;
+    }
+
+    void ShadowRenderSystem::render(FrameInfo &frameInfo, std::vector<GameObject> &gameObjects,
+                                    const glm::vec3 &lightDirection, const SkinningSystem &skinningSystem) {
+        lastUsedFrameValue = vulkrDevice.frameTimeline().getCurrentValue();
+
+        const glm::vec3 direction = glm::normalize(lightDirection);
+        const Camera &camera = frameInfo.camera;
+        const float nearPlane = camera.getNear();
+        const float farPlane = camera.getFar() * shadowDistance;
+
+        // world space bounding spheres, shared by the culling of every cascade
+        struct Caster {
+            GameObject *object;
+            glm::vec3 center;
+            float radius;
+        };
+        std::vector<Caster> casters;
+        size_t staticCount = 0;
+        for (auto &obj: gameObjects) {
+            if (obj.model == nullptr) continue;
+
+            const glm::vec3 localCenter = (obj.model->getBoundsMin() + obj.model->getBoundsMax()) * 0.5f;
+            const float localRadius = glm::length(obj.model->getBoundsMax() - obj.model->getBoundsMin()) * 0.5f;
+            const glm::vec3 scale = glm::abs(obj.transform.scale);
+
+            casters.push_back({
+                &obj,
+                glm::vec3(obj.transform.mat4() * glm::vec4(localCenter, 1.0f)),
+                localRadius * std::max({scale.x, scale.y, scale.z})
+            });
+            staticCount += obj.isStatic ? 1 : 0;
+        }
+
+        if (staticCount != lastStaticCount) {
+            invalidateCache();
+            lastStaticCount = staticCount;
+        }
+
+        CascadeUbo ubo{};
+        ubo.params = glm::vec4(1.0f / static_cast<float>(SHADOW_MAP_SIZE), 0.0f, 0.0f, 0.0f);
+
+        cascadesRendered = 0;
+        std::vector<GameObject *> cascadeCasters;
+        float splitNear = nearPlane;
+        for (uint32_t i = 0; i < CASCADE_COUNT; i++) {
+            // blend of logarithmic and uniform splits
+            const float p = static_cast<float>(i + 1) / static_cast<float>(CASCADE_COUNT);
+            const float logSplit = nearPlane * std::pow(farPlane / nearPlane, p);
+            const float uniformSplit = nearPlane + (farPlane - nearPlane) * p;
+            const float splitFar = splitLambda * logSplit + (1.0f - splitLambda) * uniformSplit;
+
+            Cascade &cascade = cascades[i];
+            bool dirty = updateCascadeBounds(cascade, camera, splitNear, splitFar, direction);
+            splitNear = splitFar;
+
+            cascadeCasters.clear();
+            bool hasDynamicCasters = false;
+            for (const auto &caster: casters) {
+                const glm::vec3 lightCenter = glm::vec3(cascade.lightCamera.getView() * glm::vec4(caster.center, 1.0f));
+                const glm::vec3 closest = glm::clamp(lightCenter, cascade.lightMin, cascade.lightMax);
+                const glm::vec3 offset = closest - lightCenter;
+                if (glm::dot(offset, offset) > caster.radius * caster.radius) continue;
+
+                cascadeCasters.push_back(caster.object);
+                // an animated object deforms even while its transform stays put
+                hasDynamicCasters |= !caster.object->isStatic || caster.object->animation != nullptr;
+            }
+
+            // a dynamic object that just left still has to be erased from the cached map
+            dirty |= hasDynamicCasters || cascade.hadDynamicCasters;
+            cascade.hadDynamicCasters = hasDynamicCasters;
+
+            if (dirty) {
+                renderCascade(frameInfo.commandBuffer, i, cascadeCasters, skinningSystem);
+                cascadesRendered++;
+            }
+
+            ubo.viewProjection[i] = cascade.viewProjection;
+            ubo.splits[i] = cascade.splitFar;
+            ubo.texelWorldSize[i] = 2.0f * cascade.radius / static_cast<float>(SHADOW_MAP_SIZE);
+        }
+
+        cascadeBuffers[frameInfo.frameIndex]->writeToBuffer(&ubo);
+    }
+
+    void ShadowRenderSystem::renderCascade(VkCommandBuffer commandBuffer, uint32_t cascadeIndex,
+                                           const std::vector<GameObject *> &casters,
+                                           const SkinningSystem &skinningSystem) {
+        VkRenderPassBeginInfo renderPassInfo{};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassInfo.renderPass = renderPass;
+        renderPassInfo.framebuffer = framebuffers[cascadeIndex];
+        renderPassInfo.renderArea.offset = {0, 0};
+        renderPassInfo.renderArea.extent = {SHADOW_MAP_SIZE, SHADOW_MAP_SIZE};
+
+        VkClearValue clearValue{};
+        clearValue.depthStencil = {1.0f, 0};
+        renderPassInfo.clearValueCount = 1;
+        renderPassInfo.pClearValues = &clearValue;
+
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+        VkViewport viewport{0.0f, 0.0f, static_cast<float>(SHADOW_MAP_SIZE), static_cast<float>(SHADOW_MAP_SIZE), 0.0f, 1.0f};
+        VkRect2D scissor{{0, 0}, {SHADOW_MAP_SIZE, SHADOW_MAP_SIZE}};
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+        shadowPipeline->bind(commandBuffer);
+
+        const glm::mat4 &viewProjection = cascades[cascadeIndex].viewProjection;
+        for (GameObject *obj: casters) {
+            ShadowPushConstantData push{};
+            push.transform = viewProjection * obj->transform.mat4();
+
+            vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0,
+                               sizeof(ShadowPushConstantData), &push);
+
+            skinningSystem.bindVertices(commandBuffer, *obj, true);
+            obj->model->draw(commandBuffer);
+        }
+
+        vkCmdEndRenderPass(commandBuffer);
+    }
+}
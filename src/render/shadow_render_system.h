@@ -0,0 +1,139 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef SHADOW_RENDER_SYSTEM_H
+#define SHADOW_RENDER_SYSTEM_H
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "frame_info.h"
+#include "skinning_system.h"
+#include "../game/camera.h"
+#include "../game/game_object.h"
+#include "../pipeline/vulkr_buffer.h"
+#include "../pipeline/vulkr_descriptors.h"
+#include "../pipeline/vulkr_device.hpp"
+#include "../pipeline/vulkr_pipeline.h"
+
+namespace vulkr {
+    /**
+     * Cascaded shadow maps for the directional light, fit to the camera frustum.
+     * Each cascade is culled against its own light space box. A cascade is only re-rendered when its bounds
+     * or the light move, or when a dynamic object is (or was) inside it, so cascades over static geometry
+     * stay cached across frames. Cascade bounds are padded and snapped to texels so small camera moves
+     * neither invalidate the cache nor make the shadow edges shimmer.
+     */
+    class ShadowRenderSystem {
+    public:
+        static constexpr uint32_t CASCADE_COUNT = 4; // must match simple_shader.frag
+        static constexpr uint32_t SHADOW_MAP_SIZE = 2048;
+
+        explicit ShadowRenderSystem(VulkrDevice &device);
+
+        ~ShadowRenderSystem();
+
+        ShadowRenderSystem(const ShadowRenderSystem &) = delete;
+
+        ShadowRenderSystem &operator=(const ShadowRenderSystem &) = delete;
+
+        VkDescriptorSetLayout getShadowSetLayout() const { return shadowSetLayout->getDescriptorSetLayout(); }
+        VkDescriptorSet getShadowDescriptorSet(int frameIndex) const { return shadowDescriptorSets[frameIndex]; }
+        VkImage getShadowImage() const { return shadowImage; }
+        VkImageView getShadowImageView() const { return shadowArrayView; }
+        VkFormat getShadowFormat() const { return depthFormat; }
+
+        /**
+         * Updates the cascades and re-renders the stale ones. Must be recorded outside of a render pass,
+         * before anything samples the shadow map and after skinningSystem skinned this frame's caches.
+         * lightDirection points towards the light.
+         */
+        void render(FrameInfo &frameInfo, std::vector<GameObject> &gameObjects, const glm::vec3 &lightDirection,
+                    const SkinningSystem &skinningSystem);
+
+        /**
+         * Forces every cascade to re-render, call after static objects were added, removed or moved.
+         */
+        void invalidateCache();
+
+        uint32_t getCascadesRenderedLastFrame() const { return cascadesRendered; }
+
+        /**
+         * Fraction of the camera far plane covered by shadows.
+         */
+        float shadowDistance{1.0f};
+        /**
+         * Blend between uniform (0) and logarithmic (1) cascade splits.
+         */
+        float splitLambda{0.75f};
+        /**
+         * Extra radius each cascade is fit with, the cascade is kept until the camera leaves that margin.
+         */
+        float cascadePadding{0.15f};
+        /**
+         * Distance behind each cascade, towards the light, that still casts into it.
+         */
+        float casterDistance{20.0f};
+
+    private:
+        struct Cascade {
+            Camera lightCamera{};
+            glm::mat4 viewProjection{1.0f};
+            // light space box the cascade covers, extended towards the light by casterDistance
+            glm::vec3 lightMin{0.0f};
+            glm::vec3 lightMax{0.0f};
+            glm::vec3 center{0.0f};
+            float radius{0.0f};
+            float splitFar{0.0f};
+            glm::vec3 lightDirection{0.0f};
+            bool valid{false};
+            bool hadDynamicCasters{false};
+        };
+
+        void createShadowMap();
+
+        void createRenderPass();
+
+        void createFramebuffers();
+
+        void createDescriptors();
+
+        void createPipelineLayout();
+
+        void createPipeline();
+
+        bool updateCascadeBounds(Cascade &cascade, const Camera &camera, float splitNear, float splitFar,
+                                 const glm::vec3 &lightDirection);
+
+        void renderCascade(VkCommandBuffer commandBuffer, uint32_t cascadeIndex,
+                           const std::vector<GameObject *> &casters, const SkinningSystem &skinningSystem);
+
+        VulkrDevice &vulkrDevice;
+
+        VkFormat depthFormat;
+        VkImage shadowImage = VK_NULL_HANDLE;
+        VkDeviceMemory shadowImageMemory = VK_NULL_HANDLE;
+        VkImageView shadowArrayView = VK_NULL_HANDLE;
+        std::array<VkImageView, CASCADE_COUNT> cascadeViews{};
+        std::array<VkFramebuffer, CASCADE_COUNT> framebuffers{};
+        VkSampler shadowSampler = VK_NULL_HANDLE;
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+
+        std::unique_ptr<VulkrDescriptorSetLayout> shadowSetLayout;
+        std::unique_ptr<VulkrDescriptorPool> shadowPool;
+        std::vector<VkDescriptorSet> shadowDescriptorSets;
+        std::vector<std::unique_ptr<VulkrBuffer>> cascadeBuffers;
+
+        VkPipelineLayout pipelineLayout;
+        std::unique_ptr<VulkrPipeline> shadowPipeline;
+
+        std::array<Cascade, CASCADE_COUNT> cascades{};
+        size_t lastStaticCount{0};
+        uint32_t cascadesRendered{0};
+        uint64_t lastUsedFrameValue{0};
+    };
+}
+
+#endif //SHADOW_RENDER_SYSTEM_H
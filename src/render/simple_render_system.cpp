@@ -3,18 +3,21 @@
 //
 
 #include "simple_render_system.h"
+#include <array>
 #include <glm/gtc/constants.hpp>
 
 namespace vulkr {
     struct SimplePushConstantData {
-        glm::mat4 transform{1.0f}; // Identity matrix (no transformation)
+        glm::mat4 modelMatrix{1.0f}; // projection and view come from the global uniform buffer
         glm::mat4 normalMatrix{1.0f};
         int enableLighting{1}; // 1 to enable lighting, 0 to disable
     };
 
-    SimpleRenderSystem::SimpleRenderSystem(VulkrDevice &device, VkRenderPass renderPass)
-        : vulkrDevice(device) {
-        createPipelineLayout();
+    SimpleRenderSystem::SimpleRenderSystem(VulkrDevice &device, VkRenderPass renderPass,
+                                           VkDescriptorSetLayout globalSetLayout,
+                                           VkDescriptorSetLayout shadowSetLayout, TextureManager &textureManager)
+        : vulkrDevice(device), textureManager(textureManager) {
+        createPipelineLayout(globalSetLayout, shadowSetLayout);
         createPipeline(renderPass);
     }
 
@@ -22,16 +25,21 @@ namespace vulkr {
         vkDestroyPipelineLayout(vulkrDevice.device(), pipelineLayout, nullptr);
     }
 
-    void SimpleRenderSystem::createPipelineLayout() {
+    void SimpleRenderSystem::createPipelineLayout(VkDescriptorSetLayout globalSetLayout,
+                                                  VkDescriptorSetLayout shadowSetLayout) {
         VkPushConstantRange pushConstants{};
         pushConstants.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
         pushConstants.offset = 0;
         pushConstants.size = sizeof(SimplePushConstantData);
 
+        std::array<VkDescriptorSetLayout, 3> setLayouts = {
+            globalSetLayout, shadowSetLayout, textureManager.getMaterialSetLayout()
+        };
+
         VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
         pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        pipelineLayoutInfo.setLayoutCount = 0;
-        pipelineLayoutInfo.pSetLayouts = nullptr;
+        pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+        pipelineLayoutInfo.pSetLayouts = setLayouts.data();
         pipelineLayoutInfo.pushConstantRangeCount = 1;
         pipelineLayoutInfo.pPushConstantRanges = &pushConstants;
 
@@ -52,32 +60,91 @@ namespace vulkr {
             "shaders/simple_shader.frag.spv",
             pipelineConfig
         );
+
+        // color pass after the pre-pass: depth is final, only shade the fragment that produced it
+        pipelineConfig.depthStencilInfo.depthWriteEnable = VK_FALSE;
+        pipelineConfig.depthStencilInfo.depthCompareOp = VK_COMPARE_OP_EQUAL;
+
+        depthEqualPipeline = std::make_unique<VulkrPipeline>(
+            vulkrDevice,
+            "shaders/simple_shader.vert.spv",
+            "shaders/simple_shader.frag.spv",
+            pipelineConfig
+        );
+
+        PipelineConfigInfo prepassConfig{};
+        VulkrPipeline::defaultPipelineConfigInfo(prepassConfig);
+        prepassConfig.bindingDescriptions = VulkrModel::Vertex::getPositionBindingDescriptions();
+        prepassConfig.attributeDescriptions = VulkrModel::Vertex::getPositionAttributeDescriptions();
+        prepassConfig.colorBlendAttachment.colorWriteMask = 0;
+        prepassConfig.renderPass = render_pass;
+        prepassConfig.pipelineLayout = pipelineLayout;
+
+        depthPrepassPipeline = std::make_unique<VulkrPipeline>(
+            vulkrDevice,
+            "shaders/depth_prepass.vert.spv",
+            "",
+            prepassConfig
+        );
+    }
+
+    void SimpleRenderSystem::pushObjectConstants(VkCommandBuffer commandBuffer, GameObject &obj) {
+        SimplePushConstantData push{};
+        push.modelMatrix = obj.transform.mat4();
+        push.normalMatrix = obj.transform.normalMatrix();
+        push.enableLighting = obj.enableLighting ? 1 : 0;
+
+        vkCmdPushConstants(
+            commandBuffer,
+            pipelineLayout,
+            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+            0,
+            sizeof(SimplePushConstantData),
+            &push
+        );
     }
 
-    void SimpleRenderSystem::renderGameObjects(VkCommandBuffer commandBuffer, std::vector<GameObject> &gameObjects,
-                                               const Camera &camera) {
-        vulkrPipeline->bind(commandBuffer);
+    void SimpleRenderSystem::renderGameObjects(FrameInfo &frameInfo, std::vector<GameObject> &gameObjects,
+                                               const SkinningSystem &skinningSystem) {
+        VkCommandBuffer commandBuffer = frameInfo.commandBuffer;
 
-        const auto projectionView = camera.getProjectionMatrix() * camera.getView();
+        // every scene pipeline shares the layout, so the global set stays bound across the pipeline switch
+        std::array<VkDescriptorSet, 2> descriptorSets = {frameInfo.globalDescriptorSet, frameInfo.shadowDescriptorSet};
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0,
+                                static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(), 0, nullptr);
 
+        if (depthPrepass) {
+            depthPrepassPipeline->bind(commandBuffer);
+
+            for (auto &obj: gameObjects) {
+                if (obj.model == nullptr) continue;
+                pushObjectConstants(commandBuffer, obj);
+                skinningSystem.bindVertices(commandBuffer, obj, true);
+                obj.model->draw(commandBuffer);
+            }
+
+            depthEqualPipeline->bind(commandBuffer);
+        } else {
+            vulkrPipeline->bind(commandBuffer);
+        }
+
+        // only the color pass samples the material, objects sharing one skip the rebind
+        const VulkrMaterial *boundMaterial = nullptr;
         for (auto &obj: gameObjects) {
-            SimplePushConstantData push{};
-            auto modelMatrix = obj.transform.mat4();
-            push.transform = projectionView * modelMatrix;
-            push.normalMatrix = obj.transform.normalMatrix();
-            push.enableLighting = obj.enableLighting ? 1 : 0;
-
-            vkCmdPushConstants(
-                commandBuffer,
-                pipelineLayout,
-                VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                0,
-                sizeof(SimplePushConstantData),
-                &push
-            );
-
-            obj.model->bind(commandBuffer);
-            obj.model->draw(commandBuffer);
+            if (obj.model == nullptr) continue;
+            pushObjectConstants(commandBuffer, obj);
+            skinningSystem.bindVertices(commandBuffer, obj, false);
+
+            const auto &submeshes = obj.model->getSubmeshes();
+            for (uint32_t i = 0; i < submeshes.size(); i++) {
+                const auto &material = submeshes[i].material ? submeshes[i].material
+                                                             : textureManager.getDefaultMaterial();
+                if (material.get() != boundMaterial) {
+                    material->bind(commandBuffer, pipelineLayout, 2, frameInfo.frameIndex);
+                    boundMaterial = material.get();
+                }
+                obj.model->drawSubmesh(commandBuffer, i);
+            }
         }
     }
 }
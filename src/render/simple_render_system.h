@@ -5,17 +5,21 @@
 #ifndef SIMPLE_RENDER_SYSTEM_H
 #define SIMPLE_RENDER_SYSTEM_H
 
+#include "frame_info.h"
+#include "skinning_system.h"
 #include "../game/camera.h"
 #include "../game/game_object.h"
 #include "../pipeline/vulkr_device.hpp"
 #include "../pipeline/vulkr_pipeline.h"
+#include "../texture/texture_manager.h"
 
 namespace vulkr {
     class VulkrPipeline;
 
     class SimpleRenderSystem {
     public:
-        SimpleRenderSystem(VulkrDevice &device, VkRenderPass renderPass);
+        SimpleRenderSystem(VulkrDevice &device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout,
+                           VkDescriptorSetLayout shadowSetLayout, TextureManager &textureManager);
 
         ~SimpleRenderSystem();
 
@@ -23,21 +27,32 @@ namespace vulkr {
 
         SimpleRenderSystem &operator=(const SimpleRenderSystem &) = delete;
 
-        void renderGameObjects(VkCommandBuffer command_buffer, std::vector<GameObject> &game_objects,
-                               const Camera &camera);
+        /**
+         * Skinned objects are drawn from the vertex caches skinningSystem wrote this frame.
+         */
+        void renderGameObjects(FrameInfo &frameInfo, std::vector<GameObject> &gameObjects,
+                               const SkinningSystem &skinningSystem);
+
+        /**
+         * Lays down depth for all objects with a position-only pipeline first, so the color pass only
+         * shades the visible fragment of each pixel.
+         */
+        bool depthPrepass{true};
 
     private:
-        void createPipelineLayout();
+        void createPipelineLayout(VkDescriptorSetLayout globalSetLayout, VkDescriptorSetLayout shadowSetLayout);
 
         void createPipeline(VkRenderPass renderPass);
 
+        void pushObjectConstants(VkCommandBuffer commandBuffer, GameObject &obj);
+
         VulkrDevice &vulkrDevice;
+        TextureManager &textureManager;
 
         std::unique_ptr<VulkrPipeline> vulkrPipeline;
+        std::unique_ptr<VulkrPipeline> depthPrepassPipeline;
+        std::unique_ptr<VulkrPipeline> depthEqualPipeline;
         VkPipelineLayout pipelineLayout;
-
-        VkDescriptorSetLayout descriptorSetLayout;
-        VkDescriptorPool descriptorPool;
     };
 }
 
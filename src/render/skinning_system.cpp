@@ -0,0 +1,298 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "skinning_system.h"
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#include "../pipeline/vulkr_swap_chain.hpp"
+
+namespace vulkr {
+    // must match local_size_x in skin.comp
+    static constexpr uint32_t SKIN_GROUP_SIZE = 64;
+
+    struct SkinPushConstantData {
+        uint32_t jointOffset;
+        uint32_t vertexCount;
+    };
+
+    SkinningSystem::SkinningSystem(VulkrDevice &device) : vulkrDevice{device} {
+        createBuffers();
+        createDescriptors();
+        createPipelineLayout();
+        skinPipeline = std::make_unique<VulkrComputePipeline>(vulkrDevice, "shaders/skin.comp.spv", pipelineLayout);
+    }
+
+    SkinningSystem::~SkinningSystem() {
+        vkDestroyPipelineLayout(vulkrDevice.device(), pipelineLayout, nullptr);
+    }
+
+    void SkinningSystem::createBuffers() {
+        for (int i = 0; i < VulkrSwapChain::MAX_FRAMES_IN_FLIGHT; i++) {
+            auto &palette = paletteBuffers.emplace_back(std::make_unique<VulkrBuffer>(
+                vulkrDevice, sizeof(glm::mat4), INITIAL_JOINTS, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+            palette->map();
+        }
+    }
+
+    void SkinningSystem::createDescriptors() {
+        paletteSetLayout = VulkrDescriptorSetLayout::Builder(vulkrDevice)
+                .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                .build();
+
+        // source positions and attributes, skinned positions and attributes
+        cacheSetLayout = VulkrDescriptorSetLayout::Builder(vulkrDevice)
+                .addBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                .addBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                .addBinding(3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+                .build();
+
+        // the palette sets, the cache sets come from cachePools
+        descriptorPool = VulkrDescriptorPool::Builder(vulkrDevice)
+                .setMaxSets(VulkrSwapChain::MAX_FRAMES_IN_FLIGHT)
+                .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VulkrSwapChain::MAX_FRAMES_IN_FLIGHT)
+                .build();
+
+        paletteDescriptorSets.resize(VulkrSwapChain::MAX_FRAMES_IN_FLIGHT);
+        for (int i = 0; i < VulkrSwapChain::MAX_FRAMES_IN_FLIGHT; i++) {
+            auto paletteInfo = paletteBuffers[i]->descriptorInfo();
+            if (!VulkrDescriptorWriter(*paletteSetLayout, *descriptorPool)
+                    .writeBuffer(0, &paletteInfo)
+                    .build(paletteDescriptorSets[i])) {
+                throw std::runtime_error("failed to allocate joint palette descriptor set!");
+            }
+        }
+    }
+
+    void SkinningSystem::createPipelineLayout() {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(SkinPushConstantData);
+
+        std::array<VkDescriptorSetLayout, 2> setLayouts = {
+            paletteSetLayout->getDescriptorSetLayout(), cacheSetLayout->getDescriptorSetLayout()
+        };
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+        pipelineLayoutInfo.pSetLayouts = setLayouts.data();
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(vulkrDevice.device(), &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create skinning pipeline layout!");
+        }
+    }
+
+    VkDescriptorSet SkinningSystem::allocateCacheSet() {
+        auto &timeline = vulkrDevice.frameTimeline();
+        for (auto it = retiredSets.begin(); it != retiredSets.end(); ++it) {
+            if (timeline.isComplete(it->frameValue)) {
+                VkDescriptorSet set = it->set;
+                retiredSets.erase(it);
+                return set;
+            }
+        }
+
+        VkDescriptorSet set;
+        if (!cachePools.empty() &&
+            cachePools.back()->allocateDescriptor(cacheSetLayout->getDescriptorSetLayout(), set)) {
+            return set;
+        }
+
+        // the current pool is full, sets are never freed back to it, so it stays in use as it is
+        cachePools.push_back(VulkrDescriptorPool::Builder(vulkrDevice)
+                .setMaxSets(INSTANCES_PER_POOL)
+                .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4 * INSTANCES_PER_POOL)
+                .build());
+        if (!cachePools.back()->allocateDescriptor(cacheSetLayout->getDescriptorSetLayout(), set)) {
+            throw std::runtime_error("failed to allocate skinned vertex cache descriptor set!");
+        }
+        return set;
+    }
+
+    void SkinningSystem::reservePalette(int frameIndex, uint32_t joints) {
+        auto &palette = paletteBuffers[frameIndex];
+        if (joints <= palette->getInstanceCount()) return;
+
+        uint32_t capacity = palette->getInstanceCount();
+        while (capacity < joints) capacity *= 2;
+
+        // the slot's previous frame has completed, so its buffer and set are free to replace, the old buffer
+        // retires itself
+        palette = std::make_unique<VulkrBuffer>(
+            vulkrDevice, sizeof(glm::mat4), capacity, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        palette->map();
+
+        auto paletteInfo = palette->descriptorInfo();
+        VulkrDescriptorWriter(*paletteSetLayout, *descriptorPool)
+                .writeBuffer(0, &paletteInfo)
+                .overwrite(paletteDescriptorSets[frameIndex]);
+    }
+
+    SkinningSystem::VertexCache &SkinningSystem::getOrCreateCache(const GameObject &obj) {
+        VertexCache &cache = caches[obj.getId()];
+        if (cache.model == obj.model.get()) {
+            return cache;
+        }
+
+        const VulkrModel &model = *obj.model;
+        const uint32_t vertexCount = model.getVertexCount();
+        // frames in flight may still have the old set bound, it is reused once they completed
+        if (cache.descriptorSet != VK_NULL_HANDLE) {
+            retiredSets.push_back({cache.descriptorSet, vulkrDevice.frameTimeline().getCurrentValue()});
+        }
+        cache.descriptorSet = allocateCacheSet();
+        cache.model = &model;
+
+        // the old buffers retire themselves
+        cache.positions = std::make_unique<VulkrBuffer>(
+            vulkrDevice, sizeof(glm::vec3), vertexCount,
+            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        cache.attributes = std::make_unique<VulkrBuffer>(
+            vulkrDevice, sizeof(VulkrModel::VertexAttributes), vertexCount,
+            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        // colors, uvs and joints never change, so the pass only has to rewrite positions and normals
+        pendingCopies.push_back({
+            model.getAttributeBuffer(), cache.attributes->getBuffer(),
+            sizeof(VulkrModel::VertexAttributes) * vertexCount
+        });
+
+        VkDescriptorBufferInfo sourcePositions{model.getPositionBuffer(), 0, VK_WHOLE_SIZE};
+        VkDescriptorBufferInfo sourceAttributes{model.getAttributeBuffer(), 0, VK_WHOLE_SIZE};
+        auto skinnedPositions = cache.positions->descriptorInfo();
+        auto skinnedAttributes = cache.attributes->descriptorInfo();
+        VulkrDescriptorWriter(*cacheSetLayout, *descriptorPool)
+                .writeBuffer(0, &sourcePositions)
+                .writeBuffer(1, &sourceAttributes)
+                .writeBuffer(2, &skinnedPositions)
+                .writeBuffer(3, &skinnedAttributes)
+                .overwrite(cache.descriptorSet);
+
+        return cache;
+    }
+
+    void SkinningSystem::update(int frameIndex, std::vector<GameObject> &gameObjects,
+                                const AnimationScheduler &scheduler) {
+        uint32_t requiredJoints = 0;
+        for (const auto &obj: gameObjects) {
+            if (obj.model != nullptr && obj.model->isSkinned()) {
+                requiredJoints += obj.model->getSkeleton().getJointCount();
+            }
+        }
+        reservePalette(frameIndex, requiredJoints);
+
+        auto *palette = static_cast<glm::mat4 *>(paletteBuffers[frameIndex]->getMappedMemory());
+        activeCaches.clear();
+        jointCount = 0;
+        updateCount++;
+
+        for (auto &obj: gameObjects) {
+            if (obj.model == nullptr || !obj.model->isSkinned()) continue;
+
+            const Skeleton &skeleton = obj.model->getSkeleton();
+
+            if (const glm::mat4 *scheduled = scheduler.getPalette(obj.getId())) {
+                std::memcpy(palette + jointCount, scheduled, sizeof(glm::mat4) * skeleton.getJointCount());
+            } else {
+                skeleton.computePalette(obj.model->getRestPose(), nodeGlobals, palette + jointCount);
+            }
+
+            VertexCache &cache = getOrCreateCache(obj);
+            cache.jointOffset = jointCount;
+            cache.lastUpdate = updateCount;
+            activeCaches.push_back(&cache);
+            jointCount += skeleton.getJointCount();
+        }
+
+        // objects that are gone or no longer skinned release their caches
+        const uint64_t frameValue = vulkrDevice.frameTimeline().getCurrentValue();
+        for (auto it = caches.begin(); it != caches.end();) {
+            if (it->second.lastUpdate == updateCount) {
+                ++it;
+                continue;
+            }
+            retiredSets.push_back({it->second.descriptorSet, frameValue});
+            it = caches.erase(it);
+        }
+    }
+
+    void SkinningSystem::skin(VkCommandBuffer commandBuffer, int frameIndex) {
+        if (activeCaches.empty()) return;
+
+        // the caches are reused every frame, wait for the previous frame's draws before overwriting them
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 0, nullptr);
+
+        // new caches start from their model's attributes, the dispatch then rewrites positions and normals
+        if (!pendingCopies.empty()) {
+            for (const AttributeCopy &copy: pendingCopies) {
+                VkBufferCopy region{0, 0, copy.size};
+                vkCmdCopyBuffer(commandBuffer, copy.source, copy.destination, 1, &region);
+            }
+            pendingCopies.clear();
+
+            VkMemoryBarrier copyBarrier{};
+            copyBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            copyBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            copyBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 0, 1, &copyBarrier, 0, nullptr, 0, nullptr);
+        }
+
+        skinPipeline->bind(commandBuffer);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1,
+                                &paletteDescriptorSets[frameIndex], 0, nullptr);
+
+        for (const VertexCache *cache: activeCaches) {
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 1, 1,
+                                    &cache->descriptorSet, 0, nullptr);
+
+            SkinPushConstantData push{cache->jointOffset, cache->model->getVertexCount()};
+            vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0,
+                               sizeof(SkinPushConstantData), &push);
+            vkCmdDispatch(commandBuffer, (push.vertexCount + SKIN_GROUP_SIZE - 1) / SKIN_GROUP_SIZE, 1, 1);
+        }
+
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                             0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    void SkinningSystem::bindVertices(VkCommandBuffer commandBuffer, GameObject &obj, bool positionsOnly) const {
+        const auto it = caches.find(obj.getId());
+        const bool skinned = it != caches.end() && it->second.lastUpdate == updateCount &&
+                             it->second.model == obj.model.get();
+
+        if (!skinned) {
+            if (positionsOnly) {
+                obj.model->bindPositions(commandBuffer);
+            } else {
+                obj.model->bind(commandBuffer);
+            }
+            return;
+        }
+
+        const VertexCache &cache = it->second;
+        if (positionsOnly) {
+            obj.model->bindPositions(commandBuffer, cache.positions->getBuffer());
+        } else {
+            obj.model->bind(commandBuffer, cache.positions->getBuffer(), cache.attributes->getBuffer());
+        }
+    }
+}
@@ -0,0 +1,120 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef SKINNING_SYSTEM_H
+#define SKINNING_SYSTEM_H
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "../animation/animation_scheduler.h"
+#include "../game/game_object.h"
+#include "../pipeline/vulkr_buffer.h"
+#include "../pipeline/vulkr_compute_pipeline.h"
+#include "../pipeline/vulkr_descriptors.h"
+#include "../pipeline/vulkr_device.hpp"
+
+namespace vulkr {
+    /**
+     * Skins every animated instance once per frame with a compute pass. The joint palettes of all instances are
+     * packed into one persistently mapped storage buffer per frame slot; each instance owns a skinned vertex
+     * cache (positions and attributes in the model's vertex layout) that the depth pre-pass, shadow and scene
+     * passes bind as static geometry through bindVertices().
+     */
+    class SkinningSystem {
+    public:
+        // joint matrices per frame to start with, shared by all instances, the palettes grow past it as needed
+        static constexpr uint32_t INITIAL_JOINTS = 16384;
+        // cache descriptor sets per pool, another pool is added when they run out
+        static constexpr uint32_t INSTANCES_PER_POOL = 256;
+
+        explicit SkinningSystem(VulkrDevice &device);
+
+        ~SkinningSystem();
+
+        SkinningSystem(const SkinningSystem &) = delete;
+
+        SkinningSystem &operator=(const SkinningSystem &) = delete;
+
+        /**
+         * Uploads the palette the scheduler evaluated for every animated skinned object, the rest pose
+         * palette for the others.
+         */
+        void update(int frameIndex, std::vector<GameObject> &gameObjects, const AnimationScheduler &scheduler);
+
+        /**
+         * Records the attribute copies of caches created by update, then the skinning dispatches. Must be
+         * recorded outside of a render pass, in the frame of the update. Makes the caches visible to vertex
+         * input, so it only has to precede the passes that draw skinned objects.
+         */
+        void skin(VkCommandBuffer commandBuffer, int frameIndex);
+
+        /**
+         * Binds the skinned cache of obj if it has one this frame, the model's own buffers otherwise.
+         */
+        void bindVertices(VkCommandBuffer commandBuffer, GameObject &obj, bool positionsOnly) const;
+
+        uint32_t getSkinnedInstanceCount() const { return static_cast<uint32_t>(activeCaches.size()); }
+        uint32_t getJointCount() const { return jointCount; }
+
+    private:
+        struct VertexCache {
+            const VulkrModel *model{nullptr};
+            std::unique_ptr<VulkrBuffer> positions;
+            std::unique_ptr<VulkrBuffer> attributes;
+            VkDescriptorSet descriptorSet{VK_NULL_HANDLE};
+            uint32_t jointOffset{0};
+            uint64_t lastUpdate{0};
+        };
+
+        // attributes copied from a model into a new cache, recorded ahead of the frame's dispatches
+        struct AttributeCopy {
+            VkBuffer source;
+            VkBuffer destination;
+            VkDeviceSize size;
+        };
+
+        // descriptor sets of released caches, reused once the frames that bound them completed
+        struct RetiredSet {
+            VkDescriptorSet set;
+            uint64_t frameValue;
+        };
+
+        void createBuffers();
+
+        void createDescriptors();
+
+        void createPipelineLayout();
+
+        VertexCache &getOrCreateCache(const GameObject &obj);
+
+        VkDescriptorSet allocateCacheSet();
+
+        void reservePalette(int frameIndex, uint32_t joints);
+
+        VulkrDevice &vulkrDevice;
+
+        std::vector<std::unique_ptr<VulkrBuffer>> paletteBuffers;
+        std::unique_ptr<VulkrDescriptorSetLayout> paletteSetLayout;
+        std::unique_ptr<VulkrDescriptorSetLayout> cacheSetLayout;
+        std::unique_ptr<VulkrDescriptorPool> descriptorPool;
+        std::vector<std::unique_ptr<VulkrDescriptorPool>> cachePools;
+        std::vector<VkDescriptorSet> paletteDescriptorSets;
+
+        VkPipelineLayout pipelineLayout;
+        std::unique_ptr<VulkrComputePipeline> skinPipeline;
+
+        std::unordered_map<GameObject::id_t, VertexCache> caches;
+        // caches skinned this frame, in dispatch order
+        std::vector<VertexCache *> activeCaches;
+        std::vector<RetiredSet> retiredSets;
+        std::vector<AttributeCopy> pendingCopies;
+        std::vector<glm::mat4> nodeGlobals;
+        uint32_t jointCount{0};
+        uint64_t updateCount{0};
+    };
+}
+
+#endif //SKINNING_SYSTEM_H
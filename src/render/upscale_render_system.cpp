@@ -0,0 +1,140 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "upscale_render_system.h"
+
+#include <stdexcept>
+#include <glm/glm.hpp>
+
+#include "../pipeline/vulkr_swap_chain.hpp"
+
+namespace vulkr {
+    struct UpscalePushConstantData {
+        glm::vec2 uvScale{1.0f};
+        glm::vec2 uvClamp{1.0f};
+        glm::vec2 texelSize{0.0f};
+        float sharpness{0.0f};
+    };
+
+    UpscaleRenderSystem::UpscaleRenderSystem(VulkrDevice &device, VkRenderPass renderPass)
+        : vulkrDevice(device) {
+        createSampler();
+        createDescriptors();
+        createPipelineLayout();
+        createPipeline(renderPass);
+    }
+
+    UpscaleRenderSystem::~UpscaleRenderSystem() {
+        vkDestroyPipelineLayout(vulkrDevice.device(), pipelineLayout, nullptr);
+        vkDestroySampler(vulkrDevice.device(), sampler, nullptr);
+    }
+
+    void UpscaleRenderSystem::createSampler() {
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_LINEAR;
+        samplerInfo.minFilter = VK_FILTER_LINEAR;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod = 0.0f;
+
+        if (vkCreateSampler(vulkrDevice.device(), &samplerInfo, nullptr, &sampler) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create upscale sampler!");
+        }
+    }
+
+    void UpscaleRenderSystem::createDescriptors() {
+        descriptorSetLayout = VulkrDescriptorSetLayout::Builder(vulkrDevice)
+                .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT)
+                .build();
+
+        descriptorPool = VulkrDescriptorPool::Builder(vulkrDevice)
+                .setMaxSets(VulkrSwapChain::MAX_FRAMES_IN_FLIGHT)
+                .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VulkrSwapChain::MAX_FRAMES_IN_FLIGHT)
+                .build();
+
+        descriptorSets.resize(VulkrSwapChain::MAX_FRAMES_IN_FLIGHT, VK_NULL_HANDLE);
+        boundGenerations.resize(VulkrSwapChain::MAX_FRAMES_IN_FLIGHT, 0);
+        for (auto &set: descriptorSets) {
+            if (!descriptorPool->allocateDescriptor(descriptorSetLayout->getDescriptorSetLayout(), set)) {
+                throw std::runtime_error("failed to allocate upscale descriptor set!");
+            }
+        }
+    }
+
+    void UpscaleRenderSystem::createPipelineLayout() {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(UpscalePushConstantData);
+
+        VkDescriptorSetLayout setLayout = descriptorSetLayout->getDescriptorSetLayout();
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &setLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(vulkrDevice.device(), &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create upscale pipeline layout!");
+        }
+    }
+
+    void UpscaleRenderSystem::createPipeline(VkRenderPass renderPass) {
+        PipelineConfigInfo pipelineConfig{};
+        VulkrPipeline::defaultPipelineConfigInfo(pipelineConfig);
+        pipelineConfig.bindingDescriptions.clear();
+        pipelineConfig.attributeDescriptions.clear();
+        pipelineConfig.depthStencilInfo.depthTestEnable = VK_FALSE;
+        pipelineConfig.depthStencilInfo.depthWriteEnable = VK_FALSE;
+        pipelineConfig.renderPass = renderPass;
+        pipelineConfig.pipelineLayout = pipelineLayout;
+
+        vulkrPipeline = std::make_unique<VulkrPipeline>(
+            vulkrDevice,
+            "shaders/upscale.vert.spv",
+            "shaders/upscale.frag.spv",
+            pipelineConfig
+        );
+    }
+
+    void UpscaleRenderSystem::render(VkCommandBuffer commandBuffer, int frameIndex, VkImageView sceneImage,
+                                     uint32_t viewGeneration, VkExtent2D imageExtent, VkExtent2D renderExtent,
+                                     VkExtent2D outputExtent) {
+        VkDescriptorSet &descriptorSet = descriptorSets[frameIndex];
+        if (boundGenerations[frameIndex] != viewGeneration) {
+            // this slot's previous frame has completed, so the set is safe to rewrite
+            VkDescriptorImageInfo imageInfo{};
+            imageInfo.sampler = sampler;
+            imageInfo.imageView = sceneImage;
+            imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+            VulkrDescriptorWriter(*descriptorSetLayout, *descriptorPool)
+                    .writeImage(0, &imageInfo)
+                    .overwrite(descriptorSet);
+            boundGenerations[frameIndex] = viewGeneration;
+        }
+
+        const glm::vec2 targetSize{static_cast<float>(imageExtent.width), static_cast<float>(imageExtent.height)};
+        const glm::vec2 renderSize{static_cast<float>(renderExtent.width), static_cast<float>(renderExtent.height)};
+
+        UpscalePushConstantData push{};
+        push.uvScale = renderSize / targetSize;
+        push.uvClamp = (renderSize - 0.5f) / targetSize;
+        push.texelSize = 1.0f / targetSize;
+        // the image may be larger than the output, only sharpen when the scene is actually scaled up
+        push.sharpness = renderExtent.width < outputExtent.width ? sharpness : 0.0f;
+
+        vulkrPipeline->bind(commandBuffer);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1,
+                                &descriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                           0, sizeof(UpscalePushConstantData), &push);
+        vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+    }
+}
@@ -0,0 +1,64 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef UPSCALE_RENDER_SYSTEM_H
+#define UPSCALE_RENDER_SYSTEM_H
+
+#include <memory>
+#include <vector>
+
+#include "../pipeline/vulkr_descriptors.h"
+#include "../pipeline/vulkr_device.hpp"
+#include "../pipeline/vulkr_pipeline.h"
+
+namespace vulkr {
+    /**
+     * Scales the rendered sub-rectangle of the scene image onto the current render pass with a bilinear
+     * filter and an optional sharpening pass that kicks in while rendering below native resolution.
+     */
+    class UpscaleRenderSystem {
+    public:
+        UpscaleRenderSystem(VulkrDevice &device, VkRenderPass renderPass);
+
+        ~UpscaleRenderSystem();
+
+        UpscaleRenderSystem(const UpscaleRenderSystem &) = delete;
+
+        UpscaleRenderSystem &operator=(const UpscaleRenderSystem &) = delete;
+
+        /**
+         * sceneImage must be in SHADER_READ_ONLY layout. viewGeneration changes whenever the view may have been
+         * recreated, Vulkan handles alone can be reused after destruction. renderExtent of the image's imageExtent
+         * is stretched over outputExtent.
+         */
+        void render(VkCommandBuffer commandBuffer, int frameIndex, VkImageView sceneImage, uint32_t viewGeneration,
+                    VkExtent2D imageExtent, VkExtent2D renderExtent, VkExtent2D outputExtent);
+
+        float sharpness{0.25f};
+
+    private:
+        void createSampler();
+
+        void createDescriptors();
+
+        void createPipelineLayout();
+
+        void createPipeline(VkRenderPass renderPass);
+
+        VulkrDevice &vulkrDevice;
+
+        std::unique_ptr<VulkrPipeline> vulkrPipeline;
+        VkPipelineLayout pipelineLayout;
+        VkSampler sampler = VK_NULL_HANDLE;
+
+        std::unique_ptr<VulkrDescriptorSetLayout> descriptorSetLayout;
+        std::unique_ptr<VulkrDescriptorPool> descriptorPool;
+
+        // one set per frame slot so a resize never rewrites a set the GPU is still reading
+        std::vector<VkDescriptorSet> descriptorSets;
+        std::vector<uint32_t> boundGenerations;
+    };
+}
+
+#endif //UPSCALE_RENDER_SYSTEM_H
@@ -4,7 +4,6 @@
 
 #include "vulkr_renderer.h"
 
-#include <array>
 #include <functional>
 #include <stdexcept>
 #include <chrono>
@@ -15,6 +14,7 @@ namespace vulkr {
     : vulkrWindow(window), vulkrDevice(device), isFrameStarted(false), currentFrameIndex(0) {
         recreateSwapChain();
         createCommandBuffers();
+        gpuTimer = std::make_unique<VulkrGpuTimer>(vulkrDevice, VulkrSwapChain::MAX_FRAMES_IN_FLIGHT);
     }
 
     VulkrRenderer::~VulkrRenderer() {
@@ -26,6 +26,9 @@ namespace vulkr {
 
         auto result = vulkrSwapChain->acquireNextImage(&currentImageIndex);
 
+        // the frame slot wait above is the natural point to release anything the GPU is done with
+        vulkrDevice.deletionQueue().collect();
+
         if (result == VK_ERROR_OUT_OF_DATE_KHR) {
             recreateSwapChain();
             return nullptr;
@@ -36,6 +39,7 @@ namespace vulkr {
         }
 
         isFrameStarted = true;
+        vulkrDevice.frameTimeline().advance();
 
         const auto commandBuffer = getCurrentCommandBuffer();
 
@@ -46,6 +50,9 @@ namespace vulkr {
             throw std::runtime_error("Failed to begin command buffer operation!");
         }
 
+        updateRenderScale();
+        gpuTimer->begin(commandBuffer, currentFrameIndex);
+
         return commandBuffer;
     }
 
@@ -53,11 +60,14 @@ namespace vulkr {
         assert (isFrameStarted && "Cannot call endFrame while a frame is not in progress!");
         const auto commandBuffer = getCurrentCommandBuffer();
 
+        gpuTimer->end(commandBuffer, currentFrameIndex);
+
         if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
             throw std::runtime_error("Failed to end command buffer operation!");
         }
 
-        auto result = vulkrSwapChain->submitCommandBuffers(&commandBuffer, &currentImageIndex);
+        auto result = vulkrSwapChain->submitCommandBuffers(&commandBuffer, &currentImageIndex,
+                                                           vulkrDevice.frameTimeline().getCurrentValue());
 
         if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || vulkrWindow.wasFrameBufferResized()) {
             vulkrWindow.resetFrameBufferResized();
@@ -71,51 +81,20 @@ namespace vulkr {
         currentFrameIndex = (currentFrameIndex + 1) % VulkrSwapChain::MAX_FRAMES_IN_FLIGHT;
     }
 
-    void VulkrRenderer::beginSwapChainRenderPass(VkCommandBuffer commandBuffer) {
-        assert(isFrameStarted && "Cannot call beginSwapChainRenderPass when frame is not in progress!");
-        assert(commandBuffer == getCurrentCommandBuffer() && "Cannot call beginSwapChainRenderPass with command buffer that is not current!");
-
-        VkCommandBufferBeginInfo beginInfo{};
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-
-        if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to begin command buffer operation!");
-        }
-
-        VkRenderPassBeginInfo renderPassInfo{};
-        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassInfo.renderPass = vulkrSwapChain->getRenderPass();
-        renderPassInfo.framebuffer = vulkrSwapChain->getFrameBuffer(currentImageIndex);
-
-        renderPassInfo.renderArea.offset.x = 0;
-        renderPassInfo.renderArea.offset.y = 0;
-        renderPassInfo.renderArea.extent = vulkrSwapChain->getSwapChainExtent();
-
-        std::array<VkClearValue, 2> clearValues{};
-        clearValues[0].color = {0.4f, 0.4f, 0.4f, 1.0f};
-        clearValues[1].depthStencil = {1.0f, 0};
-        renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
-        renderPassInfo.pClearValues = clearValues.data();
-
-        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-        VkViewport viewport{};
-        viewport.x = 0.0f;
-        viewport.y = 0.0f;
-        viewport.width = static_cast<float>(vulkrSwapChain->getSwapChainExtent().width);
-        viewport.height = static_cast<float>(vulkrSwapChain->getSwapChainExtent().height);
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
-        VkRect2D scissor{{0, 0}, vulkrSwapChain->getSwapChainExtent()};
-        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
-        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+    void VulkrRenderer::setDynamicResolutionEnabled(bool enabled) {
+        dynamicResolutionEnabled = enabled;
+        resolutionController.reset();
     }
 
-    void VulkrRenderer::endSwapChainRenderPass(VkCommandBuffer commandBuffer) {
-        assert(isFrameStarted && "Cannot call endSwapChainRenderPass when frame is not in progress!");
-        assert(commandBuffer == getCurrentCommandBuffer() && "Cannot call endSwapChainRenderPass with command buffer that is not current!");
+    void VulkrRenderer::updateRenderScale() {
+        // this slot's previous frame has completed, so its timestamps are ready without stalling
+        float gpuMs = 0.0f;
+        if (gpuTimer->readMilliseconds(currentFrameIndex, gpuMs)) {
+            resolutionController.update(gpuMs);
+        }
 
-        vkCmdEndRenderPass(commandBuffer);
+        const VkExtent2D fullExtent = vulkrSwapChain->getSwapChainExtent();
+        sceneExtent = dynamicResolutionEnabled ? resolutionController.getRenderExtent(fullExtent) : fullExtent;
     }
 
     void VulkrRenderer::createCommandBuffers() {
@@ -138,13 +117,19 @@ namespace vulkr {
     }
 
     void VulkrRenderer::recreateSwapChain() {
+        // a minimised window has nothing to present to, so block until it is restored
         auto extent = vulkrWindow.getExtent();
         while (extent.width == 0 || extent.height == 0) {
             extent = vulkrWindow.getExtent();
             glfwWaitEvents();
         }
 
-        vkDeviceWaitIdle(vulkrDevice.device());
+        auto &timeline = vulkrDevice.frameTimeline();
+
+        // without a timeline there is no way to tell when the old swap chain is out of flight
+        if (!timeline.usesTimelineSemaphore()) {
+            vkDeviceWaitIdle(vulkrDevice.device());
+        }
 
         if (vulkrSwapChain == nullptr) {
             vulkrSwapChain = std::make_unique<VulkrSwapChain>(vulkrDevice, extent);
@@ -156,7 +141,18 @@ namespace vulkr {
             if (!oldSwapChain->compareSwapFormats(*vulkrSwapChain)) {
                 throw std::runtime_error("swap chain image (or depth) format has changed!");
             }
+
+            // the old swap chain was handed to oldSwapchain. Its last present may still wait on its render finished
+            // semaphore after the frame completed and nothing signals when it is done, so the semaphores are kept
+            // until a full round of frames on the new swap chain has completed behind it
+            const uint64_t releaseValue = timeline.getCurrentValue() + VulkrSwapChain::MAX_FRAMES_IN_FLIGHT;
+            vulkrDevice.deletionQueue().retire(releaseValue, [oldSwapChain]() mutable {
+                oldSwapChain.reset();
+            });
         }
+
+        sceneExtent = vulkrSwapChain->getSwapChainExtent();
+        swapChainGeneration++;
     }
 }
 
@@ -9,7 +9,9 @@
 #include <vector>
 #include <vulkan/vulkan_core.h>
 
+#include "dynamic_resolution.h"
 #include "../pipeline/vulkr_device.hpp"
+#include "../pipeline/vulkr_gpu_timer.h"
 #include "../pipeline/vulkr_swap_chain.hpp"
 
 
@@ -26,6 +28,24 @@ namespace vulkr {
 
         VkRenderPass getSwapChainRenderPass() const { return vulkrSwapChain->getRenderPass(); }
         float getAspectRatio() const { return vulkrSwapChain->extentAspectRatio(); }
+        VkExtent2D getSwapChainExtent() const { return vulkrSwapChain->getSwapChainExtent(); }
+        VkFormat getSwapChainImageFormat() const { return vulkrSwapChain->getSwapChainImageFormat(); }
+        VkFormat getSwapChainDepthFormat() const { return vulkrSwapChain->getSwapChainDepthFormat(); }
+
+        /**
+         * Bumped every time the swap chain is recreated, anything built from its images has to be rebuilt.
+         */
+        uint32_t getSwapChainGeneration() const { return swapChainGeneration; }
+
+        VkImage getCurrentSwapChainImage() const {
+            assert(isFrameStarted && "Cannot get swap chain image when frame is not in progress!");
+            return vulkrSwapChain->getImage(static_cast<int>(currentImageIndex));
+        }
+
+        VkImageView getCurrentSwapChainImageView() const {
+            assert(isFrameStarted && "Cannot get swap chain image view when frame is not in progress!");
+            return vulkrSwapChain->getImageView(static_cast<int>(currentImageIndex));
+        }
 
         [[nodiscard]] bool isFrameInProgress() const { return isFrameStarted; }
 
@@ -39,13 +59,31 @@ namespace vulkr {
             return currentFrameIndex;
         }
 
+        /**
+         * Frame timeline value signalled when the frame in progress completes on the GPU.
+         */
+        uint64_t getFrameValue() const {
+            assert(isFrameStarted && "Cannot get frame value when frame is not in progress!");
+            return vulkrDevice.frameTimeline().getCurrentValue();
+        }
+
         VkCommandBuffer beginFrame();
 
         void endFrame();
 
-        void beginSwapChainRenderPass(VkCommandBuffer commandBuffer);
+        /**
+         * Extent the scene is rendered at this frame, fixed for the whole frame. Scene targets are allocated
+         * at the swap chain extent and only this sub-rectangle of them is rendered.
+         */
+        VkExtent2D getSceneExtent() const { return sceneExtent; }
 
-        void endSwapChainRenderPass(VkCommandBuffer commandBuffer);
+        float getRenderScale() const { return dynamicResolutionEnabled ? resolutionController.getScale() : 1.0f; }
+        float getGpuFrameMs() const { return resolutionController.getSmoothedGpuMs(); }
+
+        void setDynamicResolutionEnabled(bool enabled);
+        bool isDynamicResolutionEnabled() const { return dynamicResolutionEnabled; }
+
+        DynamicResolutionController &getResolutionController() { return resolutionController; }
 
     private:
         void createCommandBuffers();
@@ -54,12 +92,20 @@ namespace vulkr {
 
         void recreateSwapChain();
 
+        void updateRenderScale();
+
         VulkrWindow &vulkrWindow;
         VulkrDevice &vulkrDevice;
 
         std::unique_ptr<VulkrSwapChain> vulkrSwapChain;
         std::vector<VkCommandBuffer> commandBuffers;
 
+        std::unique_ptr<VulkrGpuTimer> gpuTimer;
+        DynamicResolutionController resolutionController;
+        bool dynamicResolutionEnabled{true};
+        VkExtent2D sceneExtent{};
+        uint32_t swapChainGeneration{0};
+
         uint32_t currentImageIndex{0};
         int currentFrameIndex{0};
         bool isFrameStarted{false};
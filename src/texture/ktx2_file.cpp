@@ -0,0 +1,125 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "ktx2_file.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+namespace vulkr {
+    namespace {
+        constexpr std::array<uint8_t, 12> IDENTIFIER = {
+            0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+        };
+        // identifier, nine uint32 fields, the DFD and KVD ranges as uint32, the SGD range as uint64
+        constexpr size_t HEADER_SIZE = 80;
+        // byteOffset, byteLength and uncompressedByteLength, all uint64
+        constexpr size_t LEVEL_INDEX_ENTRY_SIZE = 24;
+
+        template<typename T>
+        T read(std::span<const uint8_t> bytes, size_t offset) {
+            T value;
+            std::memcpy(&value, bytes.data() + offset, sizeof(T));
+            return value;
+        }
+
+        // bytes per 4x4 block, or per texel for uncompressed formats
+        uint32_t blockBytes(VkFormat format, bool &compressed) {
+            compressed = true;
+            switch (format) {
+                case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+                case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+                case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+                case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+                case VK_FORMAT_BC4_UNORM_BLOCK:
+                    return 8;
+                case VK_FORMAT_BC3_UNORM_BLOCK:
+                case VK_FORMAT_BC3_SRGB_BLOCK:
+                case VK_FORMAT_BC5_UNORM_BLOCK:
+                case VK_FORMAT_BC7_UNORM_BLOCK:
+                case VK_FORMAT_BC7_SRGB_BLOCK:
+                    return 16;
+                case VK_FORMAT_R8G8B8A8_UNORM:
+                case VK_FORMAT_R8G8B8A8_SRGB:
+                    compressed = false;
+                    return 4;
+                default:
+                    return 0;
+            }
+        }
+    }
+
+    Ktx2File::Ktx2File(const std::string &path) : file{std::make_unique<MappedFile>(path)} {
+        parse(file->getData(), path);
+    }
+
+    Ktx2File::Ktx2File(std::span<const uint8_t> bytes) {
+        parse(bytes, "from memory");
+    }
+
+    bool Ktx2File::isKtx2(std::span<const uint8_t> bytes) {
+        return bytes.size() >= IDENTIFIER.size() && std::equal(IDENTIFIER.begin(), IDENTIFIER.end(), bytes.begin());
+    }
+
+    bool Ktx2File::isKtx2Path(const std::string &path) {
+        return path.size() >= 5 && path.compare(path.size() - 5, 5, ".ktx2") == 0;
+    }
+
+    VkDeviceSize Ktx2File::levelSize(VkFormat format, uint32_t width, uint32_t height) {
+        bool compressed;
+        const VkDeviceSize bytes = blockBytes(format, compressed);
+        if (compressed) {
+            return bytes * ((width + 3) / 4) * ((height + 3) / 4);
+        }
+        return bytes * width * height;
+    }
+
+    void Ktx2File::parse(std::span<const uint8_t> bytes, const std::string &name) {
+        if (bytes.size() < HEADER_SIZE || !isKtx2(bytes)) {
+            throw std::runtime_error("failed to read KTX2 file " + name + ", not a KTX2 file!");
+        }
+
+        format = static_cast<VkFormat>(read<uint32_t>(bytes, 12));
+        width = read<uint32_t>(bytes, 20);
+        height = read<uint32_t>(bytes, 24);
+        const uint32_t depth = read<uint32_t>(bytes, 28);
+        const uint32_t layerCount = read<uint32_t>(bytes, 32);
+        const uint32_t faceCount = read<uint32_t>(bytes, 36);
+        // 0 asks the loader to generate the chain, only the top level is stored then
+        const uint32_t levelCount = std::max(read<uint32_t>(bytes, 40), 1u);
+        const uint32_t supercompressionScheme = read<uint32_t>(bytes, 44);
+
+        if (depth > 1 || layerCount > 1 || faceCount != 1 || width == 0 || height == 0) {
+            throw std::runtime_error("failed to read KTX2 file " + name + ", only single 2D images are supported!");
+        }
+        if (supercompressionScheme != 0) {
+            throw std::runtime_error("failed to read KTX2 file " + name + ", supercompression is not supported!");
+        }
+        if (levelSize(format, 1, 1) == 0) {
+            throw std::runtime_error("failed to read KTX2 file " + name + ", unsupported format!");
+        }
+        if (levelCount > std::bit_width(std::max(width, height)) ||
+            bytes.size() < HEADER_SIZE + levelCount * LEVEL_INDEX_ENTRY_SIZE) {
+            throw std::runtime_error("failed to read KTX2 file " + name + ", invalid level index!");
+        }
+
+        levels.resize(levelCount);
+        for (uint32_t level = 0; level < levelCount; level++) {
+            const size_t entry = HEADER_SIZE + level * LEVEL_INDEX_ENTRY_SIZE;
+            const auto byteOffset = read<uint64_t>(bytes, entry);
+            const auto byteLength = read<uint64_t>(bytes, entry + 8);
+
+            const uint32_t levelWidth = std::max(width >> level, 1u);
+            const uint32_t levelHeight = std::max(height >> level, 1u);
+            if (byteLength != levelSize(format, levelWidth, levelHeight) || byteOffset > bytes.size() ||
+                byteLength > bytes.size() - byteOffset) {
+                throw std::runtime_error("failed to read KTX2 file " + name + ", truncated level data!");
+            }
+            levels[level] = bytes.subspan(byteOffset, byteLength);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef KTX2_FILE_H
+#define KTX2_FILE_H
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "../utils/mapped_file.h"
+
+namespace vulkr {
+    /**
+     * A KTX2 texture container holding a single 2D image with its mip chain, as written by the texture cooker.
+     * The levels are views into the file, ready to be copied into a staging buffer as they are. Only the
+     * formats TextureManager uploads are accepted (BC1, BC3, BC4, BC5, BC7 and RGBA8), without supercompression.
+     */
+    class Ktx2File {
+    public:
+        // maps the file at path for the lifetime of the object
+        explicit Ktx2File(const std::string &path);
+
+        // reads bytes in place, the caller keeps them alive
+        explicit Ktx2File(std::span<const uint8_t> bytes);
+
+        static bool isKtx2(std::span<const uint8_t> bytes);
+
+        static bool isKtx2Path(const std::string &path);
+
+        /**
+         * Size of a tightly packed level of the given dimensions, 0 if the format is not supported.
+         */
+        static VkDeviceSize levelSize(VkFormat format, uint32_t width, uint32_t height);
+
+        VkFormat getFormat() const { return format; }
+        uint32_t getWidth() const { return width; }
+        uint32_t getHeight() const { return height; }
+        uint32_t getLevelCount() const { return static_cast<uint32_t>(levels.size()); }
+
+        // level 0 is the largest
+        std::span<const uint8_t> getLevel(uint32_t level) const { return levels[level]; }
+
+    private:
+        void parse(std::span<const uint8_t> bytes, const std::string &name);
+
+        std::unique_ptr<MappedFile> file;
+
+        VkFormat format{VK_FORMAT_UNDEFINED};
+        uint32_t width{0};
+        uint32_t height{0};
+        std::vector<std::span<const uint8_t>> levels;
+    };
+}
+
+#endif //KTX2_FILE_H
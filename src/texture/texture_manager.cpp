@@ -0,0 +1,296 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "texture_manager.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+#include "../mesh/gltf_tiny/stb_image.h"
+#include "../pipeline/vulkr_buffer.h"
+#include "../utils/parallel_for.h"
+#include "../utils/utils.h"
+
+namespace vulkr {
+    namespace {
+        // block compressed copies need offsets aligned to the block size, 16 bytes covers every format
+        constexpr VkDeviceSize STAGING_ALIGNMENT = 16;
+
+        VkDeviceSize alignStaging(VkDeviceSize offset) {
+            return (offset + STAGING_ALIGNMENT - 1) & ~(STAGING_ALIGNMENT - 1);
+        }
+    }
+
+    size_t TextureManager::SamplerSettingsHash::operator()(const SamplerSettings &settings) const noexcept {
+        size_t seed = 0;
+        hashCombine(seed, settings.magFilter, settings.minFilter, settings.mipmapMode, settings.addressModeU,
+                    settings.addressModeV, settings.mipmaps);
+        return seed;
+    }
+
+    size_t TextureManager::MaterialKeyHash::operator()(
+        const std::pair<const VulkrTexture *, VkSampler> &key) const noexcept {
+        size_t seed = 0;
+        hashCombine(seed, key.first, key.second);
+        return seed;
+    }
+
+    TextureManager::TextureManager(VulkrDevice &device) : vulkrDevice{device} {
+        streamer = std::make_unique<TextureStreamer>(vulkrDevice);
+
+        materialSetLayout = VulkrDescriptorSetLayout::Builder(vulkrDevice)
+                .addBinding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT)
+                .addBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, VK_SHADER_STAGE_FRAGMENT_BIT)
+                .build();
+
+        materialPool = VulkrDescriptorPool::Builder(vulkrDevice)
+                .setMaxSets(MAX_MATERIALS)
+                .setPoolFlags(VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT)
+                .addPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_MATERIALS)
+                .addPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, MAX_MATERIALS)
+                .build();
+
+        // untextured models multiply their vertex colors by white
+        std::vector<DecodedImage> white(1);
+        white[0] = {1, 1, VK_FORMAT_R8G8B8A8_SRGB, {255, 255, 255, 255}};
+        auto texture = uploadImages(white).front();
+        defaultMaterial = createMaterial(std::move(texture), getSampler({}));
+    }
+
+    TextureManager::~TextureManager() {
+        defaultMaterial.reset();
+
+        // materials free their sets through the deletion queue, so the pool and samplers go after them
+        const uint64_t frameValue = vulkrDevice.frameTimeline().getCurrentValue();
+        VulkrDescriptorPool *pool = materialPool.release();
+        vulkrDevice.deletionQueue().retire(frameValue, [pool]() {
+            delete pool;
+        });
+
+        VkDevice vkDevice = vulkrDevice.device();
+        for (const auto &[settings, sampler]: samplers) {
+            vulkrDevice.deletionQueue().retire(frameValue, [vkDevice, sampler]() {
+                vkDestroySampler(vkDevice, sampler, nullptr);
+            });
+        }
+    }
+
+    std::vector<std::shared_ptr<VulkrTexture>> TextureManager::loadTextures(const std::vector<TextureSource> &sources) {
+        std::vector<std::shared_ptr<VulkrTexture>> result(sources.size());
+        std::erase_if(textures, [](const auto &entry) { return entry.second.expired(); });
+        std::erase_if(materials, [](const auto &entry) { return entry.second.expired(); });
+
+        // each uncached key is decoded once, even if several sources name it
+        std::vector<size_t> pending;
+        std::unordered_map<std::string, size_t> pendingOfKey;
+        std::vector<size_t> sourcePending(sources.size(), std::numeric_limits<size_t>::max());
+        for (size_t i = 0; i < sources.size(); i++) {
+            auto cached = textures.find(sources[i].key);
+            if (cached != textures.end() && (result[i] = cached->second.lock())) {
+                continue;
+            }
+            auto [it, inserted] = pendingOfKey.emplace(sources[i].key, pending.size());
+            if (inserted) {
+                pending.push_back(i);
+            }
+            sourcePending[i] = it->second;
+        }
+        if (pending.empty()) {
+            return result;
+        }
+
+        std::vector<DecodedImage> images(pending.size());
+        parallelFor(pending.size(), [&](size_t p) {
+            const TextureSource &source = sources[pending[p]];
+            DecodedImage &image = images[p];
+
+            if (source.encoded.empty() ? Ktx2File::isKtx2Path(source.key) : Ktx2File::isKtx2(source.encoded)) {
+                image.file = source.encoded.empty()
+                                 ? std::make_unique<Ktx2File>(source.key)
+                                 : std::make_unique<Ktx2File>(source.encoded);
+                image.streamable = source.encoded.empty();
+                if (!canSample(image.file->getFormat())) {
+                    throw std::runtime_error("failed to load texture " + source.key + ", unsupported format!");
+                }
+            } else if (source.encoded.empty()) {
+                // a cooked file the device can't sample falls back to decoding the original
+                std::error_code error;
+                const std::string cooked = std::filesystem::path(source.key).replace_extension(".ktx2").string();
+                if (std::filesystem::exists(cooked, error)) {
+                    auto file = std::make_unique<Ktx2File>(cooked);
+                    if (canSample(file->getFormat())) {
+                        image.file = std::move(file);
+                        image.streamable = true;
+                    }
+                }
+            }
+
+            if (image.file) {
+                image.width = image.file->getWidth();
+                image.height = image.file->getHeight();
+                image.format = image.file->getFormat();
+                return;
+            }
+
+            int width, height, channels;
+            stbi_uc *texels = source.encoded.empty()
+                                  ? stbi_load(source.key.c_str(), &width, &height, &channels, STBI_rgb_alpha)
+                                  : stbi_load_from_memory(source.encoded.data(),
+                                                          static_cast<int>(source.encoded.size()), &width, &height,
+                                                          &channels, STBI_rgb_alpha);
+            if (texels == nullptr) {
+                throw std::runtime_error("failed to decode texture " + source.key + ": " + stbi_failure_reason());
+            }
+
+            image.width = static_cast<uint32_t>(width);
+            image.height = static_cast<uint32_t>(height);
+            image.format = source.srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+            image.texels.assign(texels, texels + static_cast<size_t>(width) * height * 4);
+            stbi_image_free(texels);
+        });
+
+        const std::vector<std::shared_ptr<VulkrTexture>> uploaded = uploadImages(images);
+
+        for (size_t p = 0; p < pending.size(); p++) {
+            textures[sources[pending[p]].key] = uploaded[p];
+        }
+        for (size_t i = 0; i < sources.size(); i++) {
+            if (!result[i]) {
+                result[i] = uploaded[sourcePending[i]];
+            }
+        }
+        return result;
+    }
+
+    std::shared_ptr<VulkrTexture> TextureManager::loadTexture(const TextureSource &source) {
+        return loadTextures({source}).front();
+    }
+
+    std::vector<std::shared_ptr<VulkrTexture>> TextureManager::uploadImages(std::vector<DecodedImage> &images) {
+        // streamed images start with their tail, as long as the streamer has slots left
+        std::vector<uint32_t> residentLevels(images.size());
+        size_t freeSlots = streamer->freeSlotCount();
+        for (size_t i = 0; i < images.size(); i++) {
+            if (images[i].streamable && freeSlots > 0) {
+                residentLevels[i] = TextureStreamer::tailLevel(*images[i].file);
+                freeSlots -= residentLevels[i] > 0;
+            }
+        }
+
+        std::vector<VkDeviceSize> imageSizes(images.size());
+        for (size_t i = 0; i < images.size(); i++) {
+            for (uint32_t level = residentLevels[i]; level < images[i].levelCount(); level++) {
+                imageSizes[i] = alignStaging(imageSizes[i]) + images[i].level(level).size();
+            }
+            imageSizes[i] = alignStaging(imageSizes[i]);
+        }
+
+        std::vector<std::shared_ptr<VulkrTexture>> uploaded;
+        uploaded.reserve(images.size());
+
+        size_t batchBegin = 0;
+        while (batchBegin < images.size()) {
+            // always at least one image, an image larger than the batch gets a staging buffer of its own
+            VkDeviceSize stagingSize = imageSizes[batchBegin];
+            size_t batchEnd = batchBegin + 1;
+            while (batchEnd < images.size() && stagingSize + imageSizes[batchEnd] <= STAGING_BATCH_SIZE) {
+                stagingSize += imageSizes[batchEnd];
+                batchEnd++;
+            }
+
+            VulkrBuffer stagingBuffer{
+                vulkrDevice, stagingSize, 1, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+            };
+            stagingBuffer.map();
+
+            VkCommandBuffer commandBuffer = vulkrDevice.beginSingleTimeCommands();
+            VkDeviceSize offset = 0;
+            std::vector<VkDeviceSize> levelOffsets;
+            for (size_t i = batchBegin; i < batchEnd; i++) {
+                DecodedImage &image = images[i];
+                const uint32_t residentLevel = residentLevels[i];
+                levelOffsets.resize(image.levelCount() - residentLevel);
+                for (uint32_t level = residentLevel; level < image.levelCount(); level++) {
+                    const std::span<const uint8_t> data = image.level(level);
+                    levelOffsets[level - residentLevel] = offset;
+                    stagingBuffer.writeToBuffer(data.data(), data.size(), offset);
+                    offset = alignStaging(offset + data.size());
+                }
+
+                if (image.levelCount() == 1) {
+                    auto &texture = uploaded.emplace_back(
+                        std::make_shared<VulkrTexture>(vulkrDevice, image.width, image.height, image.format));
+                    texture->recordUpload(commandBuffer, stagingBuffer.getBuffer(), levelOffsets.front());
+                } else {
+                    auto &texture = uploaded.emplace_back(std::make_shared<VulkrTexture>(
+                        vulkrDevice, image.width, image.height, image.format, image.levelCount(), residentLevel));
+                    texture->recordUpload(commandBuffer, stagingBuffer.getBuffer(), levelOffsets);
+                    if (residentLevel > 0) {
+                        streamer->track(texture, std::move(image.file));
+                    }
+                }
+            }
+            vulkrDevice.endSingleTimeCommands(commandBuffer);
+
+            batchBegin = batchEnd;
+        }
+        return uploaded;
+    }
+
+    bool TextureManager::canSample(VkFormat format) const {
+        return vulkrDevice.supportsFormatFeatures(format, VK_IMAGE_TILING_OPTIMAL, VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT);
+    }
+
+    VkSampler TextureManager::getSampler(const SamplerSettings &settings) {
+        auto it = samplers.find(settings);
+        if (it != samplers.end()) {
+            return it->second;
+        }
+
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = settings.magFilter;
+        samplerInfo.minFilter = settings.minFilter;
+        samplerInfo.mipmapMode = settings.mipmapMode;
+        samplerInfo.addressModeU = settings.addressModeU;
+        samplerInfo.addressModeV = settings.addressModeV;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        samplerInfo.minLod = 0.0f;
+        samplerInfo.maxLod = settings.mipmaps ? VK_LOD_CLAMP_NONE : 0.0f;
+        // trilinear filtering is worth the anisotropic taps, the device is only picked if it supports them
+        samplerInfo.anisotropyEnable = settings.mipmaps && settings.minFilter == VK_FILTER_LINEAR &&
+                                       settings.mipmapMode == VK_SAMPLER_MIPMAP_MODE_LINEAR;
+        samplerInfo.maxAnisotropy = samplerInfo.anisotropyEnable
+                                        ? std::min(8.0f, vulkrDevice.properties.limits.maxSamplerAnisotropy)
+                                        : 1.0f;
+
+        VkSampler sampler;
+        if (vkCreateSampler(vulkrDevice.device(), &samplerInfo, nullptr, &sampler) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create texture sampler!");
+        }
+        samplers.emplace(settings, sampler);
+        return sampler;
+    }
+
+    std::shared_ptr<VulkrMaterial> TextureManager::createMaterial(std::shared_ptr<VulkrTexture> baseColor,
+                                                                  VkSampler sampler) {
+        const std::pair<const VulkrTexture *, VkSampler> key{baseColor.get(), sampler};
+        auto it = materials.find(key);
+        if (it != materials.end()) {
+            if (auto material = it->second.lock()) {
+                return material;
+            }
+        }
+
+        const TextureFeedback feedback = streamer->getFeedback(*baseColor);
+        auto material = std::make_shared<VulkrMaterial>(vulkrDevice, *materialSetLayout, *materialPool,
+                                                        std::move(baseColor), sampler, feedback);
+        materials[key] = material;
+        return material;
+    }
+}
@@ -0,0 +1,141 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef TEXTURE_MANAGER_H
+#define TEXTURE_MANAGER_H
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ktx2_file.h"
+#include "texture_streamer.h"
+#include "vulkr_material.h"
+#include "vulkr_texture.h"
+#include "../pipeline/vulkr_descriptors.h"
+
+namespace vulkr {
+    struct SamplerSettings {
+        VkFilter magFilter{VK_FILTER_LINEAR};
+        VkFilter minFilter{VK_FILTER_LINEAR};
+        VkSamplerMipmapMode mipmapMode{VK_SAMPLER_MIPMAP_MODE_LINEAR};
+        VkSamplerAddressMode addressModeU{VK_SAMPLER_ADDRESS_MODE_REPEAT};
+        VkSamplerAddressMode addressModeV{VK_SAMPLER_ADDRESS_MODE_REPEAT};
+        // samples mipmaps without a LOD clamp, NEAREST and LINEAR minification in glTF clamp to the top level
+        bool mipmaps{true};
+
+        bool operator==(const SamplerSettings &other) const = default;
+    };
+
+    /**
+     * An encoded image (PNG, JPEG, TGA, BMP, ...) to be decoded into a texture, or a KTX2 file cooked by the
+     * texture cooker whose levels are uploaded as they are.
+     */
+    struct TextureSource {
+        // cache key, the resolved file path, or the model file and image index for embedded images
+        std::string key;
+        // decoded from memory when set, the caller keeps it alive during loadTextures, read from key otherwise
+        std::span<const uint8_t> encoded{};
+        // color textures are sRGB encoded, data textures like normal maps are not, KTX2 files carry their format
+        bool srgb{true};
+    };
+
+    /**
+     * Loads textures and keeps one copy of each: textures are cached by their source's key as long as a
+     * material or model holds them, samplers by their settings and materials by their texture and sampler.
+     * Owns the material set layout of the scene pipelines and a white default material for untextured models.
+     * Cooked KTX2 files read from disk are handed to the texture streamer with only their low levels resident.
+     */
+    class TextureManager {
+    public:
+        static constexpr uint32_t MAX_MATERIALS = 4096;
+        // decoded texels staged per upload submission, larger batches are split
+        static constexpr VkDeviceSize STAGING_BATCH_SIZE = 64 * 1024 * 1024;
+
+        explicit TextureManager(VulkrDevice &device);
+
+        ~TextureManager();
+
+        TextureManager(const TextureManager &) = delete;
+
+        TextureManager &operator=(const TextureManager &) = delete;
+
+        /**
+         * Returns a texture per source, indexed like sources. Sources that are not cached are decoded on all
+         * cores at once, then uploaded through staging buffers with their mip chains generated on the GPU.
+         * KTX2 sources skip both, their block compressed levels are copied straight into the image. A file
+         * source is replaced by a cooked .ktx2 file of the same name next to it if the device can sample it.
+         * Cooked files read from disk start with their tail resident and stream their finer levels on demand.
+         */
+        std::vector<std::shared_ptr<VulkrTexture>> loadTextures(const std::vector<TextureSource> &sources);
+
+        std::shared_ptr<VulkrTexture> loadTexture(const TextureSource &source);
+
+        VkSampler getSampler(const SamplerSettings &settings);
+
+        std::shared_ptr<VulkrMaterial> createMaterial(std::shared_ptr<VulkrTexture> baseColor, VkSampler sampler);
+
+        const std::shared_ptr<VulkrMaterial> &getDefaultMaterial() const { return defaultMaterial; }
+
+        VkDescriptorSetLayout getMaterialSetLayout() const { return materialSetLayout->getDescriptorSetLayout(); }
+
+        TextureStreamer &getStreamer() { return *streamer; }
+
+    private:
+        struct DecodedImage {
+            uint32_t width{0};
+            uint32_t height{0};
+            VkFormat format{VK_FORMAT_UNDEFINED};
+            // RGBA8 texels of the top level
+            std::vector<uint8_t> texels;
+            // the cooked levels, used instead of texels when set
+            std::unique_ptr<Ktx2File> file;
+            // the file was opened from disk and stays readable, so its levels can be streamed
+            bool streamable{false};
+
+            uint32_t levelCount() const { return file ? file->getLevelCount() : 1; }
+
+            std::span<const uint8_t> level(uint32_t index) const {
+                return file ? file->getLevel(index) : std::span<const uint8_t>{texels};
+            }
+        };
+
+        struct SamplerSettingsHash {
+            size_t operator()(const SamplerSettings &settings) const noexcept;
+        };
+
+        struct MaterialKeyHash {
+            size_t operator()(const std::pair<const VulkrTexture *, VkSampler> &key) const noexcept;
+        };
+
+        /**
+         * Creates a texture per image and uploads them in batches of about STAGING_BATCH_SIZE. Images with a
+         * single level get their chain generated, the others are uploaded level by level. Streamable images
+         * only upload their tail and pass their file on to the streamer.
+         */
+        std::vector<std::shared_ptr<VulkrTexture>> uploadImages(std::vector<DecodedImage> &images);
+
+        bool canSample(VkFormat format) const;
+
+        VulkrDevice &vulkrDevice;
+
+        std::unique_ptr<TextureStreamer> streamer;
+        std::unique_ptr<VulkrDescriptorSetLayout> materialSetLayout;
+        std::unique_ptr<VulkrDescriptorPool> materialPool;
+
+        std::unordered_map<std::string, std::weak_ptr<VulkrTexture>> textures;
+        std::unordered_map<SamplerSettings, VkSampler, SamplerSettingsHash> samplers;
+        // a material holds its texture, so a live entry's texture pointer can't have been reused
+        std::unordered_map<std::pair<const VulkrTexture *, VkSampler>, std::weak_ptr<VulkrMaterial>, MaterialKeyHash>
+        materials;
+
+        std::shared_ptr<VulkrMaterial> defaultMaterial;
+    };
+}
+
+#endif //TEXTURE_MANAGER_H
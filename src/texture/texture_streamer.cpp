@@ -0,0 +1,313 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "texture_streamer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include "../pipeline/vulkr_swap_chain.hpp"
+
+namespace vulkr {
+    TextureStreamer::TextureStreamer(VulkrDevice &device)
+        : vulkrDevice{device}, entries(MAX_STREAMED_TEXTURES + 1) {
+        // counters are bound at descriptor and dynamic offsets, both must be multiples of this alignment
+        slotStride = std::max<VkDeviceSize>(sizeof(uint32_t),
+                                            vulkrDevice.properties.limits.minStorageBufferOffsetAlignment);
+        frameStride = slotStride * entries.size();
+
+        // the host reads every counter each frame, cached memory keeps that cheap where the device has it
+        VkMemoryPropertyFlags memoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                 VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        uint32_t typeIndex;
+        if (vulkrDevice.tryFindMemoryType(~0u, memoryProperties | VK_MEMORY_PROPERTY_HOST_CACHED_BIT, typeIndex)) {
+            memoryProperties |= VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+        }
+        feedbackBuffer = std::make_unique<VulkrBuffer>(vulkrDevice, frameStride, VulkrSwapChain::MAX_FRAMES_IN_FLIGHT,
+                                                       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, memoryProperties);
+        feedbackBuffer->map();
+        std::memset(feedbackBuffer->getMappedMemory(), 0, feedbackBuffer->getBufferSize());
+
+        freeSlots.reserve(MAX_STREAMED_TEXTURES);
+        for (uint32_t slot = MAX_STREAMED_TEXTURES; slot > 0; slot--) {
+            freeSlots.push_back(slot);
+        }
+
+        for (uint32_t i = 0; i < WORKER_COUNT; i++) {
+            workers.emplace_back([this](std::stop_token stopToken) { workerLoop(stopToken); });
+        }
+    }
+
+    TextureStreamer::~TextureStreamer() {
+        // joins the workers, loads they didn't get to release their staging buffers through the deletion queue
+        workers.clear();
+    }
+
+    uint32_t TextureStreamer::tailLevel(const Ktx2File &file) {
+        uint32_t level = 0;
+        while (level + 1 < file.getLevelCount() &&
+               std::max(file.getWidth() >> level, file.getHeight() >> level) > TAIL_SIZE) {
+            level++;
+        }
+        return level;
+    }
+
+    void TextureStreamer::track(const std::shared_ptr<VulkrTexture> &texture, std::unique_ptr<Ktx2File> file) {
+        if (freeSlots.empty()) {
+            throw std::runtime_error("failed to stream texture, too many streamed textures!");
+        }
+        const uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+
+        Entry &entry = entries[slot];
+        entry = {};
+        entry.texture = texture;
+        entry.key = texture.get();
+        entry.file = std::move(file);
+        entry.tailLevel = texture->getResidentLevel();
+        entry.wantedLevel = entry.tailLevel;
+        entry.active = true;
+        slotOfTexture[texture.get()] = slot;
+    }
+
+    TextureFeedback TextureStreamer::getFeedback(const VulkrTexture &texture) const {
+        auto it = slotOfTexture.find(&texture);
+        const uint32_t slot = it != slotOfTexture.end() ? it->second : 0;
+        return {feedbackBuffer->getBuffer(), slot * slotStride, frameStride};
+    }
+
+    void TextureStreamer::update(VkCommandBuffer commandBuffer, int frameIndex) {
+        frameCounter++;
+        readFeedback(frameIndex);
+        finishLoads(commandBuffer);
+        releaseExpired();
+
+        VkDeviceSize residentBytes = getResidentBytes();
+        const VkDeviceSize budget = currentBudget(residentBytes);
+        evict(commandBuffer, budget, residentBytes);
+        queueLoads(budget, residentBytes);
+    }
+
+    void TextureStreamer::endFrame(VkCommandBuffer commandBuffer) {
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+                             1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    VkDeviceSize TextureStreamer::getResidentBytes() const {
+        VkDeviceSize bytes = 0;
+        for (const Entry &entry: entries) {
+            if (!entry.active) continue;
+            if (auto texture = entry.texture.lock()) {
+                bytes += texture->getMemorySize();
+            }
+        }
+        return bytes;
+    }
+
+    void TextureStreamer::workerLoop(std::stop_token stopToken) {
+        while (true) {
+            std::unique_ptr<Load> load;
+            {
+                std::unique_lock lock(mutex);
+                if (!wake.wait(lock, stopToken, [this] { return !queuedLoads.empty(); })) {
+                    return;
+                }
+                load = std::move(queuedLoads.front());
+                queuedLoads.pop_front();
+            }
+
+            // reading the level faults its pages in from disk, off the render thread
+            const std::span<const uint8_t> level = load->file->getLevel(load->level);
+            load->staging->writeToBuffer(level.data(), level.size());
+
+            std::lock_guard lock(mutex);
+            finishedLoads.push_back(std::move(load));
+        }
+    }
+
+    void TextureStreamer::readFeedback(int frameIndex) {
+        // the frame that last used this index has completed, its counters are final
+        auto *counters = static_cast<uint8_t *>(feedbackBuffer->getMappedMemory()) + frameIndex * frameStride;
+        for (uint32_t slot = 1; slot < entries.size(); slot++) {
+            Entry &entry = entries[slot];
+            if (!entry.active) continue;
+
+            auto *counter = reinterpret_cast<uint32_t *>(counters + slot * slotStride);
+            const uint32_t value = *counter;
+            if (value == 0) {
+                if (frameCounter - entry.lastSeenFrame > settings.idleFrames) {
+                    entry.wantedLevel = entry.tailLevel;
+                }
+                continue;
+            }
+            *counter = 0;
+
+            auto texture = entry.texture.lock();
+            if (!texture) continue;
+
+            // the counter holds 1 + 256 * -log2 of the smallest UV footprint of a pixel the texture covered
+            const float density = static_cast<float>(value - 1) / 256.0f;
+            const float size = static_cast<float>(std::max(texture->getWidth(), texture->getHeight()));
+            const float lod = std::floor(std::log2(size) - density + settings.lodBias);
+            entry.wantedLevel = static_cast<uint32_t>(std::clamp(lod, 0.0f, static_cast<float>(entry.tailLevel)));
+            entry.lastSeenFrame = frameCounter;
+        }
+    }
+
+    void TextureStreamer::releaseExpired() {
+        for (uint32_t slot = 1; slot < entries.size(); slot++) {
+            Entry &entry = entries[slot];
+            if (!entry.active || entry.loading || !entry.texture.expired()) continue;
+
+            // a new texture may have been tracked at the same address already
+            auto it = slotOfTexture.find(entry.key);
+            if (it != slotOfTexture.end() && it->second == slot) {
+                slotOfTexture.erase(it);
+            }
+            entry = {};
+            freeSlots.push_back(slot);
+        }
+    }
+
+    void TextureStreamer::finishLoads(VkCommandBuffer commandBuffer) {
+        std::vector<std::unique_ptr<Load>> loads;
+        {
+            std::lock_guard lock(mutex);
+            loads.swap(finishedLoads);
+        }
+
+        for (const auto &load: loads) {
+            Entry &entry = entries[load->slot];
+            entry.loading = false;
+            stagingBytes -= load->staging->getBufferSize();
+
+            auto texture = entry.texture.lock();
+            if (!texture) continue;
+
+            const VkDeviceSize offset = 0;
+            try {
+                texture->recordResidencyChange(commandBuffer, load->level, load->staging->getBuffer(), {&offset, 1});
+            } catch (const std::runtime_error &) {
+                // out of device memory, stream no further than what fits now
+                allocationLimit = getResidentBytes();
+            }
+        }
+        // the staging buffers are retired with the frame that copies from them
+    }
+
+    VkDeviceSize TextureStreamer::currentBudget(VkDeviceSize residentBytes) const {
+        VkDeviceSize budget = std::min(settings.budget, allocationLimit);
+        if (vulkrDevice.supportsMemoryBudget()) {
+            const MemoryBudget heap = vulkrDevice.getDeviceLocalMemoryBudget();
+            const auto allowed = static_cast<VkDeviceSize>(static_cast<double>(heap.budget) *
+                                                           settings.heapBudgetFraction);
+            // the process' usage includes the streamed textures, only what is left may be added to them
+            const VkDeviceSize available = allowed > heap.usage ? allowed - heap.usage : 0;
+            budget = std::min(budget, residentBytes + available);
+        }
+        return budget;
+    }
+
+    void TextureStreamer::evict(VkCommandBuffer commandBuffer, VkDeviceSize budget, VkDeviceSize &residentBytes) {
+        if (residentBytes + stagingBytes <= budget) return;
+
+        std::vector<uint32_t> candidates;
+        for (uint32_t slot = 1; slot < entries.size(); slot++) {
+            const Entry &entry = entries[slot];
+            if (!entry.active || entry.loading) continue;
+            auto texture = entry.texture.lock();
+            if (texture && texture->getResidentLevel() < entry.tailLevel) {
+                candidates.push_back(slot);
+            }
+        }
+
+        // levels finer than wanted go first, then those of the textures unseen the longest
+        auto overResident = [this](uint32_t slot) {
+            return entries[slot].texture.lock()->getResidentLevel() < entries[slot].wantedLevel;
+        };
+        std::sort(candidates.begin(), candidates.end(), [&](uint32_t a, uint32_t b) {
+            const bool overA = overResident(a);
+            const bool overB = overResident(b);
+            if (overA != overB) return overA;
+            return entries[a].lastSeenFrame < entries[b].lastSeenFrame;
+        });
+
+        for (uint32_t slot: candidates) {
+            if (residentBytes + stagingBytes <= budget) break;
+
+            const Entry &entry = entries[slot];
+            auto texture = entry.texture.lock();
+            const uint32_t level = texture->getResidentLevel() < entry.wantedLevel
+                                       ? entry.wantedLevel
+                                       : texture->getResidentLevel() + 1;
+            const VkDeviceSize before = texture->getMemorySize();
+            try {
+                texture->recordResidencyChange(commandBuffer, level, VK_NULL_HANDLE, {});
+            } catch (const std::runtime_error &) {
+                continue;
+            }
+            residentBytes = residentBytes - before + texture->getMemorySize();
+        }
+    }
+
+    void TextureStreamer::queueLoads(VkDeviceSize budget, VkDeviceSize residentBytes) {
+        std::vector<uint32_t> candidates;
+        for (uint32_t slot = 1; slot < entries.size(); slot++) {
+            const Entry &entry = entries[slot];
+            if (!entry.active || entry.loading) continue;
+            auto texture = entry.texture.lock();
+            if (texture && texture->getResidentLevel() > entry.wantedLevel) {
+                candidates.push_back(slot);
+            }
+        }
+
+        // the most recently seen textures first, the blurriest of them first
+        auto missingLevels = [this](uint32_t slot) {
+            return entries[slot].texture.lock()->getResidentLevel() - entries[slot].wantedLevel;
+        };
+        std::sort(candidates.begin(), candidates.end(), [&](uint32_t a, uint32_t b) {
+            if (entries[a].lastSeenFrame != entries[b].lastSeenFrame) {
+                return entries[a].lastSeenFrame > entries[b].lastSeenFrame;
+            }
+            return missingLevels(a) > missingLevels(b);
+        });
+
+        bool queued = false;
+        for (uint32_t slot: candidates) {
+            Entry &entry = entries[slot];
+            const uint32_t level = entry.texture.lock()->getResidentLevel() - 1;
+            const VkDeviceSize levelBytes = entry.file->getLevel(level).size();
+            if (stagingBytes > 0 && stagingBytes + levelBytes > settings.maxStagingBytes) break;
+            // the texture's new image adds about the level to what it holds now
+            if (residentBytes + stagingBytes + levelBytes > budget) continue;
+
+            auto load = std::make_unique<Load>();
+            load->slot = slot;
+            load->level = level;
+            load->file = entry.file;
+            load->staging = std::make_unique<VulkrBuffer>(
+                vulkrDevice, levelBytes, 1, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+            load->staging->map();
+
+            entry.loading = true;
+            stagingBytes += load->staging->getBufferSize();
+            {
+                std::lock_guard lock(mutex);
+                queuedLoads.push_back(std::move(load));
+            }
+            queued = true;
+        }
+
+        if (queued) {
+            wake.notify_all();
+        }
+    }
+}
@@ -0,0 +1,162 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef TEXTURE_STREAMER_H
+#define TEXTURE_STREAMER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ktx2_file.h"
+#include "vulkr_texture.h"
+#include "../pipeline/vulkr_buffer.h"
+
+namespace vulkr {
+    struct TextureStreamingSettings {
+        // device memory all streamed textures may occupy, their always resident tails included
+        VkDeviceSize budget{512ull * 1024 * 1024};
+        // share of the device local budget reported by VK_EXT_memory_budget the whole process may fill
+        float heapBudgetFraction{0.8f};
+        // added to the level the feedback asks for, positive values trade sharpness for memory
+        float lodBias{0.0f};
+        // frames without feedback before a texture only wants its tail
+        uint32_t idleFrames{120};
+        // staging memory of level loads in flight
+        VkDeviceSize maxStagingBytes{64ull * 1024 * 1024};
+    };
+
+    /**
+     * Where a material's fragment shader writes the feedback of its texture: one counter per streamed texture
+     * in a buffer with a copy per frame in flight, picked with a dynamic offset of frameIndex * frameStride.
+     */
+    struct TextureFeedback {
+        VkBuffer buffer{VK_NULL_HANDLE};
+        VkDeviceSize offset{0};
+        VkDeviceSize frameStride{0};
+    };
+
+    /**
+     * Keeps the mip levels of cooked KTX2 textures resident as far as the screen needs them and the memory
+     * budget allows. Textures start with their tail, the levels up to TAIL_SIZE, and never drop below it.
+     *
+     * While drawing, simple_shader.frag records the finest UV density each texture is sampled at. Once the
+     * frame has completed, that gives the level each texture needs. Missing levels are read from the file by
+     * worker threads into staging buffers, one level at a time, finest needed last. When the budget is
+     * exceeded, levels nobody needs go first, then those of the textures unseen the longest.
+     */
+    class TextureStreamer {
+    public:
+        static constexpr uint32_t MAX_STREAMED_TEXTURES = 4096;
+        // levels up to this size are loaded with the texture and stay resident
+        static constexpr uint32_t TAIL_SIZE = 64;
+        static constexpr uint32_t WORKER_COUNT = 2;
+
+        explicit TextureStreamer(VulkrDevice &device);
+
+        ~TextureStreamer();
+
+        TextureStreamer(const TextureStreamer &) = delete;
+
+        TextureStreamer &operator=(const TextureStreamer &) = delete;
+
+        /**
+         * First level of the file's tail, 0 if the whole file fits in it and there is nothing to stream.
+         */
+        static uint32_t tailLevel(const Ktx2File &file);
+
+        /**
+         * Streams the levels of a texture created with its tail resident from file, while the texture lives.
+         */
+        void track(const std::shared_ptr<VulkrTexture> &texture, std::unique_ptr<Ktx2File> file);
+
+        /**
+         * The counter of a tracked texture, a shared one nobody reads for every other texture.
+         */
+        TextureFeedback getFeedback(const VulkrTexture &texture) const;
+
+        /**
+         * Reads the feedback of the frame that last used frameIndex, records the finished loads and evictions
+         * into commandBuffer and queues new loads. Call after beginFrame, before anything is drawn.
+         */
+        void update(VkCommandBuffer commandBuffer, int frameIndex);
+
+        /**
+         * Makes the frame's feedback visible to the host, call after the last draw.
+         */
+        void endFrame(VkCommandBuffer commandBuffer);
+
+        VkDeviceSize getResidentBytes() const;
+
+        size_t freeSlotCount() const { return freeSlots.size(); }
+
+        TextureStreamingSettings settings;
+
+    private:
+        struct Entry {
+            std::weak_ptr<VulkrTexture> texture;
+            // the texture's slotOfTexture key, still known once it has expired
+            const VulkrTexture *key{nullptr};
+            // shared with the loads in flight
+            std::shared_ptr<Ktx2File> file;
+            uint32_t tailLevel{0};
+            uint32_t wantedLevel{0};
+            uint64_t lastSeenFrame{0};
+            bool active{false};
+            bool loading{false};
+        };
+
+        struct Load {
+            uint32_t slot;
+            // the texture's new resident level, the only level read
+            uint32_t level;
+            std::shared_ptr<Ktx2File> file;
+            std::unique_ptr<VulkrBuffer> staging;
+        };
+
+        void workerLoop(std::stop_token stopToken);
+
+        void readFeedback(int frameIndex);
+
+        void releaseExpired();
+
+        void finishLoads(VkCommandBuffer commandBuffer);
+
+        VkDeviceSize currentBudget(VkDeviceSize residentBytes) const;
+
+        void evict(VkCommandBuffer commandBuffer, VkDeviceSize budget, VkDeviceSize &residentBytes);
+
+        void queueLoads(VkDeviceSize budget, VkDeviceSize residentBytes);
+
+        VulkrDevice &vulkrDevice;
+
+        std::unique_ptr<VulkrBuffer> feedbackBuffer;
+        VkDeviceSize slotStride{0};
+        VkDeviceSize frameStride{0};
+
+        // slot 0 is the shared counter of untracked textures
+        std::vector<Entry> entries;
+        std::vector<uint32_t> freeSlots;
+        std::unordered_map<const VulkrTexture *, uint32_t> slotOfTexture;
+        uint64_t frameCounter{0};
+        // an allocation failure caps the budget at what was resident then
+        VkDeviceSize allocationLimit{~0ull};
+        VkDeviceSize stagingBytes{0};
+
+        std::mutex mutex;
+        std::condition_variable_any wake;
+        std::deque<std::unique_ptr<Load>> queuedLoads;
+        std::vector<std::unique_ptr<Load>> finishedLoads;
+        // last, the workers stop before the loads they use are destroyed
+        std::vector<std::jthread> workers;
+    };
+}
+
+#endif //TEXTURE_STREAMER_H
@@ -0,0 +1,66 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "vulkr_material.h"
+
+#include <stdexcept>
+#include <vector>
+
+namespace vulkr {
+    VulkrMaterial::VulkrMaterial(VulkrDevice &device, VulkrDescriptorSetLayout &setLayout, VulkrDescriptorPool &pool,
+                                 std::shared_ptr<VulkrTexture> baseColor, VkSampler sampler, TextureFeedback feedback)
+        : vulkrDevice{device}, descriptorSetLayout{setLayout}, descriptorPool{pool}, baseColor{std::move(baseColor)},
+          sampler{sampler}, feedback{feedback} {
+        writeDescriptorSet();
+    }
+
+    VulkrMaterial::~VulkrMaterial() {
+        retireDescriptorSet();
+    }
+
+    void VulkrMaterial::writeDescriptorSet() {
+        VkDescriptorImageInfo imageInfo{};
+        imageInfo.sampler = sampler;
+        imageInfo.imageView = baseColor->getImageView();
+        imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        // the frame's copy of the counter is selected by the dynamic offset in bind
+        VkDescriptorBufferInfo feedbackInfo{};
+        feedbackInfo.buffer = feedback.buffer;
+        feedbackInfo.offset = feedback.offset;
+        feedbackInfo.range = sizeof(uint32_t);
+
+        if (!VulkrDescriptorWriter(descriptorSetLayout, descriptorPool)
+                .writeImage(0, &imageInfo)
+                .writeBuffer(1, &feedbackInfo)
+                .build(descriptorSet)) {
+            throw std::runtime_error("failed to allocate material descriptor set!");
+        }
+        writtenImageView = imageInfo.imageView;
+    }
+
+    void VulkrMaterial::retireDescriptorSet() {
+        VulkrDescriptorPool *pool = &descriptorPool;
+        VkDescriptorSet set = descriptorSet;
+        vulkrDevice.deletionQueue().retire(lastUsedFrameValue, [pool, set]() {
+            std::vector<VkDescriptorSet> sets{set};
+            pool->freeDescriptors(sets);
+        });
+    }
+
+    void VulkrMaterial::bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t set,
+                             int frameIndex) {
+        // frames in flight may still use the old set, it is replaced rather than updated
+        if (baseColor->getImageView() != writtenImageView) {
+            retireDescriptorSet();
+            writeDescriptorSet();
+        }
+
+        lastUsedFrameValue = vulkrDevice.frameTimeline().getCurrentValue();
+        baseColor->markUsed(lastUsedFrameValue);
+        const auto dynamicOffset = static_cast<uint32_t>(frameIndex * feedback.frameStride);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, set, 1,
+                                &descriptorSet, 1, &dynamicOffset);
+    }
+}
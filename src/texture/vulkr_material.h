@@ -0,0 +1,59 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef VULKR_MATERIAL_H
+#define VULKR_MATERIAL_H
+
+#include <memory>
+
+#include "texture_streamer.h"
+#include "vulkr_texture.h"
+#include "../pipeline/vulkr_descriptors.h"
+
+namespace vulkr {
+    /**
+     * The material descriptor set (set 2 of the scene pipelines): the base color texture and its sampler, and
+     * the texture's streaming feedback counter. Created and shared through TextureManager::createMaterial, which
+     * must outlive its materials.
+     */
+    class VulkrMaterial {
+    public:
+        VulkrMaterial(VulkrDevice &device, VulkrDescriptorSetLayout &setLayout, VulkrDescriptorPool &pool,
+                      std::shared_ptr<VulkrTexture> baseColor, VkSampler sampler, TextureFeedback feedback);
+
+        ~VulkrMaterial();
+
+        VulkrMaterial(const VulkrMaterial &) = delete;
+
+        VulkrMaterial &operator=(const VulkrMaterial &) = delete;
+
+        /**
+         * Binds the set with the feedback counter of frameIndex. The set is rewritten first when streaming has
+         * replaced the base color's image since the last bind.
+         */
+        void bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t set, int frameIndex);
+
+        const std::shared_ptr<VulkrTexture> &getBaseColor() const { return baseColor; }
+        VkSampler getSampler() const { return sampler; }
+
+    private:
+        void writeDescriptorSet();
+
+        void retireDescriptorSet();
+
+        VulkrDevice &vulkrDevice;
+        VulkrDescriptorSetLayout &descriptorSetLayout;
+        VulkrDescriptorPool &descriptorPool;
+        uint64_t lastUsedFrameValue{0};
+
+        std::shared_ptr<VulkrTexture> baseColor;
+        VkSampler sampler;
+        TextureFeedback feedback;
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        // the base color view descriptorSet was written with
+        VkImageView writtenImageView = VK_NULL_HANDLE;
+    };
+}
+
+#endif //VULKR_MATERIAL_H
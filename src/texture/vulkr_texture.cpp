@@ -0,0 +1,280 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "vulkr_texture.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <stdexcept>
+#include <vector>
+
+namespace vulkr {
+    VulkrTexture::VulkrTexture(VulkrDevice &device, uint32_t width, uint32_t height, VkFormat format)
+        : vulkrDevice{device}, width{width}, height{height}, format{format} {
+        const uint32_t maxDimension = vulkrDevice.properties.limits.maxImageDimension2D;
+        if (width == 0 || height == 0 || width > maxDimension || height > maxDimension) {
+            throw std::runtime_error("failed to create texture, unsupported size!");
+        }
+
+        // the chain is blitted with linear filtering, formats that can't do it keep only the top level
+        const bool blittable = vulkrDevice.supportsFormatFeatures(
+            format, VK_IMAGE_TILING_OPTIMAL, VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT |
+                                             VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT);
+        mipLevels = blittable ? fullMipLevels(width, height) : 1;
+        createImage();
+    }
+
+    VulkrTexture::VulkrTexture(VulkrDevice &device, uint32_t width, uint32_t height, VkFormat format,
+                               uint32_t mipLevels, uint32_t residentLevel)
+        : vulkrDevice{device}, width{width}, height{height}, mipLevels{mipLevels}, residentLevel{residentLevel},
+          format{format} {
+        const uint32_t maxDimension = vulkrDevice.properties.limits.maxImageDimension2D;
+        if (width == 0 || height == 0 || width > maxDimension || height > maxDimension) {
+            throw std::runtime_error("failed to create texture, unsupported size!");
+        }
+        if (mipLevels == 0 || mipLevels > fullMipLevels(width, height) || residentLevel >= mipLevels) {
+            throw std::runtime_error("failed to create texture, invalid mip level count!");
+        }
+
+        createImage();
+    }
+
+    void VulkrTexture::createImage() {
+        // the resident level is the image's first one, the transfer source is for blits and residency changes
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = std::max(width >> residentLevel, 1u);
+        imageInfo.extent.height = std::max(height >> residentLevel, 1u);
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = mipLevels - residentLevel;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = format;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                          VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        vulkrDevice.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, image, imageMemory);
+
+        VkMemoryRequirements memoryRequirements;
+        vkGetImageMemoryRequirements(vulkrDevice.device(), image, &memoryRequirements);
+        memorySize = memoryRequirements.size;
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = format;
+        viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, mipLevels - residentLevel, 0, 1};
+
+        if (vkCreateImageView(vulkrDevice.device(), &viewInfo, nullptr, &imageView) != VK_SUCCESS) {
+            vkDestroyImage(vulkrDevice.device(), image, nullptr);
+            vkFreeMemory(vulkrDevice.device(), imageMemory, nullptr);
+            throw std::runtime_error("failed to create texture image view!");
+        }
+    }
+
+    VulkrTexture::~VulkrTexture() {
+        vulkrDevice.deletionQueue().retireImage(image, imageView, imageMemory, lastUsedFrameValue);
+    }
+
+    uint32_t VulkrTexture::fullMipLevels(uint32_t width, uint32_t height) {
+        return static_cast<uint32_t>(std::bit_width(std::max(width, height)));
+    }
+
+    void VulkrTexture::recordUpload(VkCommandBuffer commandBuffer, VkBuffer stagingBuffer, VkDeviceSize offset) {
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = image;
+        barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, mipLevels, 0, 1};
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        VkBufferImageCopy region{};
+        region.bufferOffset = offset;
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.imageExtent = {width, height, 1};
+        vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+        // each level is read by the blit into the next one, then handed to the fragment shader
+        barrier.subresourceRange.levelCount = 1;
+        int32_t levelWidth = static_cast<int32_t>(width);
+        int32_t levelHeight = static_cast<int32_t>(height);
+        for (uint32_t level = 1; level < mipLevels; level++) {
+            barrier.subresourceRange.baseMipLevel = level - 1;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+            const int32_t nextWidth = std::max(levelWidth / 2, 1);
+            const int32_t nextHeight = std::max(levelHeight / 2, 1);
+            VkImageBlit blit{};
+            blit.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0, 1};
+            blit.srcOffsets[1] = {levelWidth, levelHeight, 1};
+            blit.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1};
+            blit.dstOffsets[1] = {nextWidth, nextHeight, 1};
+            vkCmdBlitImage(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+            levelWidth = nextWidth;
+            levelHeight = nextHeight;
+        }
+
+        barrier.subresourceRange.baseMipLevel = mipLevels - 1;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+    }
+
+    void VulkrTexture::recordUpload(VkCommandBuffer commandBuffer, VkBuffer stagingBuffer,
+                                    std::span<const VkDeviceSize> levelOffsets) {
+        const uint32_t imageLevels = mipLevels - residentLevel;
+        if (levelOffsets.size() != imageLevels) {
+            throw std::runtime_error("failed to upload texture, expected an offset per resident mip level!");
+        }
+
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = image;
+        barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, imageLevels, 0, 1};
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        // the extent of a level is in texels, partial blocks at the edges are covered by the copy
+        std::vector<VkBufferImageCopy> regions(imageLevels);
+        for (uint32_t i = 0; i < imageLevels; i++) {
+            const uint32_t level = residentLevel + i;
+            VkBufferImageCopy &region = regions[i];
+            region.bufferOffset = levelOffsets[i];
+            region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, i, 0, 1};
+            region.imageExtent = {std::max(width >> level, 1u), std::max(height >> level, 1u), 1};
+        }
+        vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               static_cast<uint32_t>(regions.size()), regions.data());
+
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+    }
+
+    void VulkrTexture::recordResidencyChange(VkCommandBuffer commandBuffer, uint32_t newResidentLevel,
+                                             VkBuffer stagingBuffer, std::span<const VkDeviceSize> levelOffsets) {
+        const uint32_t oldResidentLevel = residentLevel;
+        if (newResidentLevel >= mipLevels || newResidentLevel == oldResidentLevel) {
+            throw std::runtime_error("failed to change texture residency, invalid resident level!");
+        }
+        const uint32_t streamedLevels = oldResidentLevel > newResidentLevel ? oldResidentLevel - newResidentLevel : 0;
+        if (levelOffsets.size() != streamedLevels) {
+            throw std::runtime_error("failed to change texture residency, expected an offset per streamed level!");
+        }
+
+        VkImage oldImage = image;
+        VkImageView oldImageView = imageView;
+        VkDeviceMemory oldImageMemory = imageMemory;
+        const VkDeviceSize oldMemorySize = memorySize;
+        residentLevel = newResidentLevel;
+        try {
+            createImage();
+        } catch (...) {
+            // out of device memory leaves the texture as it was
+            image = oldImage;
+            imageView = oldImageView;
+            imageMemory = oldImageMemory;
+            memorySize = oldMemorySize;
+            residentLevel = oldResidentLevel;
+            throw;
+        }
+
+        // frames recorded before this one sample the old image, the queue orders their reads before the copy
+        std::array<VkImageMemoryBarrier, 2> barriers{};
+        for (auto &barrier: barriers) {
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        }
+        barriers[0].oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barriers[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        barriers[0].image = oldImage;
+        barriers[0].subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, mipLevels - oldResidentLevel, 0, 1};
+        barriers[0].srcAccessMask = 0;
+        barriers[0].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        barriers[1].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barriers[1].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barriers[1].image = image;
+        barriers[1].subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, mipLevels - newResidentLevel, 0, 1};
+        barriers[1].srcAccessMask = 0;
+        barriers[1].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+        const uint32_t keptLevel = std::max(oldResidentLevel, newResidentLevel);
+        std::vector<VkImageCopy> copies;
+        for (uint32_t level = keptLevel; level < mipLevels; level++) {
+            VkImageCopy &copy = copies.emplace_back();
+            copy.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - oldResidentLevel, 0, 1};
+            copy.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - newResidentLevel, 0, 1};
+            copy.extent = {std::max(width >> level, 1u), std::max(height >> level, 1u), 1};
+        }
+        vkCmdCopyImage(commandBuffer, oldImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image,
+                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(copies.size()), copies.data());
+
+        if (streamedLevels > 0) {
+            std::vector<VkBufferImageCopy> regions(streamedLevels);
+            for (uint32_t i = 0; i < streamedLevels; i++) {
+                const uint32_t level = newResidentLevel + i;
+                VkBufferImageCopy &region = regions[i];
+                region.bufferOffset = levelOffsets[i];
+                region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, i, 0, 1};
+                region.imageExtent = {std::max(width >> level, 1u), std::max(height >> level, 1u), 1};
+            }
+            vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                   static_cast<uint32_t>(regions.size()), regions.data());
+        }
+
+        VkImageMemoryBarrier &barrier = barriers[1];
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        // the copy above is the old image's last use
+        vulkrDevice.deletionQueue().retireImage(oldImage, oldImageView, oldImageMemory,
+                                                std::max(lastUsedFrameValue,
+                                                         vulkrDevice.frameTimeline().getCurrentValue()));
+    }
+}
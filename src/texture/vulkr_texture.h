@@ -0,0 +1,100 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef VULKR_TEXTURE_H
+#define VULKR_TEXTURE_H
+
+#include <cstdint>
+#include <span>
+
+#include "../pipeline/vulkr_device.hpp"
+
+namespace vulkr {
+    /**
+     * A sampled 2D image with its mip chain and the view over all of it. Either the top level is copied from a
+     * staging buffer and every smaller level is blitted down from the one above on the GPU, or every level is
+     * copied as it is, for block compressed images cooked offline, see recordUpload.
+     *
+     * A streamed texture only holds the levels from its resident level down. Changing the resident level
+     * moves the image to a new one and changes the image view, see recordResidencyChange.
+     */
+    class VulkrTexture {
+    public:
+        /**
+         * Creates the image with the full mip chain if the format supports linear blits, a single level otherwise.
+         */
+        VulkrTexture(VulkrDevice &device, uint32_t width, uint32_t height, VkFormat format);
+
+        /**
+         * Creates the image for a chain of exactly mipLevels levels holding the ones from residentLevel down,
+         * all of them uploaded from the staging buffer.
+         */
+        VulkrTexture(VulkrDevice &device, uint32_t width, uint32_t height, VkFormat format, uint32_t mipLevels,
+                     uint32_t residentLevel = 0);
+
+        ~VulkrTexture();
+
+        VulkrTexture(const VulkrTexture &) = delete;
+
+        VulkrTexture &operator=(const VulkrTexture &) = delete;
+
+        /**
+         * Records the copy of the top level from tightly packed texels at offset in stagingBuffer, the mip
+         * chain's generation and the transition of every level to SHADER_READ_ONLY_OPTIMAL for fragment shaders.
+         */
+        void recordUpload(VkCommandBuffer commandBuffer, VkBuffer stagingBuffer, VkDeviceSize offset);
+
+        /**
+         * Records the copy of every resident level from tightly packed data at levelOffsets in stagingBuffer, one
+         * offset per level starting with the resident one, and the transition of all of them to
+         * SHADER_READ_ONLY_OPTIMAL.
+         */
+        void recordUpload(VkCommandBuffer commandBuffer, VkBuffer stagingBuffer,
+                          std::span<const VkDeviceSize> levelOffsets);
+
+        /**
+         * Records the move to a new image holding the levels from newResidentLevel down. Levels both images
+         * hold are copied on the GPU, levels above the current resident one come from levelOffsets in
+         * stagingBuffer like in recordUpload, no offsets are needed to drop levels. The current image is
+         * retired after the frame being recorded, materials pick up the new view when they are next bound.
+         */
+        void recordResidencyChange(VkCommandBuffer commandBuffer, uint32_t newResidentLevel, VkBuffer stagingBuffer,
+                                   std::span<const VkDeviceSize> levelOffsets);
+
+        /**
+         * Keeps the image alive until frameValue has completed on the frame timeline.
+         */
+        void markUsed(uint64_t frameValue) { lastUsedFrameValue = frameValue; }
+
+        VkImageView getImageView() const { return imageView; }
+        VkFormat getFormat() const { return format; }
+        uint32_t getWidth() const { return width; }
+        uint32_t getHeight() const { return height; }
+        uint32_t getMipLevels() const { return mipLevels; }
+        uint32_t getResidentLevel() const { return residentLevel; }
+        // size of the image's memory allocation
+        VkDeviceSize getMemorySize() const { return memorySize; }
+
+        static uint32_t fullMipLevels(uint32_t width, uint32_t height);
+
+    private:
+        void createImage();
+
+        VulkrDevice &vulkrDevice;
+        uint64_t lastUsedFrameValue{0};
+
+        uint32_t width;
+        uint32_t height;
+        uint32_t mipLevels;
+        uint32_t residentLevel{0};
+        VkFormat format;
+        VkDeviceSize memorySize{0};
+
+        VkImage image = VK_NULL_HANDLE;
+        VkDeviceMemory imageMemory = VK_NULL_HANDLE;
+        VkImageView imageView = VK_NULL_HANDLE;
+    };
+}
+
+#endif //VULKR_TEXTURE_H
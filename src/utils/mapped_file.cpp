@@ -0,0 +1,89 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "mapped_file.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vulkr {
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string &path) {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("failed to open file: " + path);
+        }
+
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize)) {
+            CloseHandle(file);
+            throw std::runtime_error("failed to get file size: " + path);
+        }
+        size = static_cast<size_t>(fileSize.QuadPart);
+
+        // an empty file cannot be mapped, it is an empty view
+        if (size > 0) {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping != nullptr) {
+                data = static_cast<const uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            }
+        }
+        // the mapping keeps the file open
+        CloseHandle(file);
+
+        if (size > 0 && data == nullptr) {
+            if (mapping != nullptr) CloseHandle(mapping);
+            throw std::runtime_error("failed to map file: " + path);
+        }
+    }
+
+    MappedFile::~MappedFile() {
+        if (data != nullptr) UnmapViewOfFile(data);
+        if (mapping != nullptr) CloseHandle(mapping);
+    }
+#else
+    MappedFile::MappedFile(const std::string &path) {
+        const int file = open(path.c_str(), O_RDONLY);
+        if (file < 0) {
+            throw std::runtime_error("failed to open file: " + path);
+        }
+
+        struct stat fileStat{};
+        if (fstat(file, &fileStat) != 0) {
+            close(file);
+            throw std::runtime_error("failed to get file size: " + path);
+        }
+        size = static_cast<size_t>(fileStat.st_size);
+
+        // an empty file cannot be mapped, it is an empty view
+        if (size > 0) {
+            void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+            if (mapped == MAP_FAILED) {
+                close(file);
+                throw std::runtime_error("failed to map file: " + path);
+            }
+            data = static_cast<const uint8_t *>(mapped);
+            // the loaders mostly stream through the file front to back
+            madvise(mapped, size, MADV_SEQUENTIAL);
+        }
+        // the mapping keeps the file open
+        close(file);
+    }
+
+    MappedFile::~MappedFile() {
+        if (data != nullptr) munmap(const_cast<uint8_t *>(data), size);
+    }
+#endif
+}
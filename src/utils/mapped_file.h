@@ -0,0 +1,38 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace vulkr {
+    /**
+     * A read-only memory mapping of a whole file. Reads are served from the page cache, so large assets can
+     * be parsed in place without a heap copy.
+     */
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string &path);
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        std::span<const uint8_t> getData() const { return {data, size}; }
+
+    private:
+        const uint8_t *data{nullptr};
+        size_t size{0};
+#ifdef _WIN32
+        void *mapping{nullptr};
+#endif
+    };
+}
+
+#endif //MAPPED_FILE_H
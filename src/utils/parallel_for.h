@@ -0,0 +1,53 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace vulkr {
+    /**
+     * Calls job(i) for every i in [0, count) on up to hardware_concurrency threads, the calling thread included,
+     * and returns once all are done. Workers pull the next index as they finish one, so jobs of very different
+     * cost still spread evenly. The first exception thrown by a job, in index order, is rethrown afterwards.
+     */
+    template<typename Job>
+    void parallelFor(size_t count, Job &&job) {
+        if (count == 0) return;
+
+        std::atomic<size_t> next{0};
+        std::vector<std::exception_ptr> errors(count);
+        const auto work = [&]() {
+            for (size_t i = next++; i < count; i = next++) {
+                try {
+                    job(i);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            }
+        };
+
+        const size_t workerCount = std::min<size_t>(count, std::max(1u, std::thread::hardware_concurrency()));
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(workerCount - 1);
+            for (size_t i = 1; i < workerCount; i++) {
+                workers.emplace_back(work);
+            }
+            work();
+        }
+
+        for (const auto &error: errors) {
+            if (error) std::rethrow_exception(error);
+        }
+    }
+}
+
+#endif //PARALLEL_FOR_H
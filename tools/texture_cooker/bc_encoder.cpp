@@ -0,0 +1,297 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "bc_encoder.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "../../src/utils/parallel_for.h"
+
+namespace vulkr {
+    namespace {
+        constexpr std::array<int, 16> BC7_WEIGHTS = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+        /**
+         * Endpoints of the segment along the principal axis of the block's texels that covers all of them,
+         * over the first N channels.
+         */
+        template<int N>
+        void fitEndpoints(const uint8_t *texels, std::array<float, N> &start, std::array<float, N> &end) {
+            std::array<float, N> mean{};
+            for (int i = 0; i < 16; i++) {
+                for (int c = 0; c < N; c++) mean[c] += texels[i * 4 + c];
+            }
+            for (int c = 0; c < N; c++) mean[c] /= 16.0f;
+
+            std::array<std::array<float, N>, N> covariance{};
+            for (int i = 0; i < 16; i++) {
+                for (int a = 0; a < N; a++) {
+                    for (int b = 0; b < N; b++) {
+                        covariance[a][b] += (texels[i * 4 + a] - mean[a]) * (texels[i * 4 + b] - mean[b]);
+                    }
+                }
+            }
+
+            // a few power iterations find the dominant eigenvector well enough for 16 points
+            std::array<float, N> axis;
+            axis.fill(1.0f);
+            for (int iteration = 0; iteration < 8; iteration++) {
+                std::array<float, N> next{};
+                for (int a = 0; a < N; a++) {
+                    for (int b = 0; b < N; b++) next[a] += covariance[a][b] * axis[b];
+                }
+                float length = 0.0f;
+                for (int c = 0; c < N; c++) length = std::max(length, std::fabs(next[c]));
+                if (length < 1e-6f) break;
+                for (int c = 0; c < N; c++) axis[c] = next[c] / length;
+            }
+
+            float lengthSquared = 0.0f;
+            for (int c = 0; c < N; c++) lengthSquared += axis[c] * axis[c];
+            float minT = 0.0f;
+            float maxT = 0.0f;
+            if (lengthSquared > 1e-6f) {
+                minT = std::numeric_limits<float>::max();
+                maxT = std::numeric_limits<float>::lowest();
+                for (int i = 0; i < 16; i++) {
+                    float t = 0.0f;
+                    for (int c = 0; c < N; c++) t += (texels[i * 4 + c] - mean[c]) * axis[c];
+                    t /= lengthSquared;
+                    minT = std::min(minT, t);
+                    maxT = std::max(maxT, t);
+                }
+            }
+
+            for (int c = 0; c < N; c++) {
+                start[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+                end[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+            }
+        }
+
+        void writeBits(uint8_t *block, int &position, uint32_t value, int count) {
+            for (int i = 0; i < count; i++, position++) {
+                block[position / 8] |= static_cast<uint8_t>(((value >> i) & 1) << (position % 8));
+            }
+        }
+
+        uint16_t packRgb565(const std::array<float, 3> &color) {
+            const auto r = static_cast<uint16_t>(std::lround(color[0] * 31.0f / 255.0f));
+            const auto g = static_cast<uint16_t>(std::lround(color[1] * 63.0f / 255.0f));
+            const auto b = static_cast<uint16_t>(std::lround(color[2] * 31.0f / 255.0f));
+            return static_cast<uint16_t>(r << 11 | g << 5 | b);
+        }
+
+        std::array<int, 3> unpackRgb565(uint16_t packed) {
+            const int r = packed >> 11 & 31;
+            const int g = packed >> 5 & 63;
+            const int b = packed & 31;
+            return {r << 3 | r >> 2, g << 2 | g >> 4, b << 3 | b >> 2};
+        }
+
+        /**
+         * The BC1 color block, always in four color mode since BC3 decodes it as such.
+         */
+        void encodeColor(const uint8_t *texels, uint8_t *block) {
+            std::array<float, 3> start, end;
+            fitEndpoints<3>(texels, start, end);
+            uint16_t color0 = packRgb565(end);
+            uint16_t color1 = packRgb565(start);
+            // four color mode needs color0 > color1, equal endpoints leave every index at 0
+            if (color0 < color1) std::swap(color0, color1);
+
+            std::array<std::array<int, 3>, 4> palette;
+            palette[0] = unpackRgb565(color0);
+            palette[1] = unpackRgb565(color1);
+            for (int c = 0; c < 3; c++) {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+            }
+
+            uint32_t indices = 0;
+            if (color0 != color1) {
+                for (int i = 0; i < 16; i++) {
+                    int best = 0;
+                    int bestError = std::numeric_limits<int>::max();
+                    for (int p = 0; p < 4; p++) {
+                        int error = 0;
+                        for (int c = 0; c < 3; c++) {
+                            const int d = texels[i * 4 + c] - palette[p][c];
+                            error += d * d;
+                        }
+                        if (error < bestError) {
+                            bestError = error;
+                            best = p;
+                        }
+                    }
+                    indices |= static_cast<uint32_t>(best) << (i * 2);
+                }
+            }
+
+            std::memcpy(block, &color0, 2);
+            std::memcpy(block + 2, &color1, 2);
+            std::memcpy(block + 4, &indices, 4);
+        }
+
+        /**
+         * A BC4 block of one channel, in the eight value mode.
+         */
+        void encodeChannel(const uint8_t *texels, int channel, uint8_t *block) {
+            int low = 255;
+            int high = 0;
+            for (int i = 0; i < 16; i++) {
+                low = std::min<int>(low, texels[i * 4 + channel]);
+                high = std::max<int>(high, texels[i * 4 + channel]);
+            }
+
+            std::memset(block, 0, 8);
+            block[0] = static_cast<uint8_t>(high);
+            block[1] = static_cast<uint8_t>(low);
+            if (high == low) return;
+
+            std::array<int, 8> palette{high, low};
+            for (int p = 2; p < 8; p++) {
+                palette[p] = ((8 - p) * high + (p - 1) * low) / 7;
+            }
+
+            int position = 16;
+            for (int i = 0; i < 16; i++) {
+                const int value = texels[i * 4 + channel];
+                int best = 0;
+                for (int p = 1; p < 8; p++) {
+                    if (std::abs(value - palette[p]) < std::abs(value - palette[best])) best = p;
+                }
+                writeBits(block, position, static_cast<uint32_t>(best), 3);
+            }
+        }
+
+        /**
+         * BC7 mode 6. Each p-bit combination is quantized and the one with the least error is kept.
+         */
+        void encodeBc7(const uint8_t *texels, uint8_t *block) {
+            std::array<float, 4> start, end;
+            fitEndpoints<4>(texels, start, end);
+
+            std::array<std::array<int, 4>, 2> bestEndpoints{};
+            std::array<int, 2> bestPBits{};
+            std::array<int, 16> bestIndices{};
+            int bestError = std::numeric_limits<int>::max();
+
+            for (int pBits = 0; pBits < 4; pBits++) {
+                const std::array<int, 2> p = {pBits & 1, pBits >> 1};
+                std::array<std::array<int, 4>, 2> quantized;
+                std::array<std::array<int, 4>, 2> expanded;
+                for (int c = 0; c < 4; c++) {
+                    const std::array<float, 2> values = {start[c], end[c]};
+                    for (int e = 0; e < 2; e++) {
+                        quantized[e][c] = std::clamp(static_cast<int>(std::lround((values[e] - p[e]) / 2.0f)), 0, 127);
+                        expanded[e][c] = quantized[e][c] << 1 | p[e];
+                    }
+                }
+
+                std::array<std::array<int, 4>, 16> palette;
+                for (int w = 0; w < 16; w++) {
+                    for (int c = 0; c < 4; c++) {
+                        palette[w][c] = ((64 - BC7_WEIGHTS[w]) * expanded[0][c] + BC7_WEIGHTS[w] * expanded[1][c] + 32)
+                                        >> 6;
+                    }
+                }
+
+                std::array<int, 16> indices;
+                int error = 0;
+                for (int i = 0; i < 16; i++) {
+                    int best = 0;
+                    int bestTexelError = std::numeric_limits<int>::max();
+                    for (int w = 0; w < 16; w++) {
+                        int texelError = 0;
+                        for (int c = 0; c < 4; c++) {
+                            const int d = texels[i * 4 + c] - palette[w][c];
+                            texelError += d * d;
+                        }
+                        if (texelError < bestTexelError) {
+                            bestTexelError = texelError;
+                            best = w;
+                        }
+                    }
+                    indices[i] = best;
+                    error += bestTexelError;
+                }
+
+                if (error < bestError) {
+                    bestError = error;
+                    bestEndpoints = quantized;
+                    bestPBits = p;
+                    bestIndices = indices;
+                }
+            }
+
+            // the first index is stored without its top bit, swapping the endpoints mirrors the weights
+            if (bestIndices[0] >= 8) {
+                std::swap(bestEndpoints[0], bestEndpoints[1]);
+                std::swap(bestPBits[0], bestPBits[1]);
+                for (int &index: bestIndices) index = 15 - index;
+            }
+
+            std::memset(block, 0, 16);
+            int position = 0;
+            writeBits(block, position, 1u << 6, 7);
+            for (int c = 0; c < 4; c++) {
+                writeBits(block, position, static_cast<uint32_t>(bestEndpoints[0][c]), 7);
+                writeBits(block, position, static_cast<uint32_t>(bestEndpoints[1][c]), 7);
+            }
+            writeBits(block, position, static_cast<uint32_t>(bestPBits[0]), 1);
+            writeBits(block, position, static_cast<uint32_t>(bestPBits[1]), 1);
+            writeBits(block, position, static_cast<uint32_t>(bestIndices[0]), 3);
+            for (int i = 1; i < 16; i++) {
+                writeBits(block, position, static_cast<uint32_t>(bestIndices[i]), 4);
+            }
+        }
+    }
+
+    size_t BcEncoder::blockSize(Format format) {
+        return format == Format::BC1 ? 8 : 16;
+    }
+
+    void BcEncoder::encodeBlock(Format format, const uint8_t *texels, uint8_t *block) {
+        switch (format) {
+            case Format::BC1:
+                encodeColor(texels, block);
+                break;
+            case Format::BC3:
+                encodeChannel(texels, 3, block);
+                encodeColor(texels, block + 8);
+                break;
+            case Format::BC5:
+                encodeChannel(texels, 0, block);
+                encodeChannel(texels, 1, block + 8);
+                break;
+            case Format::BC7:
+                encodeBc7(texels, block);
+                break;
+        }
+    }
+
+    std::vector<uint8_t> BcEncoder::encodeImage(Format format, const uint8_t *rgba, uint32_t width, uint32_t height) {
+        const uint32_t blocksX = (width + 3) / 4;
+        const uint32_t blocksY = (height + 3) / 4;
+        const size_t size = blockSize(format);
+        std::vector<uint8_t> blocks(static_cast<size_t>(blocksX) * blocksY * size);
+
+        parallelFor(blocksY, [&](size_t by) {
+            uint8_t texels[64];
+            for (uint32_t bx = 0; bx < blocksX; bx++) {
+                for (uint32_t i = 0; i < 16; i++) {
+                    const uint32_t x = std::min(bx * 4 + i % 4, width - 1);
+                    const uint32_t y = std::min(static_cast<uint32_t>(by) * 4 + i / 4, height - 1);
+                    std::memcpy(texels + i * 4, rgba + (static_cast<size_t>(y) * width + x) * 4, 4);
+                }
+                encodeBlock(format, texels, blocks.data() + (by * blocksX + bx) * size);
+            }
+        });
+        return blocks;
+    }
+}
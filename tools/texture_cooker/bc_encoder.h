@@ -0,0 +1,40 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef BC_ENCODER_H
+#define BC_ENCODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vulkr {
+    /**
+     * Block compression of RGBA8 images into the BC formats every desktop GPU samples natively. Endpoints are
+     * fit along the principal axis of each 4x4 block and every texel picks the closest palette entry.
+     */
+    namespace BcEncoder {
+        enum class Format {
+            BC1, // RGB, 4 bits per texel, alpha is dropped
+            BC3, // RGBA, BC1 color plus an interpolated alpha block, 8 bits per texel
+            BC5, // two independent channels (red and green), for normal maps, 8 bits per texel
+            BC7, // RGBA, mode 6 only (one subset, 7 bit endpoints with p-bits, 4 bit indices), 8 bits per texel
+        };
+
+        size_t blockSize(Format format);
+
+        /**
+         * Encodes one block of 16 RGBA8 texels in row major order.
+         */
+        void encodeBlock(Format format, const uint8_t *texels, uint8_t *block);
+
+        /**
+         * Encodes a whole image row by row of blocks on all cores. Partial blocks at the right and bottom
+         * edges repeat the last column and row.
+         */
+        std::vector<uint8_t> encodeImage(Format format, const uint8_t *rgba, uint32_t width, uint32_t height);
+    }
+}
+
+#endif //BC_ENCODER_H
@@ -0,0 +1,157 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#include "ktx2_writer.h"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace vulkr {
+    namespace {
+        constexpr std::array<uint8_t, 12> IDENTIFIER = {
+            0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+        };
+        constexpr size_t HEADER_SIZE = 80;
+        constexpr size_t LEVEL_INDEX_ENTRY_SIZE = 24;
+
+        // VkFormat values, the cooker doesn't depend on the Vulkan headers
+        constexpr uint32_t VK_FORMAT_BC1_RGB_UNORM = 131;
+        constexpr uint32_t VK_FORMAT_BC1_RGB_SRGB = 132;
+        constexpr uint32_t VK_FORMAT_BC3_UNORM = 137;
+        constexpr uint32_t VK_FORMAT_BC3_SRGB = 138;
+        constexpr uint32_t VK_FORMAT_BC5_UNORM = 141;
+        constexpr uint32_t VK_FORMAT_BC7_UNORM = 145;
+        constexpr uint32_t VK_FORMAT_BC7_SRGB = 146;
+
+        // Khronos data format descriptor values
+        constexpr uint8_t MODEL_BC1A = 128;
+        constexpr uint8_t MODEL_BC3 = 130;
+        constexpr uint8_t MODEL_BC5 = 132;
+        constexpr uint8_t MODEL_BC7 = 134;
+        constexpr uint8_t PRIMARIES_BT709 = 1;
+        constexpr uint8_t TRANSFER_LINEAR = 1;
+        constexpr uint8_t TRANSFER_SRGB = 2;
+
+        struct Sample {
+            uint16_t bitOffset;
+            uint8_t bitLength;
+            uint8_t channelType;
+        };
+
+        uint32_t vkFormat(BcEncoder::Format format, bool srgb) {
+            switch (format) {
+                case BcEncoder::Format::BC1:
+                    return srgb ? VK_FORMAT_BC1_RGB_SRGB : VK_FORMAT_BC1_RGB_UNORM;
+                case BcEncoder::Format::BC3:
+                    return srgb ? VK_FORMAT_BC3_SRGB : VK_FORMAT_BC3_UNORM;
+                case BcEncoder::Format::BC5:
+                    return VK_FORMAT_BC5_UNORM;
+                case BcEncoder::Format::BC7:
+                    return srgb ? VK_FORMAT_BC7_SRGB : VK_FORMAT_BC7_UNORM;
+            }
+            return 0;
+        }
+
+        void append(std::vector<uint8_t> &bytes, uint32_t value) {
+            const size_t offset = bytes.size();
+            bytes.resize(offset + sizeof(value));
+            std::memcpy(bytes.data() + offset, &value, sizeof(value));
+        }
+
+        /**
+         * The basic data format descriptor block of a block compressed format, with one sample per 64 bit half.
+         */
+        std::vector<uint8_t> dataFormatDescriptor(BcEncoder::Format format, bool srgb) {
+            uint8_t model = MODEL_BC1A;
+            std::vector<Sample> samples;
+            switch (format) {
+                case BcEncoder::Format::BC1:
+                    samples = {{0, 63, 0}};
+                    break;
+                case BcEncoder::Format::BC3:
+                    model = MODEL_BC3;
+                    // alpha block, then the color block, alpha is flagged linear when the color is sRGB
+                    samples = {{0, 63, static_cast<uint8_t>(15 | (srgb ? 0x10 : 0))}, {64, 63, 0}};
+                    break;
+                case BcEncoder::Format::BC5:
+                    model = MODEL_BC5;
+                    samples = {{0, 63, 0}, {64, 63, 1}};
+                    break;
+                case BcEncoder::Format::BC7:
+                    model = MODEL_BC7;
+                    samples = {{0, 127, 0}};
+                    break;
+            }
+
+            const auto blockSize = static_cast<uint32_t>(24 + 16 * samples.size());
+            std::vector<uint8_t> bytes;
+            append(bytes, 4 + blockSize);
+            // vendor KHRONOS and descriptor type BASICFORMAT are both 0
+            append(bytes, 0);
+            append(bytes, 2 | blockSize << 16);
+            append(bytes, model | PRIMARIES_BT709 << 8 | (srgb ? TRANSFER_SRGB : TRANSFER_LINEAR) << 16);
+            // 4x4x1x1 texel blocks, stored minus one
+            append(bytes, 3 | 3 << 8);
+            append(bytes, static_cast<uint32_t>(BcEncoder::blockSize(format)));
+            append(bytes, 0);
+            for (const Sample &sample: samples) {
+                append(bytes, sample.bitOffset | sample.bitLength << 16 | static_cast<uint32_t>(sample.channelType) << 24);
+                append(bytes, 0);
+                append(bytes, 0);
+                append(bytes, 0xFFFFFFFF);
+            }
+            return bytes;
+        }
+    }
+
+    void Ktx2Writer::write(const std::string &path, BcEncoder::Format format, bool srgb, uint32_t width,
+                           uint32_t height, const std::vector<std::vector<uint8_t>> &levels) {
+        const std::vector<uint8_t> dfd = dataFormatDescriptor(format, srgb);
+        const size_t dfdOffset = HEADER_SIZE + levels.size() * LEVEL_INDEX_ENTRY_SIZE;
+        const size_t alignment = BcEncoder::blockSize(format);
+
+        // level data starts after the descriptor, smallest level first, each aligned to the block size
+        std::vector<uint64_t> levelOffsets(levels.size());
+        uint64_t offset = dfdOffset + dfd.size();
+        for (size_t level = levels.size(); level-- > 0;) {
+            offset = (offset + alignment - 1) / alignment * alignment;
+            levelOffsets[level] = offset;
+            offset += levels[level].size();
+        }
+
+        std::vector<uint8_t> file(offset);
+        std::memcpy(file.data(), IDENTIFIER.data(), IDENTIFIER.size());
+        const std::array<uint32_t, 13> header = {
+            vkFormat(format, srgb),
+            1, // typeSize, 1 for block compressed formats
+            width,
+            height,
+            0, // pixelDepth
+            0, // layerCount
+            1, // faceCount
+            static_cast<uint32_t>(levels.size()),
+            0, // supercompressionScheme
+            static_cast<uint32_t>(dfdOffset),
+            static_cast<uint32_t>(dfd.size()),
+            0, // kvdByteOffset
+            0, // kvdByteLength
+        };
+        std::memcpy(file.data() + IDENTIFIER.size(), header.data(), sizeof(header));
+        // sgdByteOffset and sgdByteLength stay 0
+
+        for (size_t level = 0; level < levels.size(); level++) {
+            const std::array<uint64_t, 3> entry = {levelOffsets[level], levels[level].size(), levels[level].size()};
+            std::memcpy(file.data() + HEADER_SIZE + level * LEVEL_INDEX_ENTRY_SIZE, entry.data(), sizeof(entry));
+            std::memcpy(file.data() + levelOffsets[level], levels[level].data(), levels[level].size());
+        }
+        std::memcpy(file.data() + dfdOffset, dfd.data(), dfd.size());
+
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+        if (!stream.write(reinterpret_cast<const char *>(file.data()), static_cast<std::streamsize>(file.size()))) {
+            throw std::runtime_error("failed to write KTX2 file: " + path);
+        }
+    }
+}
@@ -0,0 +1,25 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#ifndef KTX2_WRITER_H
+#define KTX2_WRITER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bc_encoder.h"
+
+namespace vulkr {
+    namespace Ktx2Writer {
+        /**
+         * Writes a KTX2 file with a single 2D image and its block compressed levels, level 0 being the largest.
+         * The levels are stored smallest first so a streaming reader finds the low mips at the front of the file.
+         */
+        void write(const std::string &path, BcEncoder::Format format, bool srgb, uint32_t width, uint32_t height,
+                   const std::vector<std::vector<uint8_t>> &levels);
+    }
+}
+
+#endif //KTX2_WRITER_H
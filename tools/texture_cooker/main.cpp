@@ -0,0 +1,169 @@
+//
+// Created by CorruptionHades on 19/10/2026.
+//
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../../src/mesh/gltf_tiny/stb_image.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bc_encoder.h"
+#include "ktx2_writer.h"
+#include "../../src/utils/parallel_for.h"
+
+/*
+ * Cooks images into KTX2 files with their full mip chain block compressed, ready for the renderer to upload as
+ * they are. A cooked file next to its source image (albedo.png -> albedo.ktx2) is picked up by TextureManager
+ * instead of the image.
+ *
+ *   texture_cooker [--format bc1|bc3|bc5|bc7] [--linear] [--output <file.ktx2>] <image>...
+ *
+ * bc7 is the default, bc1 is half the size but drops alpha, bc5 keeps red and green only for normal maps.
+ * Textures are treated as sRGB color unless --linear is given, bc5 is always linear.
+ */
+
+namespace {
+    struct Options {
+        vulkr::BcEncoder::Format format{vulkr::BcEncoder::Format::BC7};
+        bool srgb{true};
+        std::string output;
+        std::vector<std::string> inputs;
+    };
+
+    Options parseOptions(int argc, char **argv) {
+        Options options;
+        for (int i = 1; i < argc; i++) {
+            const std::string argument = argv[i];
+            if (argument == "--format" && i + 1 < argc) {
+                const std::string format = argv[++i];
+                if (format == "bc1") options.format = vulkr::BcEncoder::Format::BC1;
+                else if (format == "bc3") options.format = vulkr::BcEncoder::Format::BC3;
+                else if (format == "bc5") options.format = vulkr::BcEncoder::Format::BC5;
+                else if (format == "bc7") options.format = vulkr::BcEncoder::Format::BC7;
+                else throw std::runtime_error("unknown format: " + format);
+            } else if (argument == "--linear") {
+                options.srgb = false;
+            } else if (argument == "--output" && i + 1 < argc) {
+                options.output = argv[++i];
+            } else if (argument.starts_with("--")) {
+                throw std::runtime_error("unknown option: " + argument);
+            } else {
+                options.inputs.push_back(argument);
+            }
+        }
+
+        if (options.inputs.empty()) {
+            throw std::runtime_error(
+                "usage: texture_cooker [--format bc1|bc3|bc5|bc7] [--linear] [--output <file.ktx2>] <image>...");
+        }
+        if (!options.output.empty() && options.inputs.size() > 1) {
+            throw std::runtime_error("--output needs a single input image");
+        }
+        if (options.format == vulkr::BcEncoder::Format::BC5) {
+            options.srgb = false;
+        }
+        return options;
+    }
+
+    float srgbToLinear(float value) {
+        return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+    }
+
+    float linearToSrgb(float value) {
+        return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    }
+
+    /**
+     * Halves an RGBA8 level with a box filter, averaging color in linear space for sRGB textures. Odd edges
+     * fold their last texel into the one before.
+     */
+    std::vector<uint8_t> downsample(const std::vector<uint8_t> &texels, uint32_t width, uint32_t height, bool srgb) {
+        static const std::array<float, 256> toLinear = [] {
+            std::array<float, 256> table{};
+            for (int i = 0; i < 256; i++) table[i] = srgbToLinear(static_cast<float>(i) / 255.0f);
+            return table;
+        }();
+
+        const uint32_t nextWidth = std::max(width / 2, 1u);
+        const uint32_t nextHeight = std::max(height / 2, 1u);
+        std::vector<uint8_t> next(static_cast<size_t>(nextWidth) * nextHeight * 4);
+
+        vulkr::parallelFor(nextHeight, [&](size_t y) {
+            const uint32_t y0 = std::min(static_cast<uint32_t>(y) * 2, height - 1);
+            const uint32_t y1 = std::min(y0 + 1, height - 1);
+            for (uint32_t x = 0; x < nextWidth; x++) {
+                const uint32_t x0 = std::min(x * 2, width - 1);
+                const uint32_t x1 = std::min(x0 + 1, width - 1);
+                const std::array<size_t, 4> sources = {
+                    (static_cast<size_t>(y0) * width + x0) * 4, (static_cast<size_t>(y0) * width + x1) * 4,
+                    (static_cast<size_t>(y1) * width + x0) * 4, (static_cast<size_t>(y1) * width + x1) * 4
+                };
+
+                for (int c = 0; c < 4; c++) {
+                    float sum = 0.0f;
+                    for (size_t source: sources) {
+                        sum += srgb && c < 3 ? toLinear[texels[source + c]] : texels[source + c] / 255.0f;
+                    }
+                    float value = sum / 4.0f;
+                    if (srgb && c < 3) value = linearToSrgb(value);
+                    next[(y * nextWidth + x) * 4 + c] = static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+                }
+            }
+        });
+        return next;
+    }
+
+    void cook(const std::string &input, const std::string &output, const Options &options) {
+        int width, height, channels;
+        stbi_uc *texels = stbi_load(input.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+        if (texels == nullptr) {
+            throw std::runtime_error("failed to load image " + input + ": " + stbi_failure_reason());
+        }
+        std::vector<uint8_t> level(texels, texels + static_cast<size_t>(width) * height * 4);
+        stbi_image_free(texels);
+
+        // every level down to 1x1, each encoded on all cores
+        std::vector<std::vector<uint8_t>> encoded;
+        auto levelWidth = static_cast<uint32_t>(width);
+        auto levelHeight = static_cast<uint32_t>(height);
+        while (true) {
+            encoded.push_back(vulkr::BcEncoder::encodeImage(options.format, level.data(), levelWidth, levelHeight));
+            if (levelWidth == 1 && levelHeight == 1) break;
+
+            level = downsample(level, levelWidth, levelHeight, options.srgb);
+            levelWidth = std::max(levelWidth / 2, 1u);
+            levelHeight = std::max(levelHeight / 2, 1u);
+        }
+
+        vulkr::Ktx2Writer::write(output, options.format, options.srgb, static_cast<uint32_t>(width),
+                                 static_cast<uint32_t>(height), encoded);
+        std::cout << input << " -> " << output << " (" << width << "x" << height << ", " << encoded.size()
+                << " levels)" << std::endl;
+    }
+}
+
+int main(int argc, char **argv) {
+    try {
+        const Options options = parseOptions(argc, argv);
+        for (const std::string &input: options.inputs) {
+            const std::string output = options.output.empty()
+                                           ? std::filesystem::path(input).replace_extension(".ktx2").string()
+                                           : options.output;
+            cook(input, output, options);
+        }
+    }
+    catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}